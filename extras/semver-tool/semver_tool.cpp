@@ -0,0 +1,593 @@
+// semver-tool: sort, deduplicate, filter and validate version lists using
+// SemVer 2.0.0 precedence (the library's operator<), one version per line.
+//
+// Input files are mmap'd and processed in blocks of whole lines, each block
+// split across worker threads. Commands that only need a running result
+// (filter, validate, max, uniq, histogram) stream; sort keeps one entry per
+// distinct line text, so memory follows the number of distinct versions.
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SemVerChecker.h"
+
+namespace {
+
+const size_t BLOCK_SIZE = 64u << 20;
+const size_t READ_SIZE = 16u << 20;
+
+const char* const ERROR_NAMES[] = {
+    "ok", "empty", "too long", "missing part", "empty identifier",
+    "leading zero", "invalid character", "overflow"
+};
+
+enum Command { SORT, UNIQ, MAX, FILTER, VALIDATE, HISTOGRAM };
+
+struct Options {
+    Command command;
+    unsigned threads;
+    bool reverse;
+    bool counts;
+    bool includePrerelease;
+    bool stats;
+    SemVer requirement;
+    std::vector<const char*> files;
+};
+
+struct Stats {
+    uint64_t bytes;
+    uint64_t lines;
+    uint64_t invalid;
+};
+
+// --- Output ---
+
+class Output {
+public:
+    Output() { _buffer.reserve(1 << 20); }
+    ~Output() { flush(); }
+
+    void write(const char* p, size_t n) {
+        _buffer.append(p, n);
+        if (_buffer.size() >= (1u << 20)) flush();
+    }
+    void write(const std::string& s) { write(s.data(), s.size()); }
+    void line(const char* p, size_t n) {
+        write(p, n);
+        write("\n", 1);
+    }
+    void flush() {
+        if (!_buffer.empty()) fwrite(_buffer.data(), 1, _buffer.size(), stdout);
+        _buffer.clear();
+    }
+
+private:
+    std::string _buffer;
+};
+
+// --- Input: blocks of whole lines from an mmap'd file or stdin ---
+
+class Input {
+public:
+    // keep: stdin blocks stay valid after next() (needed when entries point into them)
+    explicit Input(bool keep) : _keep(keep), _fd(-1), _map(NULL), _size(0), _pos(0), _eof(false) {}
+
+    ~Input() {
+        if (_map) munmap(_map, _size);
+        if (_fd > 0) close(_fd);
+    }
+
+    bool open(const char* path) {
+        if (strcmp(path, "-") == 0) {
+            _fd = 0;
+            return true;
+        }
+        _fd = ::open(path, O_RDONLY);
+        if (_fd < 0) return false;
+        struct stat st;
+        if (fstat(_fd, &st) != 0) return false;
+        _size = (size_t)st.st_size;
+        if (_size == 0) return true;
+        _map = (char*)mmap(NULL, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (_map == MAP_FAILED) {
+            _map = NULL;
+            return false;
+        }
+        madvise(_map, _size, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    bool next(const char*& begin, const char*& end) {
+        return _fd == 0 ? nextStdin(begin, end) : nextMapped(begin, end);
+    }
+
+private:
+    bool _keep;
+    int _fd;
+    char* _map;
+    size_t _size;
+    size_t _pos;
+    bool _eof;
+    std::string _carry;
+    std::deque<std::string> _blocks;
+
+    bool nextMapped(const char*& begin, const char*& end) {
+        if (_pos >= _size) return false;
+        size_t stop = std::min(_size, _pos + BLOCK_SIZE);
+        if (stop < _size) {
+            const char* nl = (const char*)memchr(_map + stop, '\n', _size - stop);
+            stop = nl ? (size_t)(nl - _map) + 1 : _size;
+        }
+        begin = _map + _pos;
+        end = _map + stop;
+        _pos = stop;
+        return true;
+    }
+
+    bool nextStdin(const char*& begin, const char*& end) {
+        if (_eof && _carry.empty()) return false;
+        if (!_keep) _blocks.clear();
+        _blocks.push_back(std::string());
+        std::string& block = _blocks.back();
+        block.swap(_carry);
+
+        while (!_eof) {
+            size_t used = block.size();
+            block.resize(used + READ_SIZE);
+            size_t n = fread(&block[used], 1, READ_SIZE, stdin);
+            block.resize(used + n);
+            if (n == 0) _eof = true;
+            // Cut after the last newline; the partial line moves to the next block
+            size_t nl = block.find_last_of('\n');
+            if (nl != std::string::npos && block.size() >= READ_SIZE) {
+                _carry.assign(block, nl + 1, std::string::npos);
+                block.resize(nl + 1);
+                break;
+            }
+        }
+        if (block.empty()) return false;
+        begin = block.data();
+        end = begin + block.size();
+        return true;
+    }
+};
+
+// --- Parallel helpers ---
+
+template <typename Work>
+void parallelFor(unsigned threads, Work work) {
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) workers.push_back(std::thread(work, t));
+    work(0u);
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+}
+
+// Split [begin, end) into 'parts' ranges that start at line boundaries
+std::vector<const char*> splitLines(const char* begin, const char* end, unsigned parts) {
+    std::vector<const char*> cuts(1, begin);
+    size_t step = (size_t)(end - begin) / parts;
+    for (unsigned i = 1; i < parts; i++) {
+        const char* p = std::max(cuts.back(), begin + step * i);
+        const char* nl = p < end ? (const char*)memchr(p, '\n', (size_t)(end - p)) : NULL;
+        cuts.push_back(nl ? nl + 1 : end);
+    }
+    cuts.push_back(end);
+    return cuts;
+}
+
+// Calls f(line, length) for each line; strips '\r' and skips empty lines
+template <typename F>
+void forEachLine(const char* p, const char* end, F f) {
+    while (p < end) {
+        const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+        const char* stop = nl ? nl : end;
+        size_t len = (size_t)(stop - p);
+        if (len && p[len - 1] == '\r') len--;
+        if (len) f(p, len);
+        p = stop + 1;
+    }
+}
+
+bool parseLine(const char* p, size_t len, SemVer& out) {
+    if (len > SemVer::MAX_VERSION_LEN || memchr(p, '\0', len)) return false;
+    char text[SemVer::MAX_VERSION_LEN + 1];
+    memcpy(text, p, len);
+    text[len] = '\0';
+    out = SemVer(text);
+    return out.isValid();
+}
+
+bool wanted(const SemVer& v, const Options& opt) {
+    if (opt.requirement.isValid()) return v.satisfies(opt.requirement, opt.includePrerelease);
+    return opt.includePrerelease || opt.command != MAX || v.getPrerelease()[0] == '\0';
+}
+
+// --- Distinct lines (sort, uniq, histogram) ---
+
+struct Distinct {
+    SemVer version;
+    const char* text;
+    uint32_t len;
+    uint64_t count;
+    uint64_t first;   // Input position of the first occurrence
+};
+
+class DistinctTable {
+public:
+    DistinctTable() : _mask(1023), _slots(1024, 0) {}
+
+    void add(const char* text, uint32_t len, uint64_t pos, const SemVer* parsed, uint64_t count = 1) {
+        uint64_t h = hash(text, len);
+        size_t i = (size_t)h & _mask;
+        while (_slots[i]) {
+            Distinct& d = _entries[_slots[i] - 1];
+            if (d.len == len && memcmp(d.text, text, len) == 0) {
+                d.count += count;
+                d.first = std::min(d.first, pos);
+                return;
+            }
+            i = (i + 1) & _mask;
+        }
+        Distinct d;
+        if (parsed) d.version = *parsed;
+        else parseLine(text, len, d.version);
+        d.text = text;
+        d.len = len;
+        d.count = count;
+        d.first = pos;
+        _entries.push_back(d);
+        _slots[i] = (uint32_t)_entries.size();
+        if (_entries.size() * 2 > _slots.size()) grow();
+    }
+
+    void merge(const DistinctTable& other) {
+        for (size_t i = 0; i < other._entries.size(); i++) {
+            const Distinct& d = other._entries[i];
+            add(d.text, d.len, d.first, &d.version, d.count);
+        }
+    }
+
+    std::vector<Distinct>& entries() { return _entries; }
+
+private:
+    size_t _mask;
+    std::vector<uint32_t> _slots;
+    std::vector<Distinct> _entries;
+
+    static uint64_t hash(const char* p, size_t n) {
+        uint64_t h = 14695981039346656037ull;
+        for (size_t i = 0; i < n; i++) {
+            h ^= (uint8_t)p[i];
+            h *= 1099511628211ull;
+        }
+        return h ^ (h >> 29);
+    }
+
+    void grow() {
+        _slots.assign(_slots.size() * 2, 0);
+        _mask = _slots.size() - 1;
+        for (size_t e = 0; e < _entries.size(); e++) {
+            size_t i = (size_t)hash(_entries[e].text, _entries[e].len) & _mask;
+            while (_slots[i]) i = (i + 1) & _mask;
+            _slots[i] = (uint32_t)(e + 1);
+        }
+    }
+};
+
+// --- Commands ---
+
+void collectDistinct(Input& in, uint64_t base, const Options& opt, DistinctTable& table, Stats& stats) {
+    const char* begin;
+    const char* end;
+    while (in.next(begin, end)) {
+        std::vector<const char*> cuts = splitLines(begin, end, opt.threads);
+        std::vector<DistinctTable> local(opt.threads);
+        std::vector<Stats> counts(opt.threads, Stats());
+        parallelFor(opt.threads, [&](unsigned t) {
+            forEachLine(cuts[t], cuts[t + 1], [&](const char* p, size_t len) {
+                counts[t].lines++;
+                SemVer v;
+                if (!parseLine(p, len, v)) {
+                    counts[t].invalid++;
+                    return;
+                }
+                local[t].add(p, (uint32_t)len, base + (uint64_t)(p - begin), &v);
+            });
+        });
+        for (unsigned t = 0; t < opt.threads; t++) {
+            table.merge(local[t]);
+            stats.lines += counts[t].lines;
+            stats.invalid += counts[t].invalid;
+        }
+        stats.bytes += (uint64_t)(end - begin);
+        base += (uint64_t)(end - begin);
+    }
+}
+
+void runDistinct(const Options& opt, std::deque<Input>& inputs, Output& out, Stats& stats) {
+    DistinctTable table;
+    uint64_t base = 0;
+    for (size_t f = 0; f < inputs.size(); f++) {
+        collectDistinct(inputs[f], base, opt, table, stats);
+        base = stats.bytes;
+    }
+
+    std::vector<Distinct>& all = table.entries();
+    std::sort(all.begin(), all.end(), [&opt](const Distinct& a, const Distinct& b) {
+        if (a.version < b.version) return !opt.reverse;
+        if (b.version < a.version) return opt.reverse;
+        return a.first < b.first;
+    });
+
+    for (size_t i = 0; i < all.size(); ) {
+        size_t j = i + 1;
+        uint64_t group = all[i].count;
+        while (j < all.size() && all[j].version == all[i].version) group += all[j++].count;
+
+        if (opt.command == SORT) {
+            for (size_t k = i; k < j; k++) {
+                for (uint64_t n = 0; n < all[k].count; n++) out.line(all[k].text, all[k].len);
+            }
+        } else if (opt.command == UNIQ) {
+            if (opt.counts) {
+                char prefix[32];
+                int n = snprintf(prefix, sizeof(prefix), "%7llu ", (unsigned long long)group);
+                out.write(prefix, (size_t)n);
+            }
+            out.line(all[i].text, all[i].len);
+        } else {
+            char text[SemVer::MAX_VERSION_LEN + 1];
+            all[i].version.toString(text, sizeof(text));
+            char* plus = strchr(text, '+');
+            if (plus) *plus = '\0';
+            uint64_t valid = stats.lines - stats.invalid;
+            char row[SemVer::MAX_VERSION_LEN + 64];
+            int n = snprintf(row, sizeof(row), "%llu\t%.2f%%\t%s\n", (unsigned long long)group,
+                             valid ? 100.0 * (double)group / (double)valid : 0.0, text);
+            out.write(row, (size_t)n);
+        }
+        i = j;
+    }
+}
+
+int runMax(const Options& opt, std::deque<Input>& inputs, Output& out, Stats& stats) {
+    SemVer best;
+    std::string bestText;
+    for (size_t f = 0; f < inputs.size(); f++) {
+        const char* begin;
+        const char* end;
+        while (inputs[f].next(begin, end)) {
+            std::vector<const char*> cuts = splitLines(begin, end, opt.threads);
+            std::vector<SemVer> localBest(opt.threads);
+            std::vector<const char*> localText(opt.threads, (const char*)NULL);
+            std::vector<size_t> localLen(opt.threads, 0);
+            std::vector<Stats> counts(opt.threads, Stats());
+            parallelFor(opt.threads, [&](unsigned t) {
+                forEachLine(cuts[t], cuts[t + 1], [&](const char* p, size_t len) {
+                    counts[t].lines++;
+                    SemVer v;
+                    if (!parseLine(p, len, v)) {
+                        counts[t].invalid++;
+                        return;
+                    }
+                    if (!wanted(v, opt)) return;
+                    if (!localBest[t].isValid() || localBest[t] < v) {
+                        localBest[t] = v;
+                        localText[t] = p;
+                        localLen[t] = len;
+                    }
+                });
+            });
+            // Earlier chunks win ties, like a sequential scan
+            for (unsigned t = 0; t < opt.threads; t++) {
+                stats.lines += counts[t].lines;
+                stats.invalid += counts[t].invalid;
+                if (localBest[t].isValid() && (!best.isValid() || best < localBest[t])) {
+                    best = localBest[t];
+                    bestText.assign(localText[t], localLen[t]);
+                }
+            }
+            stats.bytes += (uint64_t)(end - begin);
+        }
+    }
+    if (!best.isValid()) return 1;
+    out.line(bestText.data(), bestText.size());
+    return 0;
+}
+
+int runStreaming(const Options& opt, std::deque<Input>& inputs, Output& out, Stats& stats) {
+    uint64_t lineBase = 0;
+    for (size_t f = 0; f < inputs.size(); f++) {
+        const char* begin;
+        const char* end;
+        while (inputs[f].next(begin, end)) {
+            std::vector<const char*> cuts = splitLines(begin, end, opt.threads);
+            std::vector<std::string> results(opt.threads);
+            std::vector<Stats> counts(opt.threads, Stats());
+            std::vector<uint64_t> lineCounts(opt.threads, 0); // Lines including empty ones, for numbering
+            // validate: messages carry the line number within the chunk, fixed up below
+            std::vector<std::vector<std::pair<uint64_t, std::string> > > errors(opt.threads);
+
+            parallelFor(opt.threads, [&](unsigned t) {
+                uint64_t lineNo = 0;
+                const char* p = cuts[t];
+                const char* stop = cuts[t + 1];
+                while (p < stop) {
+                    const char* nl = (const char*)memchr(p, '\n', (size_t)(stop - p));
+                    const char* lineEnd = nl ? nl : stop;
+                    size_t len = (size_t)(lineEnd - p);
+                    if (len && p[len - 1] == '\r') len--;
+                    lineNo++;
+                    if (len) {
+                        counts[t].lines++;
+                        if (opt.command == VALIDATE) {
+                            SemVer::ParseResult r = SemVer::validate(p, len);
+                            if (!r.ok()) {
+                                counts[t].invalid++;
+                                char msg[96];
+                                snprintf(msg, sizeof(msg), ": %s at offset %u\n", ERROR_NAMES[r.error], (unsigned)r.offset);
+                                errors[t].push_back(std::make_pair(lineNo, std::string(msg)));
+                            }
+                        } else {
+                            SemVer v;
+                            if (!parseLine(p, len, v)) counts[t].invalid++;
+                            else if (wanted(v, opt)) {
+                                results[t].append(p, len);
+                                results[t] += '\n';
+                            }
+                        }
+                    }
+                    p = lineEnd + 1;
+                }
+                lineCounts[t] = lineNo;
+            });
+
+            for (unsigned t = 0; t < opt.threads; t++) {
+                stats.lines += counts[t].lines;
+                stats.invalid += counts[t].invalid;
+                if (opt.command == VALIDATE) {
+                    for (size_t i = 0; i < errors[t].size(); i++) {
+                        // The file name goes out as is: paths have no length limit
+                        char number[32];
+                        int n = snprintf(number, sizeof(number), ":%llu", (unsigned long long)(lineBase + errors[t][i].first));
+                        out.write(opt.files[f], strlen(opt.files[f]));
+                        out.write(number, n < 0 ? 0 : std::min((size_t)n, sizeof(number) - 1));
+                        out.write(errors[t][i].second);
+                    }
+                } else {
+                    out.write(results[t]);
+                }
+                lineBase += lineCounts[t];
+            }
+            stats.bytes += (uint64_t)(end - begin);
+        }
+        lineBase = 0;
+    }
+    return opt.command == VALIDATE && stats.invalid ? 1 : 0;
+}
+
+void usage() {
+    fprintf(stderr,
+        "usage: semver-tool [options] <command> [file...]\n"
+        "\n"
+        "Reads one version per line from the files (or stdin, or '-').\n"
+        "Ordering is SemVer 2.0.0 precedence; invalid lines are skipped.\n"
+        "\n"
+        "commands:\n"
+        "  sort                  sort lines by precedence\n"
+        "  uniq [-c]             sorted distinct versions (build metadata ignored)\n"
+        "  max                   highest version (stable only unless --include-prerelease)\n"
+        "  filter --satisfies V  lines satisfying caret requirement V, in input order\n"
+        "  validate              report invalid lines; exit status 1 if any\n"
+        "  histogram             count and share per version\n"
+        "\n"
+        "options:\n"
+        "  -j N                  worker threads (default: all cores)\n"
+        "  -r                    reverse order (sort, uniq, histogram)\n"
+        "  -c                    prefix counts (uniq)\n"
+        "  --satisfies V         only versions satisfying ^V (filter, max)\n"
+        "  --include-prerelease  let pre-releases satisfy or be the maximum\n"
+        "  --stats               print throughput to stderr\n");
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    opt.reverse = opt.counts = opt.includePrerelease = opt.stats = false;
+    bool haveCommand = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (strcmp(a, "-j") == 0 && i + 1 < argc) {
+            int n = atoi(argv[++i]);
+            if (n < 1) return false;
+            opt.threads = (unsigned)n;
+        } else if (strcmp(a, "-r") == 0) {
+            opt.reverse = true;
+        } else if (strcmp(a, "-c") == 0) {
+            opt.counts = true;
+        } else if (strcmp(a, "--satisfies") == 0 && i + 1 < argc) {
+            opt.requirement = SemVer(argv[++i]);
+            if (!opt.requirement.isValid()) {
+                fprintf(stderr, "semver-tool: invalid requirement '%s'\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(a, "--include-prerelease") == 0) {
+            opt.includePrerelease = true;
+        } else if (strcmp(a, "--stats") == 0) {
+            opt.stats = true;
+        } else if (!haveCommand) {
+            static const char* const names[] = { "sort", "uniq", "max", "filter", "validate", "histogram" };
+            bool found = false;
+            for (int c = 0; c < 6; c++) {
+                if (strcmp(a, names[c]) == 0) {
+                    opt.command = (Command)c;
+                    found = true;
+                }
+            }
+            if (!found) return false;
+            haveCommand = true;
+        } else if (a[0] == '-' && a[1] != '\0') {
+            return false;
+        } else {
+            opt.files.push_back(a);
+        }
+    }
+    if (!haveCommand) return false;
+    if (opt.command == FILTER && !opt.requirement.isValid()) return false;
+    if (opt.files.empty()) opt.files.push_back("-");
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+
+    // Sort, uniq and histogram keep pointers into the input until the end
+    bool keep = opt.command == SORT || opt.command == UNIQ || opt.command == HISTOGRAM;
+    std::deque<Input> inputs;
+    for (size_t i = 0; i < opt.files.size(); i++) {
+        inputs.emplace_back(keep);
+        if (!inputs.back().open(opt.files[i])) {
+            fprintf(stderr, "semver-tool: %s: %s\n", opt.files[i], strerror(errno));
+            return 2;
+        }
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Stats stats = { 0, 0, 0 };
+    int status = 0;
+    {
+        Output out;
+        if (keep) runDistinct(opt, inputs, out, stats);
+        else if (opt.command == MAX) status = runMax(opt, inputs, out, stats);
+        else status = runStreaming(opt, inputs, out, stats);
+    }
+    fflush(stdout);
+
+    if (opt.stats) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        fprintf(stderr, "%llu bytes, %llu lines (%llu invalid) in %.3f s: %.1f MB/s, %.2f M lines/s, %u threads\n",
+                (unsigned long long)stats.bytes, (unsigned long long)stats.lines, (unsigned long long)stats.invalid,
+                seconds, seconds > 0 ? (double)stats.bytes / 1e6 / seconds : 0.0,
+                seconds > 0 ? (double)stats.lines / 1e6 / seconds : 0.0, opt.threads);
+    }
+    return status;
+}
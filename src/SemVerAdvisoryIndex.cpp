@@ -0,0 +1,162 @@
+#include "SemVerAdvisoryIndex.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+
+namespace {
+
+// Points are a version plus -1/0/+1 epsilon, so exclusive bounds become points too:
+// ">1.0.0" starts at 1.0.0+e and "<2.0.0" ends at 2.0.0-e
+int comparePoint(const SemVer& a, int offA, const SemVer& b, int offB) {
+    if (a < b) return -1;
+    if (b < a) return 1;
+    return offA < offB ? -1 : (offA > offB ? 1 : 0);
+}
+
+int lowVsPoint(const VersionRange& r, const SemVer& v, int off) {
+    if (!r.low.isValid()) return -1;
+    return comparePoint(r.low, r.lowInclusive ? 0 : 1, v, off);
+}
+
+int highVsPoint(const VersionRange& r, const SemVer& v, int off) {
+    if (!r.high.isValid()) return 1;
+    return comparePoint(r.high, r.highInclusive ? 0 : -1, v, off);
+}
+
+} // namespace
+
+AdvisoryIndex::AdvisoryIndex() : _root(-1) {}
+
+bool AdvisoryIndex::add(uint32_t advisory, const char* ranges) {
+    std::vector<VersionRange> parsed;
+    if (!VersionRange::parse(ranges, parsed)) return false;
+    for (size_t i = 0; i < parsed.size(); i++) add(advisory, parsed[i]);
+    return true;
+}
+
+void AdvisoryIndex::add(uint32_t advisory, const VersionRange& range) {
+    if (range.empty()) return;
+    Interval iv = { range, advisory };
+    _pending.push_back(iv);
+}
+
+void AdvisoryIndex::build() {
+    // Merge overlapping ranges of the same advisory so a query reports it once
+    std::vector<Interval> all(_intervals);
+    all.insert(all.end(), _pending.begin(), _pending.end());
+    _pending.clear();
+    std::sort(all.begin(), all.end(), [](const Interval& a, const Interval& b) {
+        if (a.advisory != b.advisory) return a.advisory < b.advisory;
+        return VersionRange::compareLow(a.range, b.range) < 0;
+    });
+
+    _intervals.clear();
+    for (size_t i = 0; i < all.size(); i++) {
+        if (!_intervals.empty()) {
+            Interval& last = _intervals.back();
+            if (last.advisory == all[i].advisory && !VersionRange::before(last.range, all[i].range)) {
+                if (VersionRange::compareHigh(all[i].range, last.range) > 0) {
+                    last.range.high = all[i].range.high;
+                    last.range.highInclusive = all[i].range.highInclusive;
+                }
+                continue;
+            }
+        }
+        _intervals.push_back(all[i]);
+    }
+
+    _nodes.clear();
+    _byLow.clear();
+    _byHigh.clear();
+    std::vector<uint32_t> items(_intervals.size());
+    for (uint32_t i = 0; i < items.size(); i++) items[i] = i;
+    _root = buildNode(items);
+}
+
+int32_t AdvisoryIndex::buildNode(std::vector<uint32_t>& items) {
+    if (items.empty()) return -1;
+
+    // The median range by lower bound picks the center, so it always contains it
+    std::sort(items.begin(), items.end(), [this](uint32_t a, uint32_t b) {
+        return VersionRange::compareLow(_intervals[a].range, _intervals[b].range) < 0;
+    });
+    const VersionRange& median = _intervals[items[items.size() / 2]].range;
+
+    Node node;
+    if (median.low.isValid()) {
+        node.center = median.low;
+        node.offset = median.lowInclusive ? 0 : 1;
+    } else if (median.high.isValid()) {
+        node.center = median.high;
+        node.offset = median.highInclusive ? 0 : -1;
+    } else {
+        node.center = SemVer("0.0.0");
+        node.offset = 0;
+    }
+
+    std::vector<uint32_t> left, right, here;
+    for (size_t i = 0; i < items.size(); i++) {
+        const VersionRange& r = _intervals[items[i]].range;
+        if (highVsPoint(r, node.center, node.offset) < 0) left.push_back(items[i]);
+        else if (lowVsPoint(r, node.center, node.offset) > 0) right.push_back(items[i]);
+        else here.push_back(items[i]);
+    }
+
+    // 'here' is still in ascending lower-bound order
+    node.begin = (uint32_t)_byLow.size();
+    node.end = node.begin + (uint32_t)here.size();
+    _byLow.insert(_byLow.end(), here.begin(), here.end());
+    std::sort(here.begin(), here.end(), [this](uint32_t a, uint32_t b) {
+        return VersionRange::compareHigh(_intervals[a].range, _intervals[b].range) > 0;
+    });
+    _byHigh.insert(_byHigh.end(), here.begin(), here.end());
+
+    // Children are linked once built; the node is pushed first to keep its index
+    node.left = -1;
+    node.right = -1;
+    int32_t idx = (int32_t)_nodes.size();
+    _nodes.push_back(node);
+    int32_t l = buildNode(left);
+    int32_t r = buildNode(right);
+    _nodes[idx].left = l;
+    _nodes[idx].right = r;
+    return idx;
+}
+
+size_t AdvisoryIndex::query(const SemVer& version, std::vector<uint32_t>& out) const {
+    if (!version.isValid()) return 0;
+
+    size_t before = out.size();
+    int32_t idx = _root;
+    while (idx >= 0) {
+        const Node& node = _nodes[idx];
+        int c = comparePoint(version, 0, node.center, node.offset);
+        if (c < 0) {
+            // Every range here ends at or after the center, so only the lower bound matters
+            for (uint32_t i = node.begin; i < node.end; i++) {
+                const Interval& iv = _intervals[_byLow[i]];
+                if (lowVsPoint(iv.range, version, 0) > 0) break;
+                out.push_back(iv.advisory);
+            }
+            idx = node.left;
+        } else if (c > 0) {
+            for (uint32_t i = node.begin; i < node.end; i++) {
+                const Interval& iv = _intervals[_byHigh[i]];
+                if (highVsPoint(iv.range, version, 0) < 0) break;
+                out.push_back(iv.advisory);
+            }
+            idx = node.right;
+        } else {
+            for (uint32_t i = node.begin; i < node.end; i++) out.push_back(_intervals[_byLow[i]].advisory);
+            break;
+        }
+    }
+    return out.size() - before;
+}
+
+size_t AdvisoryIndex::size() const {
+    return _intervals.size();
+}
+
+#endif // SEMVER_HOST
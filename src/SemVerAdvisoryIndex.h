@@ -0,0 +1,74 @@
+#ifndef SEMVER_ADVISORY_INDEX_H
+#define SEMVER_ADVISORY_INDEX_H
+
+#include "SemVerRange.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <vector>
+
+/**
+ * @brief Finds every advisory whose ranges contain a version
+ *
+ * Ranges are added per advisory, then build() merges overlapping ranges of the
+ * same advisory and arranges all of them in a centered interval tree. Each node
+ * holds the ranges containing its center point, sorted by lower and by upper
+ * bound, so a query walks one root-to-leaf path and stops scanning a node at
+ * the first range that misses: O(log n + k) for k matching advisories.
+ */
+class AdvisoryIndex {
+public:
+    AdvisoryIndex();
+
+    /**
+     * @brief Add the ranges of an advisory (see VersionRange::parse)
+     * @return false if the expression does not parse (nothing is added)
+     */
+    bool add(uint32_t advisory, const char* ranges);
+    void add(uint32_t advisory, const VersionRange& range);
+
+    /**
+     * @brief Build the tree from everything added so far; required before query()
+     */
+    void build();
+
+    /**
+     * @brief Append the advisories containing a version, each at most once
+     * @return Number of advisories appended
+     */
+    size_t query(const SemVer& version, std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief Number of indexed ranges after merging
+     */
+    size_t size() const;
+
+private:
+    struct Interval {
+        VersionRange range;
+        uint32_t advisory;
+    };
+
+    struct Node {
+        SemVer center;     // Center point is center + offset * epsilon
+        int8_t offset;
+        uint32_t begin;    // Ranges containing the center in _byLow/_byHigh
+        uint32_t end;
+        int32_t left;      // Child indices, -1 if none
+        int32_t right;
+    };
+
+    std::vector<Interval> _pending;
+    std::vector<Interval> _intervals;
+    std::vector<uint32_t> _byLow;   // Ascending lower bound within each node
+    std::vector<uint32_t> _byHigh;  // Descending upper bound within each node
+    std::vector<Node> _nodes;
+    int32_t _root;
+
+    int32_t buildNode(std::vector<uint32_t>& items);
+};
+
+#endif // SEMVER_HOST
+
+#endif
@@ -0,0 +1,154 @@
+#include "SemVerBuildMetadata.h"
+
+#ifdef SEMVER_HOST
+
+#include <string.h>
+
+const size_t BuildMetadata::MAX_IDENTIFIERS;
+const uint32_t BuildIndex::NO_POSITION;
+
+BuildMetadata::BuildMetadata(const SemVer& version) : _text(version.getBuild()), _count(-1) {}
+
+BuildMetadata::BuildMetadata(const char* build) : _text(build ? build : ""), _count(-1) {}
+
+size_t BuildMetadata::count() const {
+    split();
+    return (size_t)_count;
+}
+
+const char* BuildMetadata::identifier(size_t i, size_t& len) const {
+    split();
+    if (i >= (size_t)_count) {
+        len = 0;
+        return NULL;
+    }
+    len = _len[i];
+    return _text + _start[i];
+}
+
+int BuildMetadata::find(const char* text) const {
+    if (!text) return -1;
+    split();
+    size_t n = strlen(text);
+    for (int i = 0; i < _count; i++) {
+        if (_len[i] == n && memcmp(_text + _start[i], text, n) == 0) return i;
+    }
+    return -1;
+}
+
+bool BuildMetadata::number(size_t i, uint64_t& value) const {
+    size_t len;
+    const char* s = identifier(i, len);
+    return s && parseNumber(s, len, value);
+}
+
+bool BuildMetadata::hex(size_t i, uint64_t& value, const char* prefix) const {
+    size_t len;
+    const char* s = identifier(i, len);
+    size_t n = prefix ? strlen(prefix) : 0;
+    if (!s || len <= n || (n && memcmp(s, prefix, n) != 0)) return false;
+    return parseHex(s + n, len - n, value);
+}
+
+bool BuildMetadata::numberAfter(const char* prefix, uint64_t& value) const {
+    split();
+    size_t n = prefix ? strlen(prefix) : 0;
+    for (int i = 0; i < _count; i++) {
+        const char* s = _text + _start[i];
+        if (_len[i] > n && (n == 0 || memcmp(s, prefix, n) == 0) && parseNumber(s + n, _len[i] - n, value)) return true;
+    }
+    return false;
+}
+
+bool BuildMetadata::hexAfter(const char* prefix, uint64_t& value) const {
+    split();
+    for (int i = 0; i < _count; i++) {
+        if (hex((size_t)i, value, prefix)) return true;
+    }
+    return false;
+}
+
+// Runs once, on the first call that needs identifier boundaries
+void BuildMetadata::split() const {
+    if (_count >= 0) return;
+    _count = 0;
+    if (!*_text) return;
+    size_t start = 0;
+    for (size_t i = 0;; i++) {
+        if (_text[i] == '.' || _text[i] == '\0') {
+            if ((size_t)_count == MAX_IDENTIFIERS) break;
+            _start[_count] = (uint16_t)start;
+            _len[_count] = (uint16_t)(i - start);
+            _count++;
+            if (_text[i] == '\0') break;
+            start = i + 1;
+        }
+    }
+}
+
+bool BuildMetadata::parseNumber(const char* s, size_t len, uint64_t& value) {
+    if (len == 0) return false;
+    uint64_t v = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] < '0' || s[i] > '9') return false;
+        uint64_t digit = (uint64_t)(s[i] - '0');
+        if (v > (0xFFFFFFFFFFFFFFFFull - digit) / 10) return false;
+        v = v * 10 + digit;
+    }
+    value = v;
+    return true;
+}
+
+bool BuildMetadata::parseHex(const char* s, size_t len, uint64_t& value) {
+    if (len == 0 || len > 16) return false;
+    uint64_t v = 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = s[i];
+        int digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+        v = (v << 4) | (uint64_t)digit;
+    }
+    value = v;
+    return true;
+}
+
+uint32_t BuildIndex::add(const SemVer& version) {
+    if (!version.isValid()) return NO_POSITION;
+    uint32_t position = (uint32_t)_versions.size();
+    _versions.push_back(version);
+
+    BuildMetadata build(_versions.back());
+    for (size_t i = 0; i < build.count(); i++) {
+        size_t len;
+        const char* id = build.identifier(i, len);
+        std::vector<uint32_t>& positions = _byIdentifier[std::string(id, len)];
+        // Repeated identifiers in one version ("+a.a") list it once
+        if (positions.empty() || positions.back() != position) positions.push_back(position);
+    }
+    return position;
+}
+
+size_t BuildIndex::find(const char* identifier, std::vector<uint32_t>& out) const {
+    if (!identifier) return 0;
+    std::unordered_map<std::string, std::vector<uint32_t> >::const_iterator it = _byIdentifier.find(identifier);
+    if (it == _byIdentifier.end()) return 0;
+    out.insert(out.end(), it->second.begin(), it->second.end());
+    return it->second.size();
+}
+
+const SemVer& BuildIndex::at(uint32_t position) const {
+    return _versions[position];
+}
+
+size_t BuildIndex::size() const {
+    return _versions.size();
+}
+
+size_t BuildIndex::keys() const {
+    return _byIdentifier.size();
+}
+
+#endif // SEMVER_HOST
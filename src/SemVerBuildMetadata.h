@@ -0,0 +1,111 @@
+#ifndef SEMVER_BUILD_METADATA_H
+#define SEMVER_BUILD_METADATA_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Structured view of build metadata ("20261014.g1a2b3c4.ci789")
+ *
+ * Parsing a SemVer only records where the build metadata starts. This view
+ * splits it into dot-separated identifiers on the first call that needs them
+ * and decodes numbers on request, so versions whose metadata is never looked
+ * at cost nothing extra.
+ *
+ * The view points into the version's buffer (or the given text), which must
+ * outlive it. With SEMVER_TINY there is no build metadata to decode.
+ */
+class BuildMetadata {
+public:
+    explicit BuildMetadata(const SemVer& version);
+    explicit BuildMetadata(const char* build);
+
+    size_t count() const;
+
+    /**
+     * @return Identifier i (not terminated, see len), or NULL if out of range
+     */
+    const char* identifier(size_t i, size_t& len) const;
+
+    /**
+     * @return Index of the identifier equal to text, or -1
+     */
+    int find(const char* text) const;
+
+    /**
+     * @brief Identifier i as a decimal number (e.g. a build date 20261014)
+     * @return false unless it is all digits and fits in 64 bits
+     */
+    bool number(size_t i, uint64_t& value) const;
+
+    /**
+     * @brief Identifier i as hex digits after a prefix (e.g. "g" for "g1a2b3c4")
+     * @return false unless it is the prefix plus 1 to 16 hex digits
+     */
+    bool hex(size_t i, uint64_t& value, const char* prefix = "") const;
+
+    /**
+     * @brief First identifier that is the prefix plus a decimal number ("ci" for "ci789")
+     * @return false if there is none
+     */
+    bool numberAfter(const char* prefix, uint64_t& value) const;
+
+    /**
+     * @brief First identifier that is the prefix plus hex digits ("g" for "g1a2b3c4")
+     * @return false if there is none
+     */
+    bool hexAfter(const char* prefix, uint64_t& value) const;
+
+private:
+    static const size_t MAX_IDENTIFIERS = SemVer::MAX_VERSION_LEN / 2 + 1;
+
+    const char* _text;
+    mutable int _count;                       // -1 until split
+    mutable uint16_t _start[MAX_IDENTIFIERS];
+    mutable uint16_t _len[MAX_IDENTIFIERS];
+
+    void split() const;
+    static bool parseNumber(const char* s, size_t len, uint64_t& value);
+    static bool parseHex(const char* s, size_t len, uint64_t& value);
+};
+
+/**
+ * @brief Finds versions by a build identifier (commit, build date, CI job)
+ *
+ * Every dot-separated identifier of each added version's build metadata is a
+ * key, so "20261014", "g1a2b3c4" and "ci789" all find 1.4.0+20261014.g1a2b3c4.ci789.
+ */
+class BuildIndex {
+public:
+    static const uint32_t NO_POSITION = 0xFFFFFFFFu;
+
+    /**
+     * @brief Index a version under each of its build identifiers
+     * @return Position for at(), or NO_POSITION if the version is invalid
+     */
+    uint32_t add(const SemVer& version);
+
+    /**
+     * @brief Append the positions of versions with this build identifier, in insertion order
+     * @return Number of positions appended
+     */
+    size_t find(const char* identifier, std::vector<uint32_t>& out) const;
+
+    const SemVer& at(uint32_t position) const;
+    size_t size() const;      // Versions added
+    size_t keys() const;      // Distinct identifiers
+
+private:
+    std::vector<SemVer> _versions;
+    std::unordered_map<std::string, std::vector<uint32_t> > _byIdentifier;
+};
+
+#endif // SEMVER_HOST
+
+#endif
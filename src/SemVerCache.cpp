@@ -0,0 +1,206 @@
+#include "SemVerCache.h"
+
+#ifdef SEMVER_HOST
+
+#include <string.h>
+
+const uint32_t SemVerCache::NIL;
+
+SemVerCache::SemVerCache(size_t capacity)
+    : _bucketMask(0), _used(0), _head(NIL), _tail(NIL) {
+    if (capacity == 0) capacity = 1;
+    _entries.resize(capacity);
+
+    // Keep the load factor at or below 0.5 so chains stay short
+    size_t buckets = 1;
+    while (buckets < capacity * 2) buckets <<= 1;
+    _buckets.assign(buckets, NIL);
+    _bucketMask = (uint32_t)(buckets - 1);
+
+    _stats.hits = 0;
+    _stats.misses = 0;
+    _stats.evictions = 0;
+}
+
+uint32_t SemVerCache::hash(const char* input, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)input[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+SemVer SemVerCache::parse(const char* input) {
+    if (!input) return SemVer();
+    // Anything longer than MAX_VERSION_LEN is rejected by the parser anyway
+    size_t len = 0;
+    while (len <= SemVer::MAX_VERSION_LEN && input[len]) len++;
+    return parse(input, len);
+}
+
+SemVer SemVerCache::parse(const char* input, size_t len) {
+    if (!input || len == 0 || len > SemVer::MAX_VERSION_LEN) return SemVer();
+    return parse(input, len, hash(input, len));
+}
+
+SemVer SemVerCache::parse(const char* input, size_t len, uint32_t h) {
+    if (!input || len == 0 || len > SemVer::MAX_VERSION_LEN) return SemVer();
+
+    uint32_t idx = find(input, len, h);
+    if (idx != NIL) {
+        _stats.hits++;
+        if (idx != _head) {
+            unlink(idx);
+            pushFront(idx);
+        }
+        return _entries[idx].value;
+    }
+
+    _stats.misses++;
+
+    char text[SemVer::MAX_VERSION_LEN + 1];
+    memcpy(text, input, len);
+    text[len] = '\0';
+
+    idx = acquireSlot();
+    Entry& e = _entries[idx];
+    // An embedded NUL would make the parser see a shorter, possibly valid string
+    e.value = memchr(input, '\0', len) ? SemVer() : SemVer(text);
+    e.hash = h;
+    e.len = (uint16_t)len;
+    memcpy(e.key, input, len);
+
+    uint32_t& bucket = _buckets[h & _bucketMask];
+    e.bucketNext = bucket;
+    bucket = idx;
+    pushFront(idx);
+
+    return e.value;
+}
+
+uint32_t SemVerCache::find(const char* input, size_t len, uint32_t h) const {
+    for (uint32_t idx = _buckets[h & _bucketMask]; idx != NIL; idx = _entries[idx].bucketNext) {
+        const Entry& e = _entries[idx];
+        if (e.hash == h && e.len == len && memcmp(e.key, input, len) == 0) return idx;
+    }
+    return NIL;
+}
+
+void SemVerCache::unlink(uint32_t idx) {
+    Entry& e = _entries[idx];
+    if (e.prev != NIL) _entries[e.prev].next = e.next;
+    else _head = e.next;
+    if (e.next != NIL) _entries[e.next].prev = e.prev;
+    else _tail = e.prev;
+}
+
+void SemVerCache::pushFront(uint32_t idx) {
+    Entry& e = _entries[idx];
+    e.prev = NIL;
+    e.next = _head;
+    if (_head != NIL) _entries[_head].prev = idx;
+    _head = idx;
+    if (_tail == NIL) _tail = idx;
+}
+
+void SemVerCache::removeFromBucket(uint32_t idx) {
+    uint32_t* link = &_buckets[_entries[idx].hash & _bucketMask];
+    while (*link != idx) link = &_entries[*link].bucketNext;
+    *link = _entries[idx].bucketNext;
+}
+
+uint32_t SemVerCache::acquireSlot() {
+    if (_used < _entries.size()) return _used++;
+
+    uint32_t victim = _tail;
+    unlink(victim);
+    removeFromBucket(victim);
+    _stats.evictions++;
+    return victim;
+}
+
+void SemVerCache::clear() {
+    _buckets.assign(_buckets.size(), NIL);
+    _used = 0;
+    _head = NIL;
+    _tail = NIL;
+}
+
+size_t SemVerCache::size() const {
+    return _used;
+}
+
+size_t SemVerCache::capacity() const {
+    return _entries.size();
+}
+
+SemVerCache::Stats SemVerCache::stats() const {
+    return _stats;
+}
+
+ShardedSemVerCache::ShardedSemVerCache(size_t capacity, size_t shards) {
+    size_t count = 1;
+    while (count < shards) count <<= 1;
+    _shardMask = (uint32_t)(count - 1);
+
+    size_t perShard = (capacity + count - 1) / count;
+    _shards.reserve(count);
+    for (size_t i = 0; i < count; i++) _shards.push_back(new Shard(perShard));
+}
+
+ShardedSemVerCache::~ShardedSemVerCache() {
+    for (size_t i = 0; i < _shards.size(); i++) delete _shards[i];
+}
+
+SemVer ShardedSemVerCache::parse(const char* input) {
+    if (!input) return SemVer();
+    size_t len = 0;
+    while (len <= SemVer::MAX_VERSION_LEN && input[len]) len++;
+    return parse(input, len);
+}
+
+SemVer ShardedSemVerCache::parse(const char* input, size_t len) {
+    if (!input || len == 0 || len > SemVer::MAX_VERSION_LEN) return SemVer();
+
+    uint32_t h = SemVerCache::hash(input, len);
+    // The upper half picks the shard, the lower half the bucket inside it; rotating
+    // rather than shifting keeps every shard reachable beyond 65536 shards
+    Shard& shard = *_shards[((h >> 16) | (h << 16)) & _shardMask];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.cache.parse(input, len, h);
+}
+
+void ShardedSemVerCache::clear() {
+    for (size_t i = 0; i < _shards.size(); i++) {
+        std::lock_guard<std::mutex> guard(_shards[i]->lock);
+        _shards[i]->cache.clear();
+    }
+}
+
+size_t ShardedSemVerCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < _shards.size(); i++) {
+        std::lock_guard<std::mutex> guard(_shards[i]->lock);
+        total += _shards[i]->cache.size();
+    }
+    return total;
+}
+
+size_t ShardedSemVerCache::shardCount() const {
+    return _shards.size();
+}
+
+SemVerCache::Stats ShardedSemVerCache::stats() const {
+    SemVerCache::Stats total = { 0, 0, 0 };
+    for (size_t i = 0; i < _shards.size(); i++) {
+        std::lock_guard<std::mutex> guard(_shards[i]->lock);
+        SemVerCache::Stats s = _shards[i]->cache.stats();
+        total.hits += s.hits;
+        total.misses += s.misses;
+        total.evictions += s.evictions;
+    }
+    return total;
+}
+
+#endif // SEMVER_HOST
@@ -0,0 +1,132 @@
+#ifndef SEMVER_CACHE_H
+#define SEMVER_CACHE_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Bounded LRU cache of parse results keyed by the raw version bytes
+ *
+ * A hit costs one hash of the input plus a memcmp against the stored key; the
+ * parsed SemVer (or the fact that the input is invalid) is returned without
+ * running the parser again. All storage is allocated once in the constructor.
+ * Not thread-safe; see ShardedSemVerCache for concurrent use.
+ */
+class SemVerCache {
+public:
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+    };
+
+    /**
+     * @param capacity Maximum number of distinct inputs kept (at least 1)
+     */
+    explicit SemVerCache(size_t capacity);
+
+    /**
+     * @brief Parse a NUL-terminated version string through the cache
+     * @return Parsed version; check isValid() for malformed input
+     */
+    SemVer parse(const char* input);
+
+    /**
+     * @brief Parse a byte range through the cache (no terminator needed)
+     * @param input Version bytes; embedded NUL bytes make the input invalid
+     * @param len Number of bytes
+     */
+    SemVer parse(const char* input, size_t len);
+
+    /**
+     * @brief Same as parse() with a precomputed hash() of the input
+     */
+    SemVer parse(const char* input, size_t len, uint32_t hash);
+
+    /**
+     * @brief Hash used for cache keys (32-bit FNV-1a)
+     */
+    static uint32_t hash(const char* input, size_t len);
+
+    void clear();
+    size_t size() const;
+    size_t capacity() const;
+    Stats stats() const;
+
+private:
+    static const uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Entry {
+        SemVer value;
+        uint32_t hash;
+        uint32_t bucketNext; // Next entry in the same hash bucket
+        uint32_t prev;       // LRU neighbours, most recent at _head
+        uint32_t next;
+        uint16_t len;
+        char key[SemVer::MAX_VERSION_LEN];
+    };
+
+    std::vector<Entry> _entries;
+    std::vector<uint32_t> _buckets;
+    uint32_t _bucketMask;
+    uint32_t _used;
+    uint32_t _head;
+    uint32_t _tail;
+    Stats _stats;
+
+    uint32_t find(const char* input, size_t len, uint32_t hash) const;
+    void unlink(uint32_t idx);
+    void pushFront(uint32_t idx);
+    void removeFromBucket(uint32_t idx);
+    uint32_t acquireSlot();
+};
+
+/**
+ * @brief Lock-sharded SemVerCache for multi-threaded servers
+ *
+ * Inputs are spread over independent shards by hash, each guarded by its own
+ * mutex, so threads parsing different strings rarely contend.
+ */
+class ShardedSemVerCache {
+public:
+    /**
+     * @param capacity Total capacity, split evenly across shards
+     * @param shards Number of shards (rounded up to a power of two)
+     */
+    explicit ShardedSemVerCache(size_t capacity, size_t shards = 16);
+    ~ShardedSemVerCache();
+
+    SemVer parse(const char* input);
+    SemVer parse(const char* input, size_t len);
+
+    void clear();
+    size_t size() const;
+    size_t shardCount() const;
+
+    /**
+     * @brief Counters summed over all shards
+     */
+    SemVerCache::Stats stats() const;
+
+private:
+    struct Shard {
+        mutable std::mutex lock;
+        SemVerCache cache;
+        explicit Shard(size_t capacity) : cache(capacity) {}
+    };
+
+    std::vector<Shard*> _shards;
+    uint32_t _shardMask;
+
+    ShardedSemVerCache(const ShardedSemVerCache&);
+    ShardedSemVerCache& operator=(const ShardedSemVerCache&);
+};
+
+#endif // SEMVER_HOST
+
+#endif
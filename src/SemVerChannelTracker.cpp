@@ -0,0 +1,136 @@
+#include "SemVerChannelTracker.h"
+
+#ifdef SEMVER_HOST
+
+#include <string.h>
+
+const size_t ChannelTracker::MAX_CHANNEL_LEN;
+
+ChannelTracker::ChannelTracker(size_t capacity) : _capacity(capacity ? capacity : 1), _used(0) {
+    // Open addressing at a load factor of at most 0.5
+    size_t slots = 1;
+    while (slots < _capacity * 2) slots <<= 1;
+    _slots = new Slot[slots];
+    _mask = (uint32_t)(slots - 1);
+    for (size_t i = 0; i < slots; i++) {
+        _slots[i].used.store(false, std::memory_order_relaxed);
+        _slots[i].seq.store(0, std::memory_order_relaxed);
+    }
+}
+
+ChannelTracker::~ChannelTracker() {
+    delete[] _slots;
+}
+
+uint32_t ChannelTracker::hash(const char* channel, size_t len, bool wide, uint32_t major) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)channel[i];
+        h *= 16777619u;
+    }
+    h ^= major;
+    h *= 0x9E3779B1u;
+    if (wide) h = ~h;
+    return h ^ (h >> 16);
+}
+
+bool ChannelTracker::publish(const SemVer& version) {
+    if (!version.isValid()) return false;
+
+    // Channel is the leading pre-release identifier
+    const char* pre = version.getPrerelease();
+    size_t len = 0;
+    while (pre[len] && pre[len] != '.') len++;
+    if (len > MAX_CHANNEL_LEN) return false;
+
+    std::lock_guard<std::mutex> guard(_writeLock);
+    // Both entries or neither, so the two views never disagree
+    size_t missing = (find(pre, len, false, version.major) ? 0 : 1) + (find(pre, len, true, 0) ? 0 : 1);
+    if (_used.load(std::memory_order_relaxed) + missing > _capacity) return false;
+
+    bool newest = update(pre, len, false, version.major, version);
+    update(pre, len, true, 0, version);
+    return newest;
+}
+
+bool ChannelTracker::update(const char* channel, size_t len, bool wide, uint32_t major, const SemVer& version) {
+    Slot* slot = const_cast<Slot*>(find(channel, len, wide, major));
+    if (slot) {
+        if (!(version > slot->latest)) return false;
+
+        uint32_t seq = slot->seq.load(std::memory_order_relaxed);
+        slot->seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        store(*slot, version);
+        slot->seq.store(seq + 2, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t i = hash(channel, len, wide, major) & _mask;
+    while (_slots[i].used.load(std::memory_order_relaxed)) i = (i + 1) & _mask;
+
+    // Readers cannot see the slot until 'used' is released, so no seqlock needed
+    Slot& s = _slots[i];
+    s.wide = wide;
+    s.major = major;
+    memcpy(s.channel, channel, len);
+    s.channel[len] = '\0';
+    store(s, version);
+    s.used.store(true, std::memory_order_release);
+    _used.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+const ChannelTracker::Slot* ChannelTracker::find(const char* channel, size_t len, bool wide, uint32_t major) const {
+    // Slots are never freed, so probing can stop at the first unused one
+    for (uint32_t i = hash(channel, len, wide, major) & _mask; ; i = (i + 1) & _mask) {
+        const Slot& s = _slots[i];
+        if (!s.used.load(std::memory_order_acquire)) return NULL;
+        if (s.wide == wide && s.major == major && memcmp(s.channel, channel, len) == 0 && s.channel[len] == '\0') return &s;
+    }
+}
+
+SemVer ChannelTracker::latest(const char* channel) const {
+    return read(channel, true, 0);
+}
+
+SemVer ChannelTracker::latest(const char* channel, uint32_t major) const {
+    return read(channel, false, major);
+}
+
+SemVer ChannelTracker::read(const char* channel, bool wide, uint32_t major) const {
+    if (!channel) return SemVer();
+    size_t len = strlen(channel);
+    if (len > MAX_CHANNEL_LEN) return SemVer();
+
+    const Slot* slot = find(channel, len, wide, major);
+    if (!slot) return SemVer();
+
+    uint32_t words[WORDS];
+    for (;;) {
+        uint32_t before = slot->seq.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        for (size_t i = 0; i < WORDS; i++) words[i] = slot->text[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) == before) break;
+    }
+    // Parse only a consistent copy
+    return SemVer(reinterpret_cast<const char*>(words));
+}
+
+void ChannelTracker::store(Slot& slot, const SemVer& version) {
+    uint32_t words[WORDS] = { 0 };
+    version.toString(reinterpret_cast<char*>(words), sizeof(words));
+    for (size_t i = 0; i < WORDS; i++) slot.text[i].store(words[i], std::memory_order_relaxed);
+    slot.latest = version;
+}
+
+size_t ChannelTracker::size() const {
+    return _used.load(std::memory_order_relaxed);
+}
+
+size_t ChannelTracker::capacity() const {
+    return _capacity;
+}
+
+#endif // SEMVER_HOST
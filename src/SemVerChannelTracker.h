@@ -0,0 +1,94 @@
+#ifndef SEMVER_CHANNEL_TRACKER_H
+#define SEMVER_CHANNEL_TRACKER_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <atomic>
+#include <mutex>
+
+/**
+ * @brief Latest release per channel and per major version, updated on publish
+ *
+ * A release belongs to the channel named by the leading identifier of its
+ * pre-release ("beta" for 2.0.0-beta.3, "" for stable releases). publish() is
+ * O(1): it updates the (channel, major) entry and the channel-wide entry.
+ *
+ * Readers never take a lock. Each entry keeps the release text behind a
+ * sequence lock; a reader copies the text, retries only if a publish rewrote
+ * that same entry meanwhile, and parses its private copy. Readers therefore
+ * never delay writers. Publishers are serialized by a mutex. All storage is
+ * allocated once in the constructor.
+ */
+class ChannelTracker {
+public:
+    static const size_t MAX_CHANNEL_LEN = 15;
+
+    /**
+     * @param capacity Maximum number of entries: one per (channel, major) pair
+     *        plus one per channel
+     */
+    explicit ChannelTracker(size_t capacity = 256);
+    ~ChannelTracker();
+
+    /**
+     * @brief Record a published release
+     * @return true if it is now the latest of its channel and major version;
+     *         false if older, invalid, the channel name is longer than
+     *         MAX_CHANNEL_LEN or the tracker is full. A release that does not
+     *         fit changes neither the per-major nor the channel-wide entry.
+     */
+    bool publish(const SemVer& version);
+
+    /**
+     * @brief Latest release of a channel, across all major versions
+     * @param channel Channel name, "" for stable releases
+     * @return Copy of the latest release (invalid if none was published)
+     */
+    SemVer latest(const char* channel) const;
+
+    /**
+     * @brief Latest release of a channel within one major version
+     */
+    SemVer latest(const char* channel, uint32_t major) const;
+
+    /**
+     * @brief Number of entries in use
+     */
+    size_t size() const;
+    size_t capacity() const;
+
+private:
+    static const size_t WORDS = (SemVer::MAX_VERSION_LEN + 1 + 3) / 4;
+
+    struct Slot {
+        std::atomic<bool> used;      // Set once key and value are written
+        std::atomic<uint32_t> seq;   // Odd while the value is being rewritten
+        bool wide;                   // Channel-wide entry; major is unused
+        uint32_t major;
+        char channel[MAX_CHANNEL_LEN + 1];
+        std::atomic<uint32_t> text[WORDS]; // NUL-terminated release text
+        SemVer latest;                     // Parsed copy, only used by publishers
+    };
+
+    Slot* _slots;
+    uint32_t _mask;
+    size_t _capacity;
+    std::atomic<size_t> _used;
+    std::mutex _writeLock;
+
+    const Slot* find(const char* channel, size_t len, bool wide, uint32_t major) const;
+    bool update(const char* channel, size_t len, bool wide, uint32_t major, const SemVer& version);
+    SemVer read(const char* channel, bool wide, uint32_t major) const;
+    static uint32_t hash(const char* channel, size_t len, bool wide, uint32_t major);
+    static void store(Slot& slot, const SemVer& version);
+
+    ChannelTracker(const ChannelTracker&);
+    ChannelTracker& operator=(const ChannelTracker&);
+};
+
+#endif // SEMVER_HOST
+
+#endif
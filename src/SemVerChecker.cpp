@@ -1,4 +1,5 @@
 #include "SemVerChecker.h"
+#include "SemVerStats.h"
 
 
 size_t SemVer::custom_strlen(const char* s) {
@@ -38,208 +39,315 @@ int SemVer::findChar(const char* s, char c, int start) {
 }
 
 
-SemVer::SemVer() : major(0), minor(0), patch(0), _preOffset(0), _buildOffset(0), _valid(false) {
-    _buffer[0] = '\0';
+namespace {
+
+// Byte sources for the parser. Reading through operator[] lets the same scanner
+// run over RAM strings and, on Arduino, strings kept in flash (PROGMEM).
+struct RamBytes {
+    const char* p;
+    explicit RamBytes(const char* s) : p(s) {}
+    char operator[](int i) const { return p[i]; }
+};
+
+#ifdef ARDUINO
+struct FlashBytes {
+    const uint8_t* p;
+    explicit FlashBytes(const __FlashStringHelper* s) : p(reinterpret_cast<const uint8_t*>(s)) {}
+    char operator[](int i) const { return (char)pgm_read_byte(p + i); }
+};
+#endif
+
+} // namespace
+
+SemVer::SemVer() : major(0), minor(0), patch(0), _valid(false) {
+    clearTail();
 }
 
-SemVer::SemVer(const char* versionString) : major(0), minor(0), patch(0), _preOffset(0), _buildOffset(0), _valid(false) {
+SemVer::SemVer(const char* versionString) : major(0), minor(0), patch(0), _valid(false) {
     parse(versionString);
 }
 
+SemVer::SemVer(const char* versionString, ParseResult& result) : major(0), minor(0), patch(0), _valid(false) {
+    result = parse(versionString);
+}
+
 #ifdef ARDUINO
-SemVer::SemVer(const String& versionString) : major(0), minor(0), patch(0), _preOffset(0), _buildOffset(0), _valid(false) {
+SemVer::SemVer(const String& versionString) : major(0), minor(0), patch(0), _valid(false) {
     parse(versionString.c_str());
 }
-#endif
 
-void SemVer::parse(const char* input) {
-    if (!basicGuards(input)) {
-        _valid = false;
-        return;
-    }
+SemVer::SemVer(const String& versionString, ParseResult& result) : major(0), minor(0), patch(0), _valid(false) {
+    result = parse(versionString.c_str());
+}
 
-    // Copy to internal buffer
-    custom_strncpy(_buffer, input, MAX_VERSION_LEN);
-    _buffer[MAX_VERSION_LEN] = '\0';
+SemVer SemVer::fromFlash(const __FlashStringHelper* versionString) {
+    SemVer version;
+    version.parse(versionString);
+    return version;
+}
 
-    int dot1, dot2, hyphenIndex, plusIndex;
-    if (!splitMainParts(_buffer, dot1, dot2, hyphenIndex, plusIndex)) {
-        _valid = false;
-        return;
-    }
+SemVer SemVer::fromFlash(const __FlashStringHelper* versionString, ParseResult& result) {
+    SemVer version;
+    result = version.parse(versionString);
+    return version;
+}
+#endif
 
-    int endOfPatch = (hyphenIndex != -1) ? hyphenIndex : ((plusIndex != -1) ? plusIndex : (int)custom_strlen(_buffer));
-    int startOfPre = (hyphenIndex != -1) ? hyphenIndex + 1 : -1;
-    int endOfPre   = (plusIndex != -1) ? plusIndex : (int)custom_strlen(_buffer);
-    int startOfBuild = (plusIndex != -1) ? plusIndex + 1 : -1;
-    int endOfBuild = (int)custom_strlen(_buffer);
+void SemVer::fail(ParseResult& result, ParseError error, int offset) {
+    result.error = error;
+    result.offset = (uint16_t)offset;
+}
 
-    if (!validateCore(_buffer, dot1, dot2, endOfPatch)) {
-        _valid = false;
-        return;
+SemVer::ParseResult SemVer::validate(const char* input) {
+    if (!input) return validate(input, 0);
+    return validate(input, custom_strnlen(input, MAX_VERSION_LEN + 1));
+}
+
+SemVer::ParseResult SemVer::validate(const char* input, size_t len) {
+    Layout layout;
+    return scanBytes(RamBytes(input), input ? len : 0, layout);
+}
+
+// Single left-to-right pass over the caller's bytes. Reads nothing past len,
+// writes only to the local layout, and stops at the first offending byte.
+template <typename Bytes>
+SemVer::ParseResult SemVer::scanBytes(const Bytes& s, size_t len, Layout& layout) {
+    ParseResult result = { PARSE_OK, 0 };
+    if (len == 0) {
+        fail(result, PARSE_EMPTY, 0);
+        return result;
+    }
+    if (len > MAX_VERSION_LEN) {
+        fail(result, PARSE_TOO_LONG, (int)MAX_VERSION_LEN);
+        return result;
     }
 
-    if (startOfPre != -1) {
-        if (!validatePrerelease(_buffer, startOfPre, endOfPre)) {
-            _valid = false;
-            return;
+    int n = (int)len;
+    int i = 0;
+    uint32_t core[3];
+
+    // Core: three numbers without leading zeros, each fitting in uint32_t
+    for (int part = 0; part < 3; part++) {
+        int start = i;
+        uint32_t val = 0;
+        while (i < n && s[i] >= '0' && s[i] <= '9') {
+            uint32_t digit = s[i] - '0';
+            if (i == start + 1 && s[start] == '0') {
+                fail(result, PARSE_LEADING_ZERO, start);
+                return result;
+            }
+            if (val > 429496729u || (val == 429496729u && digit > 5)) {
+                fail(result, PARSE_OVERFLOW, i);
+                return result;
+            }
+            val = val * 10 + digit;
+            i++;
         }
-    }
+        core[part] = val;
 
-    if (startOfBuild != -1) {
-        if (!validateBuild(_buffer, startOfBuild, endOfBuild)) {
-            _valid = false;
-            return;
+        char c = (i < n) ? s[i] : '\0';
+        bool atSeparator = (i == n || c == '.' || c == '-' || c == '+');
+        if (i == start) {
+            fail(result, atSeparator ? PARSE_EMPTY_IDENTIFIER : PARSE_INVALID_CHAR, i);
+            return result;
+        }
+        if (part < 2) {
+            if (i == n || c == '-' || c == '+') {
+                fail(result, PARSE_MISSING_PART, i);
+                return result;
+            }
+            if (c != '.') {
+                fail(result, PARSE_INVALID_CHAR, i);
+                return result;
+            }
+            i++;
+        } else if (i < n && c != '-' && c != '+') {
+            fail(result, PARSE_INVALID_CHAR, i);
+            return result;
         }
     }
 
-    uint32_t tmpMajor, tmpMinor, tmpPatch;
-    if (!parseCore(_buffer, dot1, dot2, endOfPatch, tmpMajor, tmpMinor, tmpPatch)) {
-        _valid = false;
-        return;
+    layout.major = core[0];
+    layout.minor = core[1];
+    layout.patch = core[2];
+    layout.hyphen = -1;
+    layout.plus = -1;
+
+    // Pre-release: dot-separated [0-9A-Za-z-] identifiers, numeric ones without leading zeros
+    if (i < n && s[i] == '-') {
+        layout.hyphen = i++;
+        while (true) {
+            int start = i;
+            bool allDigits = true;
+            while (i < n && s[i] != '.' && s[i] != '+') {
+                char c = s[i];
+                bool isDigit = (c >= '0' && c <= '9');
+                if (!isDigit) {
+                    allDigits = false;
+                    bool isAlpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+                    if (!isAlpha && c != '-') {
+                        fail(result, PARSE_INVALID_CHAR, i);
+                        return result;
+                    }
+                }
+                i++;
+            }
+            if (i == start) {
+                fail(result, PARSE_EMPTY_IDENTIFIER, i);
+                return result;
+            }
+            if (allDigits && (i - start) > 1 && s[start] == '0') {
+                fail(result, PARSE_LEADING_ZERO, start);
+                return result;
+            }
+            if (i == n || s[i] == '+') break;
+            i++; // Skip '.'
+        }
     }
 
-    // Commit values
-    major = tmpMajor;
-    minor = tmpMinor;
-    patch = tmpPatch;
-    _preOffset = (startOfPre != -1) ? (uint16_t)startOfPre : 0;
-    _buildOffset = (startOfBuild != -1) ? (uint16_t)startOfBuild : 0;
-    _valid = true;
-
-    // In-place terminate segments with \0 to allow direct pointer use
-    if (hyphenIndex != -1) _buffer[hyphenIndex] = '\0';
-    if (plusIndex != -1) _buffer[plusIndex] = '\0';
-}
-
-bool SemVer::basicGuards(const char* input) const {
-    if (!input || input[0] == '\0') return false;
-    // Check up to MAX_VERSION_LEN + 1. If longer, reject.
-    size_t len = custom_strnlen(input, MAX_VERSION_LEN + 1);
-    if (len > MAX_VERSION_LEN) return false;
-    return true;
-}
-
-bool SemVer::splitMainParts(const char* input, int& dot1, int& dot2, int& hyphen, int& plus) const {
-    dot1 = findChar(input, '.');
-    if (dot1 == -1) return false;
+    // Build metadata: dot-separated [0-9A-Za-z-] identifiers, leading zeros allowed
+    if (i < n && s[i] == '+') {
+        layout.plus = i++;
+        while (true) {
+            int start = i;
+            while (i < n && s[i] != '.') {
+                char c = s[i];
+                bool isAlpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+                bool isDigit = (c >= '0' && c <= '9');
+                if (!isDigit && !isAlpha && c != '-') {
+                    fail(result, PARSE_INVALID_CHAR, i);
+                    return result;
+                }
+                i++;
+            }
+            if (i == start) {
+                fail(result, PARSE_EMPTY_IDENTIFIER, i);
+                return result;
+            }
+            if (i == n) break;
+            i++; // Skip '.'
+        }
+    }
 
-    dot2 = findChar(input, '.', dot1 + 1);
-    if (dot2 == -1) return false;
+    return result;
+}
+
+#ifdef SEMVER_TINY
+// Tag encoding: the byte-wise order of two tags equals SemVer pre-release precedence.
+//   numeric identifier  -> (digit count) followed by packed BCD digits
+//   alphanumeric        -> raw ASCII, preceded by TAG_SEPARATOR if the previous
+//                          identifier was alphanumeric too
+// Digit counts (0x01..0x29) < TAG_SEPARATOR (0x2A) < '-' (0x2D) <= any identifier
+// character, and a shorter tag is smaller, which gives: numeric < alphanumeric,
+// fewer identifiers < more identifiers, shorter identifier < longer one.
+static const uint8_t TAG_SEPARATOR = 0x2A;
+static const int TAG_MAX_DIGITS = 0x29;
+
+template <typename Bytes>
+uint8_t SemVer::encodeTag(const Bytes& s, int start, int end, uint8_t* tag) {
+    uint8_t n = 0;
+    bool prevAlnum = false;
+    int i = start;
+    while (i < end) {
+        int idEnd = i;
+        bool numeric = true;
+        while (idEnd < end && s[idEnd] != '.') {
+            if (s[idEnd] < '0' || s[idEnd] > '9') numeric = false;
+            idEnd++;
+        }
 
-    plus = findChar(input, '+');
-    
-    int scanStart = dot2 + 1;
-    hyphen = -1;
-    
-    for (int i = scanStart; input[i] != '\0'; i++) {
-        char c = input[i];
-        if (c == '+') break; 
-        if (c == '-') {
-            hyphen = i;
-            break;
+        if (numeric) {
+            int digits = idEnd - i;
+            if (digits > TAG_MAX_DIGITS || n == SEMVER_TINY_TAG_LEN) return n | TAG_TRUNCATED;
+            tag[n++] = (uint8_t)digits;
+            for (int j = i; j < idEnd; j += 2) {
+                if (n == SEMVER_TINY_TAG_LEN) return n | TAG_TRUNCATED;
+                uint8_t hi = (uint8_t)(s[j] - '0');
+                uint8_t lo = (j + 1 < idEnd) ? (uint8_t)(s[j + 1] - '0') : 0;
+                tag[n++] = (uint8_t)((hi << 4) | lo);
+            }
+        } else {
+            if (prevAlnum) {
+                if (n == SEMVER_TINY_TAG_LEN) return n | TAG_TRUNCATED;
+                tag[n++] = TAG_SEPARATOR;
+            }
+            for (int j = i; j < idEnd; j++) {
+                if (n == SEMVER_TINY_TAG_LEN) return n | TAG_TRUNCATED;
+                tag[n++] = (uint8_t)s[j];
+            }
         }
-        if (c < '0' || c > '9') return false;
+        prevAlnum = !numeric;
+        i = idEnd + 1;
     }
-    
-    if (hyphen != -1 && plus != -1 && hyphen > plus) return false;
-    if (dot1 == 0 || (dot2 - dot1) <= 1) return false;
-    
-    return true;
+    return n;
 }
+#endif
 
-bool SemVer::validateCore(const char* input, int dot1, int dot2, int endOfPatch) const {
-    if (!checkSegment(input, 0, dot1, false)) return false;
-    if (!checkSegment(input, dot1 + 1, dot2, false)) return false;
-    if (!checkSegment(input, dot2 + 1, endOfPatch, false)) return false;
-    return true;
+SemVer::ParseResult SemVer::parse(const char* input) {
+    // Check up to MAX_VERSION_LEN + 1. If longer, the scanner rejects it.
+    size_t len = input ? custom_strnlen(input, MAX_VERSION_LEN + 1) : 0;
+    return parseBytes(RamBytes(input), len);
 }
 
-bool SemVer::validatePrerelease(const char* input, int start, int end) const {
-    if (start >= end) return false;
-
-    int current = start;
-    while (current < end) {
-        int nextDot = findChar(input, '.', current);
-        if (nextDot == -1 || nextDot > end) nextDot = end;
-        
-        if (nextDot == current) return false;
-        if (!checkSegment(input, current, nextDot, true)) return false;
-        if (nextDot == end) break;
-        if (nextDot == end - 1) return false; 
-        current = nextDot + 1;
+#ifdef ARDUINO
+SemVer::ParseResult SemVer::parse(const __FlashStringHelper* input) {
+    FlashBytes bytes(input);
+    size_t len = 0;
+    if (input) {
+        while (len <= MAX_VERSION_LEN && bytes[(int)len] != '\0') len++;
     }
-    return true;
+    return parseBytes(bytes, len);
 }
+#endif
 
-bool SemVer::validateBuild(const char* input, int start, int end) const {
-    if (start >= end) return false;
-
-    int current = start;
-    while (current < end) {
-        int nextDot = findChar(input, '.', current);
-        if (nextDot == -1 || nextDot > end) nextDot = end;
-
-        if (nextDot == current) return false;
-
-        for (int i = current; i < nextDot; i++) {
-            char c = input[i];
-            bool isAlpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
-            bool isDigit = (c >= '0' && c <= '9');
-            if (!isDigit && !isAlpha && c != '-') return false;
-        }
-
-        if (nextDot == end) break;
-        if (nextDot == end - 1) return false;
-
-        current = nextDot + 1;
+template <typename Bytes>
+SemVer::ParseResult SemVer::parseBytes(const Bytes& input, size_t len) {
+    _valid = false;
+    SEMVER_STAT_PARSE(_valid);
+    clearTail();
+
+    Layout layout;
+    ParseResult result = scanBytes(input, len, layout);
+    if (!result.ok()) return result;
+
+#ifdef SEMVER_TINY
+    // Keep only the encoded pre-release; build metadata was validated and is dropped
+    if (layout.hyphen != -1) {
+        int endOfPre = (layout.plus != -1) ? layout.plus : (int)len;
+        _tagLen = encodeTag(input, layout.hyphen + 1, endOfPre, _tag);
     }
-    return true;
-}
+#else
+    // Copy to internal buffer only once the input is known to be valid
+    for (size_t i = 0; i < len; i++) _buffer[i] = input[(int)i];
+    _buffer[len] = '\0';
 
-bool SemVer::parseCore(const char* input, int dot1, int dot2, int endOfPatch, uint32_t& maj, uint32_t& min, uint32_t& pat) const {
-    if (!parseUint32(input, 0, dot1, maj)) return false;
-    if (!parseUint32(input, dot1 + 1, dot2, min)) return false;
-    if (!parseUint32(input, dot2 + 1, endOfPatch, pat)) return false;
-    return true;
-}
+    _preOffset = (layout.hyphen != -1) ? (uint16_t)(layout.hyphen + 1) : 0;
+    _buildOffset = (layout.plus != -1) ? (uint16_t)(layout.plus + 1) : 0;
 
-bool SemVer::checkSegment(const char* s, int start, int end, bool isPrerelease) const {
-    if (start >= end) return false;
-    
-    bool isAllNumeric = true;
-    for (int i = start; i < end; i++) {
-        char c = s[i];
-        bool isDigit = (c >= '0' && c <= '9');
-        if (!isDigit) {
-            isAllNumeric = false;
-            if (!isPrerelease) return false;
-            bool isAlpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
-            if (!isAlpha && c != '-') return false;
-        }
-    }
+    // In-place terminate segments with \0 to allow direct pointer use
+    if (layout.hyphen != -1) _buffer[layout.hyphen] = '\0';
+    if (layout.plus != -1) _buffer[layout.plus] = '\0';
+#endif
 
-    if (isAllNumeric) {
-        if ((end - start) > 1 && s[start] == '0') return false;
-    }
-    return true;
+    // Commit values
+    major = layout.major;
+    minor = layout.minor;
+    patch = layout.patch;
+    _valid = true;
+    return result;
 }
 
-bool SemVer::parseUint32(const char* s, int start, int end, uint32_t& out) const {
-    uint32_t val = 0;
-    uint32_t cutoff = 429496729;
-    uint32_t cutlim = 5;
-
-    for (int i = start; i < end; i++) {
-        uint32_t digit = s[i] - '0';
-        if (val > cutoff || (val == cutoff && digit > cutlim)) return false;
-        val = val * 10 + digit;
-    }
-    out = val;
-    return true;
+void SemVer::clearTail() {
+#ifdef SEMVER_TINY
+    _tagLen = 0;
+#else
+    _preOffset = 0;
+    _buildOffset = 0;
+    _buffer[0] = '\0';
+#endif
 }
 
-bool SemVer::isNumeric(const char* s, int start, int end) const {
+bool SemVer::isNumeric(const char* s, int start, int end) {
     if (start >= end) return false;
     for (int i = start; i < end; i++) {
         if (s[i] < '0' || s[i] > '9') return false;
@@ -251,6 +359,44 @@ bool SemVer::isValid() const {
     return _valid;
 }
 
+#ifdef SEMVER_TINY
+const char* SemVer::getPrerelease() const {
+    // Decoded into a shared buffer: the text stays valid until the next call
+    static char text[3 * SEMVER_TINY_TAG_LEN + 1];
+    uint8_t len = _tagLen & ~TAG_TRUNCATED;
+    size_t pos = 0;
+    uint8_t i = 0;
+    bool first = true;
+
+    while (i < len) {
+        uint8_t b = _tag[i];
+        if (b == TAG_SEPARATOR) {
+            i++;
+            continue;
+        }
+        if (!first) text[pos++] = '.';
+        first = false;
+
+        if (b < TAG_SEPARATOR) {
+            int digits = b;
+            i++;
+            for (int d = 0; d < digits && i < len; d++) {
+                uint8_t packed = _tag[i];
+                text[pos++] = (char)('0' + ((d & 1) ? (packed & 0x0F) : (packed >> 4)));
+                if ((d & 1) || d == digits - 1) i++;
+            }
+        } else {
+            while (i < len && _tag[i] > TAG_SEPARATOR) text[pos++] = (char)_tag[i++];
+        }
+    }
+    text[pos] = '\0';
+    return text;
+}
+
+const char* SemVer::getBuild() const {
+    return "";
+}
+#else
 const char* SemVer::getPrerelease() const {
     return _preOffset ? &_buffer[_preOffset] : "";
 }
@@ -258,8 +404,42 @@ const char* SemVer::getPrerelease() const {
 const char* SemVer::getBuild() const {
     return _buildOffset ? &_buffer[_buildOffset] : "";
 }
+#endif
+
+bool SemVer::isChannel(const char* channel) const {
+    if (!_valid || !channel) return false;
+    const char* pre = getPrerelease();
+    while (*channel && *pre == *channel) {
+        pre++;
+        channel++;
+    }
+    return *channel == '\0' && (*pre == '\0' || *pre == '.');
+}
+
+bool SemVer::hasPrerelease() const {
+#ifdef SEMVER_TINY
+    return _tagLen != 0;
+#else
+    return _preOffset != 0;
+#endif
+}
+
+bool SemVer::samePrerelease(const SemVer& other) const {
+#ifdef SEMVER_TINY
+    if (_tagLen != other._tagLen) return false;
+    uint8_t len = _tagLen & ~TAG_TRUNCATED;
+    for (uint8_t i = 0; i < len; i++) {
+        if (_tag[i] != other._tag[i]) return false;
+    }
+    return true;
+#else
+    return custom_strcmp(getPrerelease(), other.getPrerelease()) == 0;
+#endif
+}
 
 void SemVer::toString(char* buffer, size_t len) const {
+    SEMVER_STAT_INC(TO_STRING_CALLS);
+    SEMVER_STAT_TIME(TIME_TO_STRING);
     if (!buffer || len == 0) return;
     if (!_valid) {
         custom_strncpy(buffer, "invalid", len);
@@ -367,7 +547,7 @@ size_t SemVer::printTo(Print& p) const {
 bool SemVer::operator==(const SemVer& other) const {
     if (!_valid || !other._valid) return false;
     return major == other.major && minor == other.minor && patch == other.patch && 
-           custom_strcmp(getPrerelease(), other.getPrerelease()) == 0;
+           samePrerelease(other);
 }
 
 bool SemVer::operator!=(const SemVer& other) const {
@@ -375,21 +555,26 @@ bool SemVer::operator!=(const SemVer& other) const {
 }
 
 bool SemVer::operator<(const SemVer& other) const {
+    SEMVER_STAT_INC(COMPARISONS);
+    SEMVER_STAT_TIME(TIME_COMPARE);
     if (!_valid || !other._valid) return false;
     if (major != other.major) return major < other.major;
     if (minor != other.minor) return minor < other.minor;
     if (patch != other.patch) return patch < other.patch;
     
-    const char* preA = getPrerelease();
-    const char* preB = other.getPrerelease();
-    bool hasPreA = (preA[0] != '\0');
-    bool hasPreB = (preB[0] != '\0');
+    SEMVER_STAT_INC(SLOW_COMPARISONS);
+    bool hasPreA = hasPrerelease();
+    bool hasPreB = other.hasPrerelease();
 
     if (hasPreA && !hasPreB) return true;
     if (!hasPreA && hasPreB) return false;
     if (!hasPreA && !hasPreB) return false;
     
-    return comparePrerelease(preA, preB) < 0;
+#ifdef SEMVER_TINY
+    return compareTag(other) < 0;
+#else
+    return comparePrerelease(getPrerelease(), other.getPrerelease()) < 0;
+#endif
 }
 
 bool SemVer::operator>(const SemVer& other) const {
@@ -406,6 +591,133 @@ bool SemVer::operator>=(const SemVer& other) const {
     return !(*this < other);
 }
 
+int SemVer::compareTotal(const SemVer& other) const {
+    SEMVER_STAT_INC(COMPARISONS);
+    SEMVER_STAT_TIME(TIME_COMPARE);
+    if (!_valid || !other._valid) return (int)_valid - (int)other._valid;
+    if (major != other.major) return major < other.major ? -1 : 1;
+    if (minor != other.minor) return minor < other.minor ? -1 : 1;
+    if (patch != other.patch) return patch < other.patch ? -1 : 1;
+
+    SEMVER_STAT_INC(SLOW_COMPARISONS);
+    bool hasPreA = hasPrerelease();
+    bool hasPreB = other.hasPrerelease();
+    if (hasPreA != hasPreB) return hasPreA ? -1 : 1;
+
+#ifdef SEMVER_TINY
+    return hasPreA ? compareTag(other) : 0;
+#else
+    if (hasPreA) {
+        int c = comparePrerelease(getPrerelease(), other.getPrerelease());
+        if (c != 0) return c < 0 ? -1 : 1;
+    }
+    int c = custom_strcmp(getBuild(), other.getBuild());
+    return c < 0 ? -1 : (c > 0 ? 1 : 0);
+#endif
+}
+
+namespace {
+
+// Appends a byte to a sort key; n keeps counting past len so overflow is detected
+inline void putKey(uint8_t* out, size_t len, size_t& n, uint8_t b) {
+    if (n < len) out[n] = b;
+    n++;
+}
+
+inline void putKey32(uint8_t* out, size_t len, size_t& n, uint32_t v) {
+    for (int shift = 24; shift >= 0; shift -= 8) putKey(out, len, n, (uint8_t)(v >> shift));
+}
+
+} // namespace
+
+// Layout: major, minor, patch big-endian; then 0x02 for a release, or 0x01, the
+// pre-release and 0x00; then the build metadata bytes. The parts before the
+// build are self-delimiting, so a plain byte comparison never mixes them up.
+size_t SemVer::sortKey(uint8_t* out, size_t len) const {
+    if (!_valid || !out) return 0;
+    size_t n = 0;
+    putKey32(out, len, n, major);
+    putKey32(out, len, n, minor);
+    putKey32(out, len, n, patch);
+    if (!hasPrerelease()) {
+        putKey(out, len, n, 0x02);
+    } else {
+        putKey(out, len, n, 0x01);
+#ifdef SEMVER_TINY
+        // Tag bytes compare as raw bytes, so escape 0x00/0x01 to keep 0x00 as the
+        // terminator; a truncated tag sorts after an exact one with the same bytes
+        uint8_t tagLen = _tagLen & ~TAG_TRUNCATED;
+        for (uint8_t i = 0; i < tagLen; i++) {
+            if (_tag[i] <= 0x01) putKey(out, len, n, 0x01);
+            putKey(out, len, n, _tag[i]);
+        }
+        putKey(out, len, n, 0x00);
+        putKey(out, len, n, (_tagLen & TAG_TRUNCATED) ? 0x01 : 0x00);
+#else
+        // Identifiers: numeric as 0x01, digit count (2 bytes), digits;
+        // alphanumeric as 0x02, bytes, 0x00. Both sort like comparePrerelease().
+        const char* pre = getPrerelease();
+        while (*pre) {
+            size_t idLen = 0;
+            bool numeric = true;
+            while (pre[idLen] && pre[idLen] != '.') {
+                if (pre[idLen] < '0' || pre[idLen] > '9') numeric = false;
+                idLen++;
+            }
+            if (numeric) {
+                putKey(out, len, n, 0x01);
+                putKey(out, len, n, (uint8_t)(idLen >> 8));
+                putKey(out, len, n, (uint8_t)idLen);
+            } else {
+                putKey(out, len, n, 0x02);
+            }
+            for (size_t i = 0; i < idLen; i++) putKey(out, len, n, (uint8_t)pre[i]);
+            if (!numeric) putKey(out, len, n, 0x00);
+            pre += idLen;
+            if (*pre == '.') pre++;
+        }
+        putKey(out, len, n, 0x00);
+#endif
+    }
+#ifndef SEMVER_TINY
+    for (const char* b = getBuild(); *b; b++) putKey(out, len, n, (uint8_t)*b);
+#endif
+    return n <= len ? n : 0;
+}
+
+uint32_t SemVer::hashTotal() const {
+    uint32_t h = 2166136261u;
+    if (!_valid) return h;
+    const uint32_t core[3] = { major, minor, patch };
+    for (int i = 0; i < 3; i++) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            h ^= (uint8_t)(core[i] >> shift);
+            h *= 16777619u;
+        }
+    }
+#ifdef SEMVER_TINY
+    for (uint8_t i = 0; i < (_tagLen & ~TAG_TRUNCATED); i++) {
+        h ^= _tag[i];
+        h *= 16777619u;
+    }
+    h ^= _tagLen;
+    h *= 16777619u;
+#else
+    // '+' separates the parts, so "1.0.0-a" and "1.0.0+a" differ
+    for (const char* p = getPrerelease(); *p; p++) {
+        h ^= (uint8_t)*p;
+        h *= 16777619u;
+    }
+    h ^= (uint8_t)'+';
+    h *= 16777619u;
+    for (const char* p = getBuild(); *p; p++) {
+        h ^= (uint8_t)*p;
+        h *= 16777619u;
+    }
+#endif
+    return h;
+}
+
 bool SemVer::isUpgrade(const char* baseVersion, const char* newVersion) {
     SemVer v1(baseVersion);
     SemVer v2(newVersion);
@@ -416,9 +728,21 @@ bool SemVer::isUpgrade(const char* baseVersion, const char* newVersion) {
 bool SemVer::isUpgrade(const String& baseVersion, const String& newVersion) {
     return isUpgrade(baseVersion.c_str(), newVersion.c_str());
 }
+
+bool SemVer::isUpgrade_P(const __FlashStringHelper* baseVersion, const char* newVersion) {
+    SemVer v1 = fromFlash(baseVersion);
+    SemVer v2(newVersion);
+    return v1._valid && v2._valid && v2 > v1;
+}
+
+bool SemVer::satisfies(const __FlashStringHelper* requirement, bool includePrerelease) const {
+    return satisfies(fromFlash(requirement), includePrerelease);
+}
 #endif
 
 bool SemVer::satisfies(const SemVer& requirement, bool includePrerelease) const {
+    SEMVER_STAT_INC(SATISFIES_CALLS);
+    SEMVER_STAT_TIME(TIME_SATISFIES);
     // Both versions must be valid
     if (!_valid || !requirement._valid) {
         return false;
@@ -448,7 +772,7 @@ bool SemVer::satisfies(const SemVer& requirement, bool includePrerelease) const
     }
 
     // Check if candidate (this) is a pre-release version
-    bool iAmPrerelease = (getPrerelease()[0] != '\0');
+    bool iAmPrerelease = hasPrerelease();
 
     if (iAmPrerelease) {
         if (!includePrerelease) {
@@ -457,7 +781,7 @@ bool SemVer::satisfies(const SemVer& requirement, bool includePrerelease) const
             // Exception: If requirement IS prerelease, and we matched major/minor/patch above,
             // we are compatible because we are >= requirement.
             
-            bool reqIsPrerelease = (requirement.getPrerelease()[0] != '\0');
+            bool reqIsPrerelease = requirement.hasPrerelease();
             
             if (!reqIsPrerelease) {
                 return false;
@@ -513,69 +837,78 @@ SemVer::DiffType SemVer::diff(const SemVer& other) const {
     if (major != other.major) return MAJOR;
     if (minor != other.minor) return MINOR;
     if (patch != other.patch) return PATCH;
-    if (custom_strcmp(getPrerelease(), other.getPrerelease()) != 0) return PRERELEASE;
+    if (!samePrerelease(other)) return PRERELEASE;
     return NONE;
 }
 
 void SemVer::incMajor() {
     major++; minor = 0; patch = 0;
-    _preOffset = 0; _buildOffset = 0;
-    _buffer[0] = '\0';
+    clearTail();
 }
 
 void SemVer::incMinor() {
     minor++; patch = 0;
-    _preOffset = 0; _buildOffset = 0;
-    _buffer[0] = '\0';
+    clearTail();
 }
 
 void SemVer::incPatch() {
     patch++;
-    _preOffset = 0; _buildOffset = 0;
-    _buffer[0] = '\0';
+    clearTail();
 }
 
+#ifdef SEMVER_TINY
+int SemVer::compareTag(const SemVer& other) const {
+    SEMVER_STAT_INC(PRERELEASE_COMPARES);
+    uint8_t lenA = _tagLen & ~TAG_TRUNCATED;
+    uint8_t lenB = other._tagLen & ~TAG_TRUNCATED;
+    uint8_t minLen = (lenA < lenB) ? lenA : lenB;
+    for (uint8_t i = 0; i < minLen; i++) {
+        if (_tag[i] != other._tag[i]) return (_tag[i] < other._tag[i]) ? -1 : 1;
+    }
+    if (lenA != lenB) return (lenA < lenB) ? -1 : 1;
+    // A truncated tag continues past the stored prefix, so it sorts after an exact
+    // one; two truncated tags with the same prefix are indistinguishable
+    bool truncA = (_tagLen & TAG_TRUNCATED) != 0;
+    bool truncB = (other._tagLen & TAG_TRUNCATED) != 0;
+    if (truncA != truncB) return truncA ? 1 : -1;
+    return 0;
+}
+#endif
+
 int SemVer::comparePrerelease(const char* a, const char* b) const {
+    SEMVER_STAT_INC(PRERELEASE_COMPARES);
     if (custom_strcmp(a, b) == 0) return 0;
-    
-    int startA = 0, startB = 0;
-    size_t lenA = custom_strlen(a);
-    size_t lenB = custom_strlen(b);
-    
-    while (startA < (int)lenA || startB < (int)lenB) {
-        int endA = findChar(a, '.', startA);
-        int endB = findChar(b, '.', startB);
-        if (endA == -1) endA = (int)lenA;
-        if (endB == -1) endB = (int)lenB;
+    return comparePrerelease(a, custom_strlen(a), b, custom_strlen(b));
+}
 
-        if (startA >= (int)lenA && startB < (int)lenB) return -1;
-        if (startA < (int)lenA && startB >= (int)lenB) return 1;
+int SemVer::comparePrerelease(const char* a, size_t lenA, const char* b, size_t lenB) {
+    size_t startA = 0, startB = 0;
+    while (startA < lenA && startB < lenB) {
+        size_t endA = startA, endB = startB;
+        while (endA < lenA && a[endA] != '.') endA++;
+        while (endB < lenB && b[endB] != '.') endB++;
 
-        int segLenA = endA - startA;
-        int segLenB = endB - startB;
+        int c = compareIdentifier(a + startA, endA - startA, b + startB, endB - startB);
+        if (c != 0) return c;
 
-        bool aNum = isNumeric(a, startA, endA);
-        bool bNum = isNumeric(b, startB, endB);
+        startA = (endA < lenA) ? endA + 1 : lenA;
+        startB = (endB < lenB) ? endB + 1 : lenB;
+    }
+    if (startA < lenA) return 1;
+    if (startB < lenB) return -1;
+    return 0;
+}
 
-        if (aNum && bNum) {
-            if (segLenA != segLenB) return (segLenA < segLenB) ? -1 : 1;
-            for (int i = 0; i < segLenA; i++) {
-                if (a[startA + i] != b[startB + i]) return (a[startA + i] < b[startB + i]) ? -1 : 1;
-            }
-        } else if (aNum && !bNum) {
-            return -1; 
-        } else if (!aNum && bNum) {
-            return 1; 
-        } else {
-            int minLen = (segLenA < segLenB) ? segLenA : segLenB;
-            for (int i = 0; i < minLen; i++) {
-                if (a[startA + i] != b[startB + i]) return (a[startA + i] < b[startB + i]) ? -1 : 1;
-            }
-            if (segLenA != segLenB) return (segLenA < segLenB) ? -1 : 1;
-        }
+int SemVer::compareIdentifier(const char* a, size_t lenA, const char* b, size_t lenB) {
+    bool aNum = isNumeric(a, 0, (int)lenA);
+    bool bNum = isNumeric(b, 0, (int)lenB);
+    if (aNum != bNum) return aNum ? -1 : 1;
+    if (aNum && lenA != lenB) return (lenA < lenB) ? -1 : 1;
 
-        startA = (endA < (int)lenA) ? endA + 1 : (int)lenA;
-        startB = (endB < (int)lenB) ? endB + 1 : (int)lenB;
+    size_t minLen = (lenA < lenB) ? lenA : lenB;
+    for (size_t i = 0; i < minLen; i++) {
+        if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
     }
+    if (lenA != lenB) return (lenA < lenB) ? -1 : 1;
     return 0;
 }
\ No newline at end of file
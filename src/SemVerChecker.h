@@ -26,13 +26,93 @@ public:
 #endif
     static const size_t MAX_VERSION_LEN = SEMVER_MAX_LENGTH; 
 
+    // Footprint mode for small MCUs: -DSEMVER_TINY keeps the pre-release as a
+    // compact order-preserving tag and discards build metadata after validation.
+    // Tag size can be configured via build flags: -DSEMVER_TINY_TAG_LEN=2
+#ifdef SEMVER_TINY
+#ifndef SEMVER_TINY_TAG_LEN
+#define SEMVER_TINY_TAG_LEN 6
+#endif
+#if SEMVER_TINY_TAG_LEN < 1 || SEMVER_TINY_TAG_LEN > 127
+#error "SEMVER_TINY_TAG_LEN must be between 1 and 127"
+#endif
+#endif
+
+    enum ParseError {
+        PARSE_OK,
+        PARSE_EMPTY,            // NULL or empty input
+        PARSE_TOO_LONG,         // Longer than MAX_VERSION_LEN
+        PARSE_MISSING_PART,     // Fewer than three dot-separated core numbers
+        PARSE_EMPTY_IDENTIFIER, // Empty number or empty pre-release/build identifier
+        PARSE_LEADING_ZERO,     // Numeric identifier with a leading zero
+        PARSE_INVALID_CHAR,     // Character not allowed at this position
+        PARSE_OVERFLOW          // Core number does not fit in uint32_t
+    };
+
+    /**
+     * @brief Outcome of parsing: error code and byte offset of the failure
+     */
+    struct ParseResult {
+        ParseError error;
+        uint16_t offset; // Byte offset in the input where parsing failed (0 on success)
+
+        bool ok() const { return error == PARSE_OK; }
+    };
+
     SemVer();
     explicit SemVer(const char* versionString);
+    /**
+     * @brief Parse a version string and report why it was rejected
+     * @param versionString Version to parse
+     * @param result Receives the error code and failure offset
+     */
+    SemVer(const char* versionString, ParseResult& result);
 #ifdef ARDUINO
     explicit SemVer(const String& versionString);
+    SemVer(const String& versionString, ParseResult& result);
+    /**
+     * @brief Parse a version string stored in flash, e.g. SemVer::fromFlash(F("1.2.3"))
+     *
+     * Bytes are read with pgm_read_byte directly from flash; no RAM copy of the
+     * input is made before validation. A factory rather than a constructor, so
+     * SemVer(NULL) still resolves to the const char* constructor.
+     */
+    static SemVer fromFlash(const __FlashStringHelper* versionString);
+    static SemVer fromFlash(const __FlashStringHelper* versionString, ParseResult& result);
 #endif
 
     bool isValid() const;
+
+    /**
+     * @brief Validate a version string without constructing a SemVer
+     *
+     * Runs the same rules as the parser directly on the caller's bytes: no copy,
+     * no writes, and it stops at the first invalid byte.
+     * @param input Version bytes (no terminator needed)
+     * @param len Number of bytes
+     * @return Error code and failure offset; ok() is true for a valid version
+     */
+    static ParseResult validate(const char* input, size_t len);
+
+    /**
+     * @brief Validate a NUL-terminated version string without constructing a SemVer
+     */
+    static ParseResult validate(const char* input);
+
+    /**
+     * @brief Compare two pre-release identifiers by SemVer precedence
+     *
+     * Numeric identifiers sort below alphanumeric ones. They have no leading
+     * zeros, so a longer one is larger and equal lengths compare digit by digit.
+     * @return -1, 0 or 1
+     */
+    static int compareIdentifier(const char* a, size_t lenA, const char* b, size_t lenB);
+
+    /**
+     * @brief Compare two dot-separated pre-releases (no terminator needed) by SemVer precedence
+     * @return -1, 0 or 1; with equal shared identifiers, more identifiers rank higher
+     */
+    static int comparePrerelease(const char* a, size_t lenA, const char* b, size_t lenB);
     
 
     void toString(char* buffer, size_t len) const;
@@ -54,6 +134,9 @@ public:
      * @return true if this version is compatible with requirement
      */
     bool satisfies(const SemVer& requirement, bool includePrerelease = false) const;
+#ifdef ARDUINO
+    bool satisfies(const __FlashStringHelper* requirement, bool includePrerelease = false) const;
+#endif
     
     /**
      * @brief Returns the maximum of two versions
@@ -72,9 +155,18 @@ public:
     static SemVer minimum(const SemVer& v1, const SemVer& v2);
 
     // Getters (returns pointers to internal buffer)
+    // With SEMVER_TINY, getPrerelease() decodes into a shared static buffer and
+    // getBuild() always returns ""
     const char* getPrerelease() const;
     const char* getBuild() const;
 
+    /**
+     * @brief Check the release channel (leading pre-release identifier)
+     * @param channel Channel name, e.g. "beta" matches 1.2.0-beta.3; "" matches stable releases
+     * @return true if the version belongs to the channel
+     */
+    bool isChannel(const char* channel) const;
+
 
     bool operator==(const SemVer& other) const;
     bool operator!=(const SemVer& other) const;
@@ -82,6 +174,34 @@ public:
     bool operator>(const SemVer& other) const;
     bool operator<=(const SemVer& other) const;
     bool operator>=(const SemVer& other) const;
+
+    /**
+     * @brief Total order: precedence, then build metadata byte-wise
+     *
+     * The comparison operators ignore build metadata, as SemVer requires, so
+     * 1.0.0+a == 1.0.0+b. compareTotal() tells them apart (1.0.0 < 1.0.0+a <
+     * 1.0.0+b) for use as keys in sorted stores and deduplication. Invalid
+     * versions sort first. With SEMVER_TINY build metadata is not kept, so this
+     * equals precedence.
+     * @return -1, 0 or 1
+     */
+    int compareTotal(const SemVer& other) const;
+
+    // Upper bound on sortKey() length
+    static const size_t MAX_SORT_KEY_LEN = 2 * MAX_VERSION_LEN + 16;
+
+    /**
+     * @brief Byte string whose memcmp order (shorter first on a tie) matches compareTotal()
+     * @param out Receives the key
+     * @param len Size of out; MAX_SORT_KEY_LEN always suffices
+     * @return Key length; 0 for an invalid version or if out is too small
+     */
+    size_t sortKey(uint8_t* out, size_t len) const;
+
+    /**
+     * @brief FNV-1a hash consistent with compareTotal(): equal versions hash equally
+     */
+    uint32_t hashTotal() const;
     
     enum DiffType {
         NONE,
@@ -94,6 +214,10 @@ public:
     static bool isUpgrade(const char* baseVersion, const char* newVersion);
 #ifdef ARDUINO
     static bool isUpgrade(const String& baseVersion, const String& newVersion);
+    /**
+     * @brief isUpgrade() with the base version stored in flash, e.g. isUpgrade_P(F("2.1.5"), received)
+     */
+    static bool isUpgrade_P(const __FlashStringHelper* baseVersion, const char* newVersion);
 #endif
 
 
@@ -105,25 +229,46 @@ public:
     void incPatch();
 
 private:
+#ifdef SEMVER_TINY
+    enum { TAG_TRUNCATED = 0x80 };
+    uint8_t _tag[SEMVER_TINY_TAG_LEN]; // Encoded pre-release (see encodeTag)
+    uint8_t _tagLen;                   // Bytes used in _tag, 0 if empty; TAG_TRUNCATED if cut short
+#else
     char _buffer[MAX_VERSION_LEN + 1];
     uint16_t _preOffset;   // Offset in _buffer, 0 if empty
     uint16_t _buildOffset; // Offset in _buffer, 0 if empty
+#endif
     bool _valid;
 
 
-    void parse(const char* input);
-    bool basicGuards(const char* input) const;
-    bool splitMainParts(const char* input, int& dot1, int& dot2, int& hyphen, int& plus) const;
-    bool validateCore(const char* input, int dot1, int dot2, int endOfPatch) const;
-    bool validatePrerelease(const char* input, int start, int end) const;
-    bool validateBuild(const char* input, int start, int end) const;
-    bool parseCore(const char* input, int dot1, int dot2, int endOfPatch, uint32_t& maj, uint32_t& min, uint32_t& pat) const;
+    // Positions and values collected by scan() for a valid input
+    struct Layout {
+        uint32_t major;
+        uint32_t minor;
+        uint32_t patch;
+        int hyphen; // Index of '-' starting the pre-release, -1 if none
+        int plus;   // Index of '+' starting the build metadata, -1 if none
+    };
+
+    ParseResult parse(const char* input);
+#ifdef ARDUINO
+    ParseResult parse(const __FlashStringHelper* input);
+#endif
+    template <typename Bytes> ParseResult parseBytes(const Bytes& input, size_t len);
+    template <typename Bytes> static ParseResult scanBytes(const Bytes& input, size_t len, Layout& layout);
+    void clearTail();
+
+    bool hasPrerelease() const;
+    bool samePrerelease(const SemVer& other) const;
+#ifdef SEMVER_TINY
+    template <typename Bytes> static uint8_t encodeTag(const Bytes& s, int start, int end, uint8_t* tag);
+    int compareTag(const SemVer& other) const;
+#endif
 
 
     int comparePrerelease(const char* a, const char* b) const;
-    bool isNumeric(const char* s, int start, int end) const;
-    bool checkSegment(const char* s, int start, int end, bool isPrerelease) const;
-    bool parseUint32(const char* s, int start, int end, uint32_t& out) const;
+    static bool isNumeric(const char* s, int start, int end);
+    static void fail(ParseResult& result, ParseError error, int offset);
     
 
     static size_t custom_strlen(const char* s);
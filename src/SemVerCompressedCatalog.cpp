@@ -0,0 +1,431 @@
+#include "SemVerCompressedCatalog.h"
+
+#include <string.h>
+
+const uint32_t CompressedCatalog::NOT_FOUND;
+const uint16_t CompressedCatalog::FORMAT_VERSION;
+const size_t CompressedCatalog::HEADER_SIZE;
+
+namespace {
+
+const uint32_t RELEASE_RANK = 0xFFFFFFFFu; // Rank of a version without pre-release
+const size_t SKIP_ENTRY_SIZE = 4;
+const uint8_t KIND_MASK = 0x03;            // 0: patch delta, 1: minor delta, 2: major delta
+const uint8_t HAS_PRERELEASE = 0x04;
+const uint8_t HAS_BUILD = 0x08;
+const uint8_t DELTA_SHIFT = 4;             // Deltas below 15 sit in the high nibble of the flags
+const uint8_t DELTA_FOLLOWS = 15;
+
+uint16_t read16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+uint32_t read32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool readVarint(const uint8_t*& p, const uint8_t* end, uint32_t& value) {
+    uint32_t v = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        if (p >= end) return false;
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            value = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Pre-release ids compare like the strings; a probe missing from the dictionary
+// gets the even rank between its neighbours
+uint32_t entryRank(uint32_t id) {
+    return id == RELEASE_RANK ? RELEASE_RANK : 2 * id + 1;
+}
+
+// A stored version against a probe, both with pre-releases reduced to ranks
+int compareKey(uint32_t major, uint32_t minor, uint32_t patch, uint32_t rank, const SemVer& version, uint32_t probeRank) {
+    if (major != version.major) return major < version.major ? -1 : 1;
+    if (minor != version.minor) return minor < version.minor ? -1 : 1;
+    if (patch != version.patch) return patch < version.patch ? -1 : 1;
+    if (rank != probeRank) return rank < probeRank ? -1 : 1;
+    return 0;
+}
+
+char* appendNumber(char* out, char* end, uint32_t n) {
+    char digits[10];
+    size_t count = 0;
+    do {
+        digits[count++] = (char)('0' + n % 10);
+        n /= 10;
+    } while (n);
+    if ((size_t)(end - out) < count) return NULL;
+    while (count) *out++ = digits[--count];
+    return out;
+}
+
+char* appendText(char* out, char* end, char separator, const char* text) {
+    if (!out || !*text) return out;
+    size_t len = strlen(text);
+    if ((size_t)(end - out) < len + 1) return NULL;
+    *out++ = separator;
+    memcpy(out, text, len);
+    return out + len;
+}
+
+} // namespace
+
+CompressedCatalog::Cursor::Cursor() : _catalog(NULL), _position(0), _p(NULL), _end(NULL), _id(0) {
+    memset(&_prev, 0, sizeof(_prev));
+}
+
+bool CompressedCatalog::Cursor::next(Entry& entry) {
+    if (!_catalog || _position >= _catalog->_count) return false;
+    // Every block restarts the deltas, so it decodes on its own
+    if (_position % _catalog->_blockEntries == 0) {
+        if (!_catalog->blockRange(_position / _catalog->_blockEntries, _p, _end)) return false;
+        memset(&_prev, 0, sizeof(_prev));
+    }
+    if (_p >= _end) return false;
+
+    uint8_t flags = *_p++;
+    uint32_t a = flags >> DELTA_SHIFT, b = 0, c = 0;
+    uint8_t kind = flags & KIND_MASK;
+    if (kind > 2 || (a == DELTA_FOLLOWS && !readVarint(_p, _end, a))) return false;
+    if (kind >= 1 && !readVarint(_p, _end, b)) return false;
+    if (kind == 2 && !readVarint(_p, _end, c)) return false;
+    if (kind == 0) {
+        entry.major = _prev.major;
+        entry.minor = _prev.minor;
+        entry.patch = _prev.patch + a;
+    } else if (kind == 1) {
+        entry.major = _prev.major;
+        entry.minor = _prev.minor + a;
+        entry.patch = b;
+    } else {
+        entry.major = _prev.major + a;
+        entry.minor = b;
+        entry.patch = c;
+    }
+
+    entry.prerelease = "";
+    _id = RELEASE_RANK;
+    if (flags & HAS_PRERELEASE) {
+        if (!readVarint(_p, _end, _id) || _id >= _catalog->_dictSize) return false;
+        entry.prerelease = _catalog->prerelease(_id);
+    }
+    entry.build = "";
+    if (flags & HAS_BUILD) {
+        const uint8_t* nul = (const uint8_t*)memchr(_p, 0, (size_t)(_end - _p));
+        if (!nul) return false;
+        entry.build = (const char*)_p;
+        _p = nul + 1;
+    }
+
+    _prev = entry;
+    _position++;
+    return true;
+}
+
+bool CompressedCatalog::Cursor::next(SemVer& version) {
+    Entry entry;
+    return next(entry) && toVersion(entry, version);
+}
+
+uint32_t CompressedCatalog::Cursor::position() const {
+    return _position;
+}
+
+CompressedCatalog::CompressedCatalog()
+    : _data(NULL), _len(0), _count(0), _blocks(0), _blockEntries(1), _dictSize(0), _dictOffset(0), _skipOffset(0) {
+}
+
+bool CompressedCatalog::open(const uint8_t* data, size_t len) {
+    _data = NULL;
+    _count = 0;
+    _blocks = 0;
+    if (!data || len < HEADER_SIZE || memcmp(data, "SVC1", 4) != 0) return false;
+    if (read16(data + 4) != FORMAT_VERSION) return false;
+
+    uint16_t blockEntries = read16(data + 6);
+    uint32_t count = read32(data + 8);
+    uint32_t blocks = read32(data + 12);
+    uint32_t dictSize = read32(data + 16);
+    uint32_t dictOffset = read32(data + 20);
+    uint32_t skipOffset = read32(data + 24);
+    uint32_t total = read32(data + 28);
+    if (total > len || total < HEADER_SIZE || blockEntries == 0) return false;
+    if (blocks != count / blockEntries + (count % blockEntries ? 1 : 0)) return false;
+    if (dictOffset > total || dictSize > (total - dictOffset) / 4) return false;
+    if (skipOffset > total || blocks > (total - skipOffset) / SKIP_ENTRY_SIZE) return false;
+
+    // Bounds are checked once here so that lookups can trust the tables
+    for (uint32_t id = 0; id < dictSize; id++) {
+        uint32_t offset = read32(data + dictOffset + 4 * id);
+        if (offset >= total || !memchr(data + offset, 0, total - offset)) return false;
+    }
+    uint32_t previous = 0;
+    for (uint32_t block = 0; block < blocks; block++) {
+        uint32_t offset = read32(data + skipOffset + SKIP_ENTRY_SIZE * block);
+        if (offset < previous || offset > total) return false;
+        previous = offset;
+    }
+
+    _data = data;
+    _len = total;
+    _count = count;
+    _blocks = blocks;
+    _blockEntries = blockEntries;
+    _dictSize = dictSize;
+    _dictOffset = dictOffset;
+    _skipOffset = skipOffset;
+    return true;
+}
+
+uint32_t CompressedCatalog::size() const {
+    return _count;
+}
+
+bool CompressedCatalog::get(uint32_t position, Entry& entry) const {
+    if (position >= _count) return false;
+    Cursor c = cursor(position);
+    return c.next(entry);
+}
+
+bool CompressedCatalog::get(uint32_t position, SemVer& version) const {
+    Entry entry;
+    return get(position, entry) && toVersion(entry, version);
+}
+
+uint32_t CompressedCatalog::lowerBound(const SemVer& version) const {
+    if (!_data || !version.isValid()) return _count;
+    uint32_t rank = rankOf(version);
+
+    // First block that starts at or above the version; the answer is in the block before it.
+    // A block's first entry is stored in full, so probing it decodes a few bytes.
+    uint32_t lo = 0, hi = _blocks;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (compareBlock(mid, version, rank) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == 0) return 0;
+
+    Cursor c = cursor((lo - 1) * (uint32_t)_blockEntries);
+    uint32_t end = lo * (uint32_t)_blockEntries;
+    if (end > _count) end = _count;
+    Entry e;
+    while (c.position() < end && c.next(e)) {
+        if (compareKey(e.major, e.minor, e.patch, entryRank(c._id), version, rank) >= 0) return c.position() - 1;
+    }
+    return end;
+}
+
+uint32_t CompressedCatalog::find(const SemVer& version) const {
+    uint32_t position = lowerBound(version);
+    Entry e;
+    if (position >= _count || !get(position, e)) return NOT_FOUND;
+    if (e.major != version.major || e.minor != version.minor || e.patch != version.patch) return NOT_FOUND;
+    return strcmp(e.prerelease, version.getPrerelease()) == 0 ? position : NOT_FOUND;
+}
+
+CompressedCatalog::Cursor CompressedCatalog::cursor(uint32_t position) const {
+    Cursor c;
+    if (!_data) return c;
+    c._catalog = this;
+    c._position = position - position % _blockEntries;
+    Entry skipped;
+    while (c._position < position && c.next(skipped)) {
+    }
+    return c;
+}
+
+bool CompressedCatalog::toVersion(const Entry& entry, SemVer& version) {
+    char buffer[SemVer::MAX_VERSION_LEN + 1];
+    char* end = buffer + SemVer::MAX_VERSION_LEN;
+    char* out = appendNumber(buffer, end, entry.major);
+    if (out && out < end) *out++ = '.';
+    out = out ? appendNumber(out, end, entry.minor) : NULL;
+    if (out && out < end) *out++ = '.';
+    out = out ? appendNumber(out, end, entry.patch) : NULL;
+    out = appendText(out, end, '-', entry.prerelease);
+    out = appendText(out, end, '+', entry.build);
+    if (!out) return false;
+    *out = '\0';
+    version = SemVer(buffer);
+    return version.isValid();
+}
+
+const char* CompressedCatalog::prerelease(uint32_t id) const {
+    return (const char*)_data + read32(_data + _dictOffset + 4 * id);
+}
+
+// Even ranks fall between dictionary entries, so a probe's rank orders it exactly
+uint32_t CompressedCatalog::rankOf(const SemVer& version) const {
+    const char* pre = version.getPrerelease();
+    if (!pre[0]) return RELEASE_RANK;
+    size_t preLen = strlen(pre);
+    uint32_t lo = 0, hi = _dictSize;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const char* entry = prerelease(mid);
+        int c = SemVer::comparePrerelease(entry, strlen(entry), pre, preLen);
+        if (c == 0) return entryRank(mid);
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return 2 * lo;
+}
+
+// First version of a block against the probe; a corrupt block sorts last
+int CompressedCatalog::compareBlock(uint32_t block, const SemVer& version, uint32_t rank) const {
+    Cursor c = cursor(block * (uint32_t)_blockEntries);
+    Entry e;
+    if (!c.next(e)) return 1;
+    return compareKey(e.major, e.minor, e.patch, entryRank(c._id), version, rank);
+}
+
+bool CompressedCatalog::blockRange(uint32_t block, const uint8_t*& begin, const uint8_t*& end) const {
+    if (block >= _blocks) return false;
+    const uint8_t* skip = _data + _skipOffset + SKIP_ENTRY_SIZE * block;
+    begin = _data + read32(skip);
+    end = block + 1 < _blocks ? _data + read32(skip + SKIP_ENTRY_SIZE) : _data + _len;
+    return true;
+}
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+#include <string>
+
+namespace {
+
+void write16(std::vector<uint8_t>& out, size_t at, uint16_t v) {
+    out[at] = (uint8_t)v;
+    out[at + 1] = (uint8_t)(v >> 8);
+}
+
+void write32(std::vector<uint8_t>& out, size_t at, uint32_t v) {
+    for (int i = 0; i < 4; i++) out[at + i] = (uint8_t)(v >> (8 * i));
+}
+
+void appendVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+// Flags byte with the delta in its high nibble when it fits, else a varint after it
+void appendDelta(std::vector<uint8_t>& out, uint8_t flags, uint32_t delta) {
+    if (delta < DELTA_FOLLOWS) {
+        out.push_back((uint8_t)(flags | (delta << DELTA_SHIFT)));
+        return;
+    }
+    out.push_back((uint8_t)(flags | (DELTA_FOLLOWS << DELTA_SHIFT)));
+    appendVarint(out, delta);
+}
+
+bool prereleaseLess(const std::string& a, const std::string& b) {
+    return SemVer::comparePrerelease(a.data(), a.size(), b.data(), b.size()) < 0;
+}
+
+} // namespace
+
+CompressedCatalogBuilder::CompressedCatalogBuilder(uint16_t blockEntries)
+    : _blockEntries(blockEntries ? blockEntries : 1) {
+}
+
+bool CompressedCatalogBuilder::add(const SemVer& version) {
+    if (!version.isValid()) return false;
+    _versions.push_back(version);
+    return true;
+}
+
+bool CompressedCatalogBuilder::add(const char* version) {
+    return add(SemVer(version));
+}
+
+size_t CompressedCatalogBuilder::count() const {
+    return _versions.size();
+}
+
+void CompressedCatalogBuilder::build(std::vector<uint8_t>& out) const {
+    std::vector<SemVer> versions(_versions);
+    std::sort(versions.begin(), versions.end(), [](const SemVer& a, const SemVer& b) {
+        return a.compareTotal(b) < 0;
+    });
+    versions.erase(std::unique(versions.begin(), versions.end(), [](const SemVer& a, const SemVer& b) {
+        return a.compareTotal(b) == 0;
+    }), versions.end());
+
+    // Dictionary ids in precedence order, so ids compare like the strings
+    std::vector<std::string> dictionary;
+    for (size_t i = 0; i < versions.size(); i++) {
+        const char* pre = versions[i].getPrerelease();
+        if (pre[0]) dictionary.push_back(pre);
+    }
+    std::sort(dictionary.begin(), dictionary.end(), prereleaseLess);
+    dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+
+    uint32_t count = (uint32_t)versions.size();
+    uint32_t blocks = (count + _blockEntries - 1) / _blockEntries;
+    out.assign(CompressedCatalog::HEADER_SIZE, 0);
+    memcpy(&out[0], "SVC1", 4);
+    write16(out, 4, CompressedCatalog::FORMAT_VERSION);
+    write16(out, 6, _blockEntries);
+    write32(out, 8, count);
+    write32(out, 12, blocks);
+    write32(out, 16, (uint32_t)dictionary.size());
+
+    size_t dictOffset = out.size();
+    write32(out, 20, (uint32_t)dictOffset);
+    out.resize(dictOffset + 4 * dictionary.size());
+    for (size_t id = 0; id < dictionary.size(); id++) {
+        write32(out, dictOffset + 4 * id, (uint32_t)out.size());
+        out.insert(out.end(), dictionary[id].begin(), dictionary[id].end());
+        out.push_back(0);
+    }
+
+    size_t skipOffset = out.size();
+    write32(out, 24, (uint32_t)skipOffset);
+    out.resize(skipOffset + SKIP_ENTRY_SIZE * blocks);
+
+    CompressedCatalog::Entry prev = { 0, 0, 0, "", "" };
+    for (uint32_t i = 0; i < count; i++) {
+        const SemVer& v = versions[i];
+        const char* pre = v.getPrerelease();
+        uint32_t id = RELEASE_RANK;
+        if (pre[0]) {
+            id = (uint32_t)(std::lower_bound(dictionary.begin(), dictionary.end(), std::string(pre), prereleaseLess) -
+                            dictionary.begin());
+        }
+        if (i % _blockEntries == 0) {
+            write32(out, skipOffset + SKIP_ENTRY_SIZE * (i / _blockEntries), (uint32_t)out.size());
+            prev.major = prev.minor = prev.patch = 0;
+        }
+
+        const char* build = v.getBuild();
+        uint8_t flags = (uint8_t)((pre[0] ? HAS_PRERELEASE : 0) | (build[0] ? HAS_BUILD : 0));
+        if (v.major != prev.major) {
+            appendDelta(out, flags | 2, v.major - prev.major);
+            appendVarint(out, v.minor);
+            appendVarint(out, v.patch);
+        } else if (v.minor != prev.minor) {
+            appendDelta(out, flags | 1, v.minor - prev.minor);
+            appendVarint(out, v.patch);
+        } else {
+            appendDelta(out, flags, v.patch - prev.patch);
+        }
+        if (pre[0]) appendVarint(out, id);
+        if (build[0]) out.insert(out.end(), build, build + strlen(build) + 1);
+        prev.major = v.major;
+        prev.minor = v.minor;
+        prev.patch = v.patch;
+    }
+    write32(out, 28, (uint32_t)out.size());
+}
+
+#endif // SEMVER_HOST
@@ -0,0 +1,160 @@
+#ifndef SEMVER_COMPRESSED_CATALOG_H
+#define SEMVER_COMPRESSED_CATALOG_H
+
+#include "SemVerChecker.h"
+
+/**
+ * @brief Read-only sorted release catalog in a compact binary form
+ *
+ * Built on the host by CompressedCatalogBuilder and read in place: from RAM,
+ * from memory-mapped flash (e.g. an ESP32 partition mapped with
+ * esp_partition_mmap) or from an mmap'd file. Nothing is copied or allocated.
+ *
+ * Versions are sorted by compareTotal() and split into blocks of a fixed
+ * number of entries. Within a block each entry stores only what changed from
+ * the previous one: the patch delta, or the minor delta and patch, or the
+ * major delta, minor and patch. Deltas below 15 share the flags byte, so a
+ * patch bump is one byte. Pre-releases are ids into a shared dictionary whose
+ * order is pre-release precedence, so searching compares integers. Build
+ * metadata is kept verbatim. Each block restarts from 0.0.0, so its first
+ * entry is stored in full; a table of fixed-size block offsets makes
+ * lowerBound() a binary search over blocks plus a scan of one block.
+ *
+ * Byte layout (integers little-endian):
+ *   header  "SVC1", u16 format, u16 block entries, u32 count, u32 blocks,
+ *           u32 dictionary size, u32 dictionary offset, u32 skip table offset,
+ *           u32 total size
+ *   dictionary  u32 offset per id, then the NUL-terminated pre-release strings
+ *   skip table  u32 data offset per block
+ *   blocks      per entry: flags byte (kind, pre-release, build, small delta),
+ *               varint numbers, varint pre-release id, NUL-terminated build
+ */
+class CompressedCatalog {
+public:
+    static const uint32_t NOT_FOUND = 0xFFFFFFFFu;
+    static const uint16_t FORMAT_VERSION = 1;
+    static const size_t HEADER_SIZE = 32;
+
+    /**
+     * @brief One decoded version; strings point into the catalog data
+     */
+    struct Entry {
+        uint32_t major;
+        uint32_t minor;
+        uint32_t patch;
+        const char* prerelease; // "" for a release
+        const char* build;      // "" if none
+    };
+
+    /**
+     * @brief Sequential reader; much cheaper per version than get()
+     */
+    class Cursor {
+    public:
+        Cursor();
+        /**
+         * @return false at the end of the catalog or on corrupt data
+         */
+        bool next(Entry& entry);
+        bool next(SemVer& version);
+        uint32_t position() const;    // Position of the next entry
+
+    private:
+        friend class CompressedCatalog;
+        const CompressedCatalog* _catalog;
+        uint32_t _position;
+        const uint8_t* _p;
+        const uint8_t* _end;
+        Entry _prev;
+        uint32_t _id;                 // Dictionary id of the last entry's pre-release
+    };
+
+    CompressedCatalog();
+
+    /**
+     * @brief Attach to catalog bytes, which must outlive this object
+     * @return false if the header or tables are malformed or do not fit in len
+     */
+    bool open(const uint8_t* data, size_t len);
+
+    uint32_t size() const;
+
+    /**
+     * @brief Decode the version at a position (decodes up to one block)
+     */
+    bool get(uint32_t position, Entry& entry) const;
+    bool get(uint32_t position, SemVer& version) const;
+
+    /**
+     * @brief First position whose version is not below 'version' by precedence
+     * @return size() if every version is lower
+     */
+    uint32_t lowerBound(const SemVer& version) const;
+
+    /**
+     * @brief Position of the first version equal (operator==) to 'version', or NOT_FOUND
+     */
+    uint32_t find(const SemVer& version) const;
+
+    /**
+     * @brief Reader starting at a position
+     */
+    Cursor cursor(uint32_t position = 0) const;
+
+    /**
+     * @brief Parse a decoded entry into a SemVer
+     */
+    static bool toVersion(const Entry& entry, SemVer& version);
+
+private:
+    const uint8_t* _data;
+    size_t _len;
+    uint32_t _count;
+    uint32_t _blocks;
+    uint16_t _blockEntries;
+    uint32_t _dictSize;
+    uint32_t _dictOffset;
+    uint32_t _skipOffset;
+
+    const char* prerelease(uint32_t id) const;
+    uint32_t rankOf(const SemVer& version) const;
+    int compareBlock(uint32_t block, const SemVer& version, uint32_t rank) const;
+    bool blockRange(uint32_t block, const uint8_t*& begin, const uint8_t*& end) const;
+};
+
+// Builder, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <vector>
+
+/**
+ * @brief Writes the CompressedCatalog format
+ */
+class CompressedCatalogBuilder {
+public:
+    /**
+     * @param blockEntries Versions per block: larger blocks are smaller on disk, slower to search
+     */
+    explicit CompressedCatalogBuilder(uint16_t blockEntries = 64);
+
+    /**
+     * @return false if the version is invalid
+     */
+    bool add(const SemVer& version);
+    bool add(const char* version);
+
+    /**
+     * @brief Sort, drop exact duplicates (compareTotal() == 0) and encode
+     */
+    void build(std::vector<uint8_t>& out) const;
+
+    size_t count() const; // Versions added, duplicates included
+
+private:
+    std::vector<SemVer> _versions;
+    uint16_t _blockEntries;
+};
+
+#endif // SEMVER_HOST
+
+#endif
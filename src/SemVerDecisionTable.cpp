@@ -0,0 +1,154 @@
+#include "SemVerDecisionTable.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+
+const uint32_t DecisionTable::NIL;
+
+DecisionTable::DecisionTable() : _minimumKey(0), _allowed(0), _boundaries(0) {
+    initMap(_bucketMap, 0);
+    initMap(_majorMap, 0);
+}
+
+void DecisionTable::initMap(std::vector<MapSlot>& map, size_t entries) {
+    // Load factor at or below 0.5
+    size_t slots = 2;
+    while (slots < entries * 2) slots <<= 1;
+    MapSlot empty = { 0, NIL };
+    map.assign(slots, empty);
+}
+
+void DecisionTable::insert(std::vector<MapSlot>& map, uint64_t k, uint32_t value) {
+    size_t mask = map.size() - 1;
+    size_t i = (size_t)((k * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    while (map[i].value != NIL && map[i].key != k) i = (i + 1) & mask;
+    map[i].key = k;
+    map[i].value = value;
+}
+
+uint32_t DecisionTable::lookup(const std::vector<MapSlot>& map, uint64_t k) {
+    size_t mask = map.size() - 1;
+    for (size_t i = (size_t)((k * 0x9E3779B97F4A7C15ull) >> 32) & mask; ; i = (i + 1) & mask) {
+        if (map[i].value == NIL) return NIL;
+        if (map[i].key == k) return map[i].value;
+    }
+}
+
+size_t DecisionTable::compile(const UpdatePolicy& policy, const std::vector<SemVer>& catalog) {
+    _releases.clear();
+    _buckets.clear();
+    _boundaries = 0;
+    _allowed = policy.allowedDiffs;
+
+    for (size_t i = 0; i < catalog.size(); i++) {
+        const SemVer& v = catalog[i];
+        if (v.isValid() && (policy.includePrerelease || v.getPrerelease()[0] == '\0')) _releases.push_back(v);
+    }
+    std::sort(_releases.begin(), _releases.end());
+    _releases.erase(std::unique(_releases.begin(), _releases.end()), _releases.end());
+
+    // A minimum above the latest release cannot be reached; cap it
+    _minimum = policy.minimum;
+    if (_minimum.isValid() && !_releases.empty() && _releases.back() < _minimum) _minimum = _releases.back();
+    if (_releases.empty()) _minimum = SemVer();
+    _minimumKey = key(_minimum.major, _minimum.minor);
+
+    initMap(_majorMap, _releases.size());
+    for (uint32_t i = 0; i < _releases.size(); i++) insert(_majorMap, _releases[i].major, i); // Ascending: newest wins
+
+    // One bucket per (major, minor) holding a release, plus the minimum's bucket
+    for (uint32_t i = 0; i < _releases.size(); ) {
+        uint32_t j = i;
+        while (j < _releases.size() && _releases[j].major == _releases[i].major &&
+               _releases[j].minor == _releases[i].minor) j++;
+        Bucket b = { NIL, i, j, UP_TO_DATE, false };
+        _buckets.push_back(b);
+        i = j;
+    }
+    if (_minimum.isValid()) {
+        Bucket b = { NIL, 0, 0, UP_TO_DATE, false };
+        std::vector<Bucket>::iterator it = _buckets.begin();
+        while (it != _buckets.end() && key(_releases[it->first].major, _releases[it->first].minor) < _minimumKey) ++it;
+        if (it == _buckets.end() || key(_releases[it->first].major, _releases[it->first].minor) != _minimumKey) {
+            _buckets.insert(it, b);
+        }
+    }
+
+    initMap(_bucketMap, _buckets.size());
+    bool sameBucketUpdates = (_allowed & (UpdatePolicy::allow(SemVer::PATCH) | UpdatePolicy::allow(SemVer::PRERELEASE))) != 0;
+    for (uint32_t i = 0; i < _buckets.size(); i++) {
+        Bucket& b = _buckets[i];
+        bool hasReleases = b.first != b.last;
+        uint64_t k = hasReleases ? key(_releases[b.first].major, _releases[b.first].minor) : _minimumKey;
+        insert(_bucketMap, k, i);
+
+        b.target = higherCandidate((uint32_t)(k >> 32), (uint32_t)k);
+        if (_minimum.isValid() && k < _minimumKey) {
+            b.action = REQUIRED;
+            b.target = (uint32_t)(_releases.size() - 1);
+        } else if ((_minimum.isValid() && k == _minimumKey) ||
+                   (b.target == NIL && hasReleases && sameBucketUpdates)) {
+            // Patch or pre-release decides: compare exactly at lookup time
+            b.boundary = true;
+            _boundaries++;
+        } else {
+            b.action = b.target != NIL ? OFFER : UP_TO_DATE;
+        }
+    }
+    return _buckets.size();
+}
+
+uint32_t DecisionTable::higherCandidate(uint32_t major, uint32_t minor) const {
+    if (_releases.empty()) return NIL;
+    const SemVer& latest = _releases.back();
+    // The latest release beats everything when it is in a higher major
+    if ((_allowed & UpdatePolicy::allow(SemVer::MAJOR)) && latest.major > major) return (uint32_t)(_releases.size() - 1);
+    if (_allowed & UpdatePolicy::allow(SemVer::MINOR)) {
+        uint32_t newest = lookup(_majorMap, major);
+        if (newest != NIL && _releases[newest].minor > minor) return newest;
+    }
+    return NIL;
+}
+
+DecisionTable::Decision DecisionTable::make(uint8_t action, uint32_t target) const {
+    Decision d = { (Action)action, target == NIL ? NULL : &_releases[target] };
+    return d;
+}
+
+DecisionTable::Decision DecisionTable::exact(const Bucket& b, const SemVer& device) const {
+    if (_minimum.isValid() && device < _minimum) return make(REQUIRED, (uint32_t)(_releases.size() - 1));
+    if (b.target != NIL) return make(OFFER, b.target);
+    for (uint32_t i = b.last; i > b.first; i--) {
+        const SemVer& r = _releases[i - 1];
+        if (!(device < r)) break;
+        if (_allowed & UpdatePolicy::allow(device.diff(r))) return make(OFFER, i - 1);
+    }
+    return make(UP_TO_DATE, NIL);
+}
+
+DecisionTable::Decision DecisionTable::decide(const SemVer& device) const {
+    if (!device.isValid()) return make(INVALID, NIL);
+
+    uint64_t k = key(device.major, device.minor);
+    uint32_t idx = lookup(_bucketMap, k);
+    if (idx != NIL) {
+        const Bucket& b = _buckets[idx];
+        return b.boundary ? exact(b, device) : make(b.action, b.target);
+    }
+
+    // No release or minimum in this bucket: every device in it gets the same answer
+    if (_minimum.isValid() && k < _minimumKey) return make(REQUIRED, (uint32_t)(_releases.size() - 1));
+    uint32_t target = higherCandidate(device.major, device.minor);
+    return make(target != NIL ? OFFER : UP_TO_DATE, target);
+}
+
+size_t DecisionTable::bucketCount() const {
+    return _buckets.size();
+}
+
+size_t DecisionTable::boundaryCount() const {
+    return _boundaries;
+}
+
+#endif // SEMVER_HOST
@@ -0,0 +1,108 @@
+#ifndef SEMVER_DECISION_TABLE_H
+#define SEMVER_DECISION_TABLE_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <vector>
+
+/**
+ * @brief Rules deciding which release a device is offered
+ *
+ * A device is offered the newest eligible release above it whose diff() from
+ * the device version is in allowedDiffs. Devices below the minimum must move
+ * to the latest release regardless of allowedDiffs.
+ */
+struct UpdatePolicy {
+    SemVer minimum;           // Invalid = no minimum
+    uint8_t allowedDiffs;     // Bit mask of allow(SemVer::DiffType)
+    bool includePrerelease;   // Pre-releases may be offered
+
+    UpdatePolicy() : allowedDiffs(allow(SemVer::MAJOR) | allow(SemVer::MINOR) |
+                                  allow(SemVer::PATCH) | allow(SemVer::PRERELEASE)),
+                     includePrerelease(false) {}
+
+    static uint8_t allow(SemVer::DiffType type) { return (uint8_t)(1u << type); }
+};
+
+/**
+ * @brief Update decisions precompiled per (major, minor) bucket
+ *
+ * For a fixed catalog and policy, devices sharing major and minor almost always
+ * get the same answer. compile() stores one entry per bucket that holds a release
+ * or the minimum; decide() is a hash lookup of the device's bucket, or for any
+ * other bucket an O(1) rule from the newest release of its major. Only buckets
+ * where patch or pre-release can change the answer are marked as boundaries and
+ * fall back to exact comparisons against that bucket's own releases.
+ */
+class DecisionTable {
+public:
+    enum Action {
+        INVALID,     // Device version is malformed
+        UP_TO_DATE,  // Nothing newer is allowed by the policy
+        OFFER,       // target is the newest allowed release
+        REQUIRED     // Device is below the minimum; target is the latest release
+    };
+
+    struct Decision {
+        Action action;
+        const SemVer* target; // Points into the table; NULL unless OFFER or REQUIRED
+    };
+
+    DecisionTable();
+
+    /**
+     * @brief Build the table for a catalog under a policy
+     * @param catalog Releases in any order; invalid entries and duplicates are ignored
+     * @return Number of buckets stored
+     */
+    size_t compile(const UpdatePolicy& policy, const std::vector<SemVer>& catalog);
+
+    /**
+     * @brief Decision for one device; valid until the next compile()
+     */
+    Decision decide(const SemVer& device) const;
+
+    size_t bucketCount() const;
+    size_t boundaryCount() const;
+
+private:
+    static const uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Bucket {
+        uint32_t target;  // Fixed target, or the candidate from higher buckets if boundary
+        uint32_t first;   // Releases of this bucket in _releases: [first, last)
+        uint32_t last;
+        uint8_t action;
+        bool boundary;
+    };
+
+    struct MapSlot {
+        uint64_t key;
+        uint32_t value;   // NIL marks an empty slot
+    };
+
+    std::vector<SemVer> _releases;      // Eligible releases, ascending
+    std::vector<Bucket> _buckets;
+    std::vector<MapSlot> _bucketMap;    // (major, minor) -> index into _buckets
+    std::vector<MapSlot> _majorMap;     // major -> newest release of that major
+    SemVer _minimum;
+    uint64_t _minimumKey;
+    uint8_t _allowed;
+    size_t _boundaries;
+
+    static uint64_t key(uint32_t major, uint32_t minor) { return ((uint64_t)major << 32) | minor; }
+    static void initMap(std::vector<MapSlot>& map, size_t entries);
+    static void insert(std::vector<MapSlot>& map, uint64_t key, uint32_t value);
+    static uint32_t lookup(const std::vector<MapSlot>& map, uint64_t key);
+
+    uint32_t higherCandidate(uint32_t major, uint32_t minor) const;
+    Decision make(uint8_t action, uint32_t target) const;
+    Decision exact(const Bucket& bucket, const SemVer& device) const;
+};
+
+#endif // SEMVER_HOST
+
+#endif
@@ -0,0 +1,436 @@
+#include "SemVerExternalSort.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+const size_t MAX_FAN_IN = 256;
+const size_t MIN_BUFFER = 4096;
+const size_t MAX_BUFFER = 1u << 20;
+
+// Buffered record output to a run file
+class RunWriter {
+public:
+    RunWriter(FILE* file, size_t bufferSize) : _file(file), _ok(true) { _buffer.reserve(bufferSize); }
+
+    void putVarint(uint64_t v) {
+        while (v >= 0x80) {
+            _buffer.push_back((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        _buffer.push_back((uint8_t)v);
+    }
+
+    void putBytes(const char* p, size_t n) {
+        _buffer.insert(_buffer.end(), (const uint8_t*)p, (const uint8_t*)p + n);
+        if (_buffer.size() >= _buffer.capacity() / 2) flush();
+    }
+
+    bool flush() {
+        if (!_buffer.empty() && fwrite(&_buffer[0], 1, _buffer.size(), _file) != _buffer.size()) _ok = false;
+        _buffer.clear();
+        return _ok;
+    }
+
+private:
+    FILE* _file;
+    std::vector<uint8_t> _buffer;
+    bool _ok;
+};
+
+} // namespace
+
+// Streams the records of one run file; key points into this reader's own storage
+class ExternalSorter::RunReader {
+public:
+    Key key;
+    bool done;
+    bool error;
+
+    RunReader(FILE* file, size_t bufferSize)
+        : done(false), error(false), _file(file), _buffer(bufferSize), _pos(0), _len(0) {
+        rewind(_file);
+        advance();
+    }
+
+    ~RunReader() { fclose(_file); }
+
+    void advance() {
+        uint64_t major, minor, patch, preLen, buildLen;
+        if (!getVarint(major, true)) return;
+        if (!getVarint(minor, false) || !getVarint(patch, false) || !getVarint(preLen, false) ||
+            preLen > SemVer::MAX_VERSION_LEN || !getBytes(_text, (size_t)preLen) ||
+            !getVarint(buildLen, false) || preLen + buildLen > SemVer::MAX_VERSION_LEN ||
+            !getBytes(_text + preLen, (size_t)buildLen)) {
+            error = done = true;
+            return;
+        }
+        key.major = (uint32_t)major;
+        key.minor = (uint32_t)minor;
+        key.patch = (uint32_t)patch;
+        key.pre = _text;
+        key.preLen = (uint16_t)preLen;
+        key.build = _text + preLen;
+        key.buildLen = (uint16_t)buildLen;
+    }
+
+private:
+    FILE* _file;
+    std::vector<uint8_t> _buffer;
+    size_t _pos;
+    size_t _len;
+    char _text[SemVer::MAX_VERSION_LEN];
+
+    bool fill() {
+        _len = fread(&_buffer[0], 1, _buffer.size(), _file);
+        _pos = 0;
+        if (_len == 0 && ferror(_file)) error = true;
+        return _len > 0;
+    }
+
+    // A clean end of file is only allowed before the first byte of a record
+    bool getVarint(uint64_t& v, bool recordStart) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (_pos == _len && !fill()) {
+                if (recordStart && shift == 0) done = true;
+                else error = done = true;
+                return false;
+            }
+            uint8_t b = _buffer[_pos++];
+            v |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool getBytes(char* out, size_t n) {
+        while (n) {
+            if (_pos == _len && !fill()) return false;
+            size_t chunk = std::min(n, _len - _pos);
+            memcpy(out, &_buffer[_pos], chunk);
+            _pos += chunk;
+            out += chunk;
+            n -= chunk;
+        }
+        return true;
+    }
+};
+
+ExternalSorter::ExternalSorter(size_t memoryBytes, bool unique, const char* tempDir)
+    : _tempDir(tempDir), _memory(memoryBytes), _memoryPos(0), _runsWritten(0), _count(0), _invalid(0),
+      _unique(unique), _finished(false), _failed(false), _hasLast(false) {
+    _fanIn = std::max<size_t>(2, std::min(MAX_FAN_IN, memoryBytes / (64u << 10)));
+    _bufferSize = std::max(MIN_BUFFER, std::min(MAX_BUFFER, memoryBytes / (_fanIn + 1)));
+    memset(&_last, 0, sizeof(_last));
+    _out[0] = '\0';
+}
+
+ExternalSorter::~ExternalSorter() {
+    closeMerge();
+    for (size_t i = 0; i < _runs.size(); i++) fclose(_runs[i]);
+}
+
+bool ExternalSorter::add(const SemVer& version) {
+    if (_finished || _failed) return false;
+    if (!version.isValid()) {
+        _invalid++;
+        return false;
+    }
+    const char* pre = version.getPrerelease();
+    const char* build = version.getBuild();
+    Item item;
+    item.major = version.major;
+    item.minor = version.minor;
+    item.patch = version.patch;
+    item.offset = (uint32_t)_arena.size();
+    item.preLen = (uint16_t)strlen(pre);
+    item.buildLen = (uint16_t)strlen(build);
+    _arena.insert(_arena.end(), pre, pre + item.preLen);
+    _arena.insert(_arena.end(), build, build + item.buildLen);
+    _items.push_back(item);
+    _count++;
+
+    if (_items.size() * sizeof(Item) + _arena.size() >= _memory) return spill();
+    return true;
+}
+
+bool ExternalSorter::add(const char* version) {
+    return add(SemVer(version));
+}
+
+bool ExternalSorter::finish() {
+    if (_finished) return !_failed;
+    _finished = true;
+    if (_failed) return false;
+
+    if (_runs.empty()) {
+        // Everything fit in memory; next() reads _items directly
+        sortItems();
+        return true;
+    }
+    if (!_items.empty() && !spill()) return false;
+    std::vector<Item>().swap(_items);
+    std::vector<char>().swap(_arena);
+
+    // Merge consecutive groups so equal versions keep their input order
+    while (_runs.size() > _fanIn) {
+        std::vector<FILE*> merged;
+        for (size_t first = 0; first < _runs.size(); first += _fanIn) {
+            size_t last = std::min(_runs.size(), first + _fanIn);
+            FILE* out = last - first > 1 ? createRun() : NULL;
+            if (last - first > 1 && (!out || !mergeInto(first, last, out))) {
+                // mergeInto() has closed its inputs either way
+                if (out) fclose(out);
+                for (size_t i = out ? last : first; i < _runs.size(); i++) fclose(_runs[i]);
+                _runs.swap(merged);
+                _failed = true;
+                return false;
+            }
+            merged.push_back(out ? out : _runs[first]);
+        }
+        _runs.swap(merged);
+    }
+
+    openMerge(0, _runs.size());
+    _runs.clear();
+    for (size_t i = 0; i < _readers.size(); i++) {
+        if (_readers[i]->error) _failed = true;
+    }
+    return !_failed;
+}
+
+const char* ExternalSorter::next() {
+    if (!_finished || _failed) return NULL;
+    for (;;) {
+        Key key;
+        size_t winner = 0;
+        if (_readers.empty()) {
+            if (_memoryPos >= _items.size()) return NULL;
+            key = keyOf(_items[_memoryPos++]);
+        } else {
+            winner = _tree[0];
+            if (_readers[winner]->done) {
+                for (size_t i = 0; i < _readers.size(); i++) {
+                    if (_readers[i]->error) _failed = true;
+                }
+                return NULL;
+            }
+            key = _readers[winner]->key;
+        }
+        bool skip = _unique && duplicate(key);
+        if (!skip) format(key, _out);
+        if (!_readers.empty()) {
+            _readers[winner]->advance();
+            replay(winner);
+        }
+        if (!skip) return _out;
+    }
+}
+
+bool ExternalSorter::next(SemVer& version) {
+    const char* text = next();
+    if (!text) return false;
+    version = SemVer(text);
+    return true;
+}
+
+uint64_t ExternalSorter::count() const {
+    return _count;
+}
+
+uint64_t ExternalSorter::invalid() const {
+    return _invalid;
+}
+
+size_t ExternalSorter::runs() const {
+    return _runsWritten;
+}
+
+bool ExternalSorter::failed() const {
+    return _failed;
+}
+
+void ExternalSorter::sortItems() {
+    std::stable_sort(_items.begin(), _items.end(), [this](const Item& a, const Item& b) {
+        return compare(keyOf(a), keyOf(b)) < 0;
+    });
+}
+
+bool ExternalSorter::spill() {
+    sortItems();
+    FILE* file = createRun();
+    if (!file) {
+        _failed = true;
+        return false;
+    }
+    RunWriter writer(file, _bufferSize);
+    _hasLast = false;
+    for (size_t i = 0; i < _items.size(); i++) {
+        Key key = keyOf(_items[i]);
+        if (_unique && duplicate(key)) continue;
+        writer.putVarint(key.major);
+        writer.putVarint(key.minor);
+        writer.putVarint(key.patch);
+        writer.putVarint(key.preLen);
+        writer.putBytes(key.pre, key.preLen);
+        writer.putVarint(key.buildLen);
+        writer.putBytes(key.build, key.buildLen);
+    }
+    _hasLast = false;
+    _runs.push_back(file);
+    _items.clear();
+    _arena.clear();
+    if (!writer.flush() || fflush(file) != 0) {
+        _failed = true;
+        return false;
+    }
+    return true;
+}
+
+FILE* ExternalSorter::createRun() {
+    FILE* file = NULL;
+    if (_tempDir) {
+        std::string path = std::string(_tempDir) + "/semver-run-XXXXXX";
+        int fd = mkstemp(&path[0]);
+        if (fd >= 0) {
+            unlink(path.c_str()); // Removed when closed
+            file = fdopen(fd, "w+b");
+            if (!file) close(fd);
+        }
+    } else {
+        file = tmpfile();
+    }
+    if (file) _runsWritten++;
+    return file;
+}
+
+bool ExternalSorter::mergeInto(size_t first, size_t last, FILE* out) {
+    openMerge(first, last);
+    RunWriter writer(out, _bufferSize);
+    _hasLast = false;
+    bool ok = true;
+    for (;;) {
+        RunReader* winner = _readers[_tree[0]];
+        if (winner->done) break;
+        const Key& key = winner->key;
+        if (!_unique || !duplicate(key)) {
+            writer.putVarint(key.major);
+            writer.putVarint(key.minor);
+            writer.putVarint(key.patch);
+            writer.putVarint(key.preLen);
+            writer.putBytes(key.pre, key.preLen);
+            writer.putVarint(key.buildLen);
+            writer.putBytes(key.build, key.buildLen);
+        }
+        winner->advance();
+        replay(_tree[0]);
+    }
+    for (size_t i = 0; i < _readers.size(); i++) {
+        if (_readers[i]->error) ok = false;
+    }
+    _hasLast = false;
+    closeMerge();
+    return writer.flush() && fflush(out) == 0 && ok;
+}
+
+void ExternalSorter::openMerge(size_t first, size_t last) {
+    for (size_t i = first; i < last; i++) _readers.push_back(new RunReader(_runs[i], _bufferSize));
+    _tree.assign(_readers.size(), 0);
+    if (!_readers.empty()) _tree[0] = buildTree(1);
+}
+
+void ExternalSorter::closeMerge() {
+    for (size_t i = 0; i < _readers.size(); i++) delete _readers[i];
+    _readers.clear();
+    _tree.clear();
+}
+
+// Nodes 1..k-1 are internal, k..2k-1 are the readers; returns the subtree winner
+size_t ExternalSorter::buildTree(size_t node) {
+    size_t k = _readers.size();
+    if (node >= k) return node - k;
+    size_t a = buildTree(2 * node);
+    size_t b = buildTree(2 * node + 1);
+    if (beats(a, b)) {
+        _tree[node] = b;
+        return a;
+    }
+    _tree[node] = a;
+    return b;
+}
+
+// Replays the matches on the path from a reader that advanced to the root
+void ExternalSorter::replay(size_t reader) {
+    size_t winner = reader;
+    for (size_t node = (reader + _readers.size()) / 2; node > 0; node /= 2) {
+        if (beats(_tree[node], winner)) std::swap(_tree[node], winner);
+    }
+    _tree[0] = winner;
+}
+
+// Exhausted readers lose to everything; ties go to the earlier run
+bool ExternalSorter::beats(size_t a, size_t b) const {
+    const RunReader* ra = _readers[a];
+    const RunReader* rb = _readers[b];
+    if (ra->done || rb->done) return !ra->done && (rb->done || a < b);
+    int c = compare(ra->key, rb->key);
+    return c < 0 || (c == 0 && a < b);
+}
+
+// True if key equals the last version kept; otherwise keeps a copy of key
+bool ExternalSorter::duplicate(const Key& key) {
+    if (_hasLast && compare(key, _last) == 0) return true;
+    memcpy(_lastText, key.pre, key.preLen);
+    _last = key;
+    _last.pre = _lastText;
+    _last.build = "";
+    _last.buildLen = 0;
+    _hasLast = true;
+    return false;
+}
+
+ExternalSorter::Key ExternalSorter::keyOf(const Item& item) const {
+    Key key;
+    key.major = item.major;
+    key.minor = item.minor;
+    key.patch = item.patch;
+    key.pre = _arena.empty() ? "" : &_arena[item.offset];
+    key.preLen = item.preLen;
+    key.build = key.pre + item.preLen;
+    key.buildLen = item.buildLen;
+    return key;
+}
+
+// Same precedence as SemVer::operator<; build metadata is ignored
+int ExternalSorter::compare(const Key& a, const Key& b) {
+    if (a.major != b.major) return a.major < b.major ? -1 : 1;
+    if (a.minor != b.minor) return a.minor < b.minor ? -1 : 1;
+    if (a.patch != b.patch) return a.patch < b.patch ? -1 : 1;
+    if (!a.preLen || !b.preLen) return (int)(a.preLen == 0) - (int)(b.preLen == 0);
+    return SemVer::comparePrerelease(a.pre, a.preLen, b.pre, b.preLen);
+}
+
+void ExternalSorter::format(const Key& key, char* out) {
+    int n = snprintf(out, SemVer::MAX_VERSION_LEN + 1, "%lu.%lu.%lu", (unsigned long)key.major,
+                     (unsigned long)key.minor, (unsigned long)key.patch);
+    if (key.preLen) {
+        out[n++] = '-';
+        memcpy(out + n, key.pre, key.preLen);
+        n += key.preLen;
+    }
+    if (key.buildLen) {
+        out[n++] = '+';
+        memcpy(out + n, key.build, key.buildLen);
+        n += key.buildLen;
+    }
+    out[n] = '\0';
+}
+
+#endif // SEMVER_HOST
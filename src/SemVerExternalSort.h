@@ -0,0 +1,130 @@
+#ifndef SEMVER_EXTERNAL_SORT_H
+#define SEMVER_EXTERNAL_SORT_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <stdio.h>
+#include <vector>
+
+/**
+ * @brief Sorts a version stream larger than memory by SemVer precedence
+ *
+ * Versions are buffered up to the memory budget, sorted and written to a
+ * temporary run file in a compact binary form (varint numbers plus raw
+ * pre-release and build bytes), so runs are never reparsed. finish() merges
+ * the runs with a loser tree, in several passes if there are more runs than
+ * the budget allows open at once; next() then streams the final merge.
+ *
+ * Output equals std::stable_sort with operator< over the accepted versions:
+ * versions of equal precedence (differing only in build metadata) keep their
+ * input order. With unique, only the first of each such group is returned.
+ */
+class ExternalSorter {
+public:
+    /**
+     * @param memoryBytes Approximate memory for buffered versions and merge buffers
+     * @param unique Drop versions equal (operator==) to an earlier one
+     * @param tempDir Directory for run files; NULL uses tmpfile()
+     */
+    explicit ExternalSorter(size_t memoryBytes = 64u << 20, bool unique = false, const char* tempDir = NULL);
+    ~ExternalSorter();
+
+    /**
+     * @brief Add a version to the stream; only valid before finish()
+     * @return false if the version is invalid (counted in invalid()) or a run could not be written
+     */
+    bool add(const SemVer& version);
+    bool add(const char* version);
+
+    /**
+     * @brief Sort the buffered versions and merge runs down to one final merge
+     * @return false on a temporary file error
+     */
+    bool finish();
+
+    /**
+     * @brief Next version in sorted order
+     * @return Version text, valid until the next call; NULL at the end or on error
+     */
+    const char* next();
+
+    /**
+     * @brief Next version in sorted order, parsed into a SemVer
+     * @return false at the end or on error
+     */
+    bool next(SemVer& version);
+
+    uint64_t count() const;   // Versions accepted by add()
+    uint64_t invalid() const; // Versions rejected by add()
+    size_t runs() const;      // Run files written, including intermediate merges
+    bool failed() const;      // A temporary file could not be created, written or read
+
+private:
+    // One version in memory: numbers plus pre-release and build bytes in _arena
+    struct Item {
+        uint32_t major;
+        uint32_t minor;
+        uint32_t patch;
+        uint32_t offset;
+        uint16_t preLen;
+        uint16_t buildLen;
+    };
+
+    // A decoded version being compared, in memory or read from a run
+    struct Key {
+        uint32_t major;
+        uint32_t minor;
+        uint32_t patch;
+        const char* pre;
+        const char* build;
+        uint16_t preLen;
+        uint16_t buildLen;
+    };
+
+    class RunReader;
+
+    std::vector<Item> _items;
+    std::vector<char> _arena;
+    std::vector<FILE*> _runs;        // Unmerged runs, in input order
+    std::vector<RunReader*> _readers;
+    std::vector<size_t> _tree;       // Loser tree over _readers; _tree[0] is the winner
+    const char* _tempDir;
+    size_t _memory;
+    size_t _memoryPos;               // Next item returned when nothing was spilled
+    size_t _fanIn;
+    size_t _bufferSize;
+    size_t _runsWritten;
+    uint64_t _count;
+    uint64_t _invalid;
+    bool _unique;
+    bool _finished;
+    bool _failed;
+    bool _hasLast;
+    Key _last;
+    char _lastText[SemVer::MAX_VERSION_LEN + 1];
+    char _out[SemVer::MAX_VERSION_LEN + 1];
+
+    ExternalSorter(const ExternalSorter&);
+    ExternalSorter& operator=(const ExternalSorter&);
+
+    void sortItems();
+    bool spill();
+    FILE* createRun();
+    bool mergeInto(size_t first, size_t last, FILE* out);
+    void openMerge(size_t first, size_t last);
+    void closeMerge();
+    size_t buildTree(size_t node);
+    void replay(size_t reader);
+    bool beats(size_t a, size_t b) const;
+    bool duplicate(const Key& key);
+    Key keyOf(const Item& item) const;
+    static int compare(const Key& a, const Key& b);
+    static void format(const Key& key, char* out);
+};
+
+#endif // SEMVER_HOST
+
+#endif
@@ -0,0 +1,210 @@
+#include "SemVerFleetJoin.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+template <typename Work>
+void parallelFor(unsigned threads, Work work) {
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) workers.push_back(std::thread(work, t));
+    work(0u);
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+}
+
+// Whether v lies below the range's lower bound
+bool belowLow(const VersionRange& r, const SemVer& v) {
+    if (!r.low.isValid()) return false;
+    return v < r.low || (!r.lowInclusive && !(r.low < v));
+}
+
+// Whether v lies at or below the range's upper bound
+bool withinHigh(const VersionRange& r, const SemVer& v) {
+    if (!r.high.isValid()) return true;
+    return v < r.high || (r.highInclusive && !(r.high < v));
+}
+
+} // namespace
+
+const uint32_t FleetJoin::NIL;
+
+FleetJoin::FleetJoin() : _words(0) {}
+
+bool FleetJoin::addAdvisory(uint32_t advisory, const char* ranges) {
+    std::vector<VersionRange> parsed;
+    if (!VersionRange::parse(ranges, parsed)) return false;
+    for (size_t i = 0; i < parsed.size(); i++) addAdvisory(advisory, parsed[i]);
+    return true;
+}
+
+void FleetJoin::addAdvisory(uint32_t advisory, const VersionRange& range) {
+    if (range.empty()) return;
+    Range r = { range, advisory, NIL };
+    _ranges.push_back(r);
+}
+
+void FleetJoin::prepareRanges() {
+    // Union the ranges of each advisory so no device is counted twice
+    std::sort(_ranges.begin(), _ranges.end(), [](const Range& a, const Range& b) {
+        if (a.advisory != b.advisory) return a.advisory < b.advisory;
+        return VersionRange::compareLow(a.range, b.range) < 0;
+    });
+
+    std::vector<Range> merged;
+    _counts.clear();
+    for (size_t i = 0; i < _ranges.size(); i++) {
+        Range r = _ranges[i];
+        if (_counts.empty() || _counts.back().advisory != r.advisory) {
+            AdvisoryCount c = { r.advisory, 0 };
+            _counts.push_back(c);
+        } else if (!VersionRange::before(merged.back().range, r.range)) {
+            Range& last = merged.back();
+            if (VersionRange::compareHigh(r.range, last.range) > 0) {
+                last.range.high = r.range.high;
+                last.range.highInclusive = r.range.highInclusive;
+            }
+            continue;
+        }
+        r.slot = (uint32_t)(_counts.size() - 1);
+        merged.push_back(r);
+    }
+    _ranges.swap(merged);
+}
+
+void FleetJoin::sortFleet(const std::vector<SemVer>& fleet, unsigned threads, bool mapDevices) {
+    size_t n = fleet.size();
+    size_t chunk = (n + threads - 1) / threads;
+
+    // Each thread sorts a chunk of devices and collapses it to distinct versions
+    std::vector<std::vector<uint32_t> > reps(threads);     // Representative device per local version
+    std::vector<std::vector<uint64_t> > devices(threads);  // Devices per local version
+    _deviceVersion.assign(mapDevices ? n : 0, NIL);
+
+    parallelFor(threads, [&](unsigned t) {
+        size_t begin = std::min(n, t * chunk), end = std::min(n, begin + chunk);
+        std::vector<uint32_t> order;
+        order.reserve(end - begin);
+        for (size_t i = begin; i < end; i++) {
+            if (fleet[i].isValid()) order.push_back((uint32_t)i);
+        }
+        std::sort(order.begin(), order.end(), [&fleet](uint32_t a, uint32_t b) { return fleet[a] < fleet[b]; });
+
+        for (size_t i = 0; i < order.size(); i++) {
+            if (i == 0 || fleet[order[i - 1]] < fleet[order[i]]) {
+                reps[t].push_back(order[i]);
+                devices[t].push_back(0);
+            }
+            devices[t].back()++;
+            if (mapDevices) _deviceVersion[order[i]] = (uint32_t)(reps[t].size() - 1);
+        }
+    });
+
+    // Merge the per-chunk distinct lists (small compared to the fleet)
+    std::vector<std::pair<uint32_t, uint64_t> > all;
+    for (unsigned t = 0; t < threads; t++) {
+        for (size_t i = 0; i < reps[t].size(); i++) all.push_back(std::make_pair(reps[t][i], devices[t][i]));
+    }
+    std::sort(all.begin(), all.end(), [&fleet](const std::pair<uint32_t, uint64_t>& a, const std::pair<uint32_t, uint64_t>& b) {
+        return fleet[a.first] < fleet[b.first];
+    });
+
+    _versions.clear();
+    _prefix.assign(1, 0);
+    for (size_t i = 0; i < all.size(); i++) {
+        const SemVer& v = fleet[all[i].first];
+        if (_versions.empty() || _versions.back() < v) {
+            _versions.push_back(v);
+            _prefix.push_back(_prefix.back());
+        }
+        _prefix.back() += all[i].second;
+    }
+
+    if (!mapDevices) return;
+    parallelFor(threads, [&](unsigned t) {
+        std::vector<uint32_t> global(reps[t].size());
+        for (size_t i = 0; i < reps[t].size(); i++) {
+            global[i] = (uint32_t)(std::lower_bound(_versions.begin(), _versions.end(), fleet[reps[t][i]]) - _versions.begin());
+        }
+        size_t begin = std::min(n, t * chunk), end = std::min(n, begin + chunk);
+        for (size_t i = begin; i < end; i++) {
+            if (_deviceVersion[i] != NIL) _deviceVersion[i] = global[_deviceVersion[i]];
+        }
+    });
+}
+
+void FleetJoin::run(const std::vector<SemVer>& fleet, unsigned threads, bool deviceBitsets) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    prepareRanges();
+    sortFleet(fleet, threads, deviceBitsets);
+
+    _words = deviceBitsets ? (_counts.size() + 63) / 64 : 0;
+    _bitsets.assign(_words * _versions.size(), 0);
+
+    std::vector<uint32_t> byLow(_ranges.size()), byHigh(_ranges.size());
+    for (uint32_t i = 0; i < _ranges.size(); i++) byLow[i] = byHigh[i] = i;
+    std::sort(byLow.begin(), byLow.end(), [this](uint32_t a, uint32_t b) {
+        return VersionRange::compareLow(_ranges[a].range, _ranges[b].range) < 0;
+    });
+    std::sort(byHigh.begin(), byHigh.end(), [this](uint32_t a, uint32_t b) {
+        return VersionRange::compareHigh(_ranges[a].range, _ranges[b].range) < 0;
+    });
+
+    // Each thread owns a slice of the distinct versions and sweeps all endpoints over it
+    size_t slice = (_versions.size() + threads - 1) / threads;
+    std::vector<std::vector<uint64_t> > partial(threads, std::vector<uint64_t>(_counts.size(), 0));
+
+    parallelFor(threads, [&](unsigned t) {
+        size_t begin = std::min(_versions.size(), t * slice), end = std::min(_versions.size(), begin + slice);
+        if (begin == end) return;
+
+        // first[r]: first version in the slice not below r; past[r]: first version above r
+        std::vector<size_t> first(_ranges.size()), past(_ranges.size());
+        size_t v = begin;
+        for (size_t i = 0; i < byLow.size(); i++) {
+            const VersionRange& r = _ranges[byLow[i]].range;
+            while (v < end && belowLow(r, _versions[v])) v++;
+            first[byLow[i]] = v;
+        }
+        v = begin;
+        for (size_t i = 0; i < byHigh.size(); i++) {
+            const VersionRange& r = _ranges[byHigh[i]].range;
+            while (v < end && withinHigh(r, _versions[v])) v++;
+            past[byHigh[i]] = v;
+        }
+
+        for (size_t r = 0; r < _ranges.size(); r++) {
+            if (past[r] <= first[r]) continue;
+            uint32_t slot = _ranges[r].slot;
+            partial[t][slot] += _prefix[past[r]] - _prefix[first[r]];
+            if (_words) {
+                for (size_t i = first[r]; i < past[r]; i++) _bitsets[i * _words + slot / 64] |= 1ull << (slot % 64);
+            }
+        }
+    });
+
+    for (unsigned t = 0; t < threads; t++) {
+        for (size_t i = 0; i < _counts.size(); i++) _counts[i].devices += partial[t][i];
+    }
+}
+
+const std::vector<FleetJoin::AdvisoryCount>& FleetJoin::counts() const {
+    return _counts;
+}
+
+size_t FleetJoin::distinctVersions() const {
+    return _versions.size();
+}
+
+const uint64_t* FleetJoin::deviceBitset(size_t device) const {
+    if (_words == 0 || device >= _deviceVersion.size() || _deviceVersion[device] == NIL) return NULL;
+    return &_bitsets[(size_t)_deviceVersion[device] * _words];
+}
+
+size_t FleetJoin::bitsetWords() const {
+    return _words;
+}
+
+#endif // SEMVER_HOST
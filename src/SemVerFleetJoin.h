@@ -0,0 +1,89 @@
+#ifndef SEMVER_FLEET_JOIN_H
+#define SEMVER_FLEET_JOIN_H
+
+#include "SemVerRange.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <vector>
+
+/**
+ * @brief Batch join of a whole fleet against advisory ranges
+ *
+ * run() sorts the fleet once into distinct versions with device counts, then
+ * walks the sorted range endpoints against the sorted versions in a single
+ * merge pass: each range maps to a slice of distinct versions, and prefix sums
+ * of the device counts give its total without visiting the devices. Both the
+ * fleet sort (by input chunks) and the sweep (by slices of the version space)
+ * run on multiple threads.
+ *
+ * Optionally a bitset of matching advisories is built per distinct version, so
+ * every device can look up which advisories affect it.
+ */
+class FleetJoin {
+public:
+    struct AdvisoryCount {
+        uint32_t advisory;
+        uint64_t devices;
+    };
+
+    FleetJoin();
+
+    /**
+     * @brief Add the ranges of an advisory (see VersionRange::parse)
+     * @return false if the expression does not parse (nothing is added)
+     */
+    bool addAdvisory(uint32_t advisory, const char* ranges);
+    void addAdvisory(uint32_t advisory, const VersionRange& range);
+
+    /**
+     * @brief Join a fleet against all advisories added so far
+     * @param fleet One version per device; invalid entries match nothing
+     * @param threads Worker threads (0 = hardware concurrency)
+     * @param deviceBitsets Also build per-device advisory bitsets
+     */
+    void run(const std::vector<SemVer>& fleet, unsigned threads = 0, bool deviceBitsets = false);
+
+    /**
+     * @brief Devices affected per advisory, ascending by advisory id
+     */
+    const std::vector<AdvisoryCount>& counts() const;
+
+    /**
+     * @brief Distinct valid versions in the last fleet
+     */
+    size_t distinctVersions() const;
+
+    /**
+     * @brief Advisories affecting a device of the last fleet
+     * @return bitsetWords() words; bit i refers to counts()[i]. NULL if bitsets
+     *         were not requested or the device version is invalid.
+     */
+    const uint64_t* deviceBitset(size_t device) const;
+    size_t bitsetWords() const;
+
+private:
+    static const uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Range {
+        VersionRange range;
+        uint32_t advisory;
+        uint32_t slot;      // Index into _counts
+    };
+
+    std::vector<Range> _ranges;
+    std::vector<AdvisoryCount> _counts;
+    std::vector<SemVer> _versions;       // Distinct, ascending
+    std::vector<uint64_t> _prefix;       // _prefix[i] = devices on _versions[0..i)
+    std::vector<uint32_t> _deviceVersion; // Device -> index into _versions, NIL if invalid
+    std::vector<uint64_t> _bitsets;      // bitsetWords() words per distinct version
+    size_t _words;
+
+    void prepareRanges();
+    void sortFleet(const std::vector<SemVer>& fleet, unsigned threads, bool mapDevices);
+};
+
+#endif // SEMVER_HOST
+
+#endif
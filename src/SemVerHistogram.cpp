@@ -0,0 +1,293 @@
+#include "SemVerHistogram.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+const uint8_t MAGIC[4] = { 'S', 'V', 'H', 1 };
+const uint64_t ALL_EXACT = 1ull << 32;
+const size_t MAX_SKETCH_CELLS = 1u << 24; // Guards deserialize() against absurd sizes
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) return false;
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+VersionHistogram::VersionHistogram(size_t exactPrereleases, size_t sketchWidth, size_t sketchDepth)
+    : _width(sketchWidth ? sketchWidth : 1), _depth(sketchDepth ? sketchDepth : 1),
+      _exactLimit(exactPrereleases), _exactPrereleases(0), _threshold(ALL_EXACT),
+      _total(0), _sketched(0), _invalid(0) {
+    _sketch.assign(_width * _depth, 0);
+}
+
+std::string VersionHistogram::keyOf(const SemVer& version) {
+    char text[SemVer::MAX_VERSION_LEN + 1];
+    version.toString(text, sizeof(text));
+    char* plus = strchr(text, '+');
+    if (plus) *plus = '\0';
+    return std::string(text);
+}
+
+uint64_t VersionHistogram::hash(const std::string& key) {
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < key.size(); i++) {
+        h ^= (uint8_t)key[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+uint64_t VersionHistogram::sampleHash(uint64_t h) {
+    // Decorrelated from the sketch indices, which use the raw hash halves
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return h >> 32;
+}
+
+void VersionHistogram::add(const char* version, uint64_t count) {
+    add(SemVer(version), count);
+}
+
+void VersionHistogram::add(const SemVer& version, uint64_t count) {
+    if (!version.isValid()) {
+        _invalid += count;
+        return;
+    }
+    std::string key = keyOf(version);
+    addKey(key, hash(key), version.getPrerelease()[0] != '\0', count);
+}
+
+void VersionHistogram::addKey(const std::string& key, uint64_t h, bool prerelease, uint64_t count) {
+    _total += count;
+    if (prerelease && sampleHash(h) >= _threshold) {
+        addToSketch(h, count);
+        return;
+    }
+
+    Map::iterator it = _exact.find(key);
+    if (it != _exact.end()) {
+        it->second.count += count;
+        return;
+    }
+    Entry e = { count, h, prerelease };
+    _exact.insert(std::make_pair(key, e));
+    if (prerelease) {
+        _exactPrereleases++;
+        shrink();
+    }
+}
+
+void VersionHistogram::addToSketch(uint64_t h, uint64_t count) {
+    uint32_t h1 = (uint32_t)h, h2 = (uint32_t)(h >> 32) | 1;
+    for (size_t row = 0; row < _depth; row++) {
+        _sketch[row * _width + (h1 + row * h2) % _width] += count;
+    }
+    _sketched += count;
+}
+
+void VersionHistogram::shrink() {
+    while (_exactPrereleases > _exactLimit) {
+        _threshold >>= 1;
+        for (Map::iterator it = _exact.begin(); it != _exact.end(); ) {
+            if (it->second.prerelease && sampleHash(it->second.hash) >= _threshold) {
+                addToSketch(it->second.hash, it->second.count);
+                _exactPrereleases--;
+                it = _exact.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+uint64_t VersionHistogram::estimate(const SemVer& version) const {
+    if (!version.isValid()) return 0;
+    std::string key = keyOf(version);
+    Map::const_iterator it = _exact.find(key);
+    if (it != _exact.end()) return it->second.count;
+
+    uint64_t h = hash(key);
+    // Stable releases and sampled pre-releases would be in the exact map if seen
+    if (version.getPrerelease()[0] == '\0' || sampleHash(h) < _threshold) return 0;
+
+    uint32_t h1 = (uint32_t)h, h2 = (uint32_t)(h >> 32) | 1;
+    uint64_t best = UINT64_MAX;
+    for (size_t row = 0; row < _depth; row++) {
+        best = std::min(best, _sketch[row * _width + (h1 + row * h2) % _width]);
+    }
+    return best;
+}
+
+std::vector<VersionHistogram::Bucket> VersionHistogram::top(size_t k) const {
+    std::vector<Bucket> all;
+    all.reserve(_exact.size());
+    for (Map::const_iterator it = _exact.begin(); it != _exact.end(); ++it) {
+        Bucket b = { SemVer(it->first.c_str()), it->second.count };
+        all.push_back(b);
+    }
+    k = std::min(k, all.size());
+    std::partial_sort(all.begin(), all.begin() + k, all.end(), [](const Bucket& a, const Bucket& b) {
+        if (a.count != b.count) return a.count > b.count;
+        return b.version < a.version;
+    });
+    all.resize(k);
+    return all;
+}
+
+bool VersionHistogram::merge(const VersionHistogram& other) {
+    if (other._width != _width || other._depth != _depth) return false;
+    // Adding into _exact while iterating it would invalidate the iterator
+    if (&other == this) {
+        VersionHistogram copy(other);
+        return merge(copy);
+    }
+
+    // Lower threshold wins; then apply the combined capacity
+    if (other._threshold < _threshold) {
+        _threshold = other._threshold;
+        for (Map::iterator it = _exact.begin(); it != _exact.end(); ) {
+            if (it->second.prerelease && sampleHash(it->second.hash) >= _threshold) {
+                addToSketch(it->second.hash, it->second.count);
+                _exactPrereleases--;
+                it = _exact.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    _exactLimit = std::min(_exactLimit, other._exactLimit);
+
+    for (size_t i = 0; i < _sketch.size(); i++) _sketch[i] += other._sketch[i];
+    _sketched += other._sketched;
+    _total += other._sketched;
+    _invalid += other._invalid;
+
+    for (Map::const_iterator it = other._exact.begin(); it != other._exact.end(); ++it) {
+        addKey(it->first, it->second.hash, it->second.prerelease, it->second.count);
+    }
+    shrink();
+    return true;
+}
+
+std::vector<uint8_t> VersionHistogram::serialize() const {
+    std::vector<uint8_t> out(MAGIC, MAGIC + sizeof(MAGIC));
+    putVarint(out, _width);
+    putVarint(out, _depth);
+    putVarint(out, _exactLimit);
+    putVarint(out, _threshold);
+    putVarint(out, _invalid);
+    putVarint(out, _sketched);
+
+    // Sorted keys make the encoding canonical
+    std::vector<Map::const_iterator> entries;
+    for (Map::const_iterator it = _exact.begin(); it != _exact.end(); ++it) entries.push_back(it);
+    std::sort(entries.begin(), entries.end(), [](Map::const_iterator a, Map::const_iterator b) {
+        return a->first < b->first;
+    });
+    putVarint(out, entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        putVarint(out, entries[i]->first.size());
+        out.insert(out.end(), entries[i]->first.begin(), entries[i]->first.end());
+        putVarint(out, entries[i]->second.count);
+    }
+
+    // Sketch counters, with runs of zeros as 0 followed by the run length
+    for (size_t i = 0; i < _sketch.size(); ) {
+        if (_sketch[i] != 0) {
+            putVarint(out, _sketch[i++]);
+            continue;
+        }
+        size_t run = 0;
+        while (i < _sketch.size() && _sketch[i] == 0) { run++; i++; }
+        putVarint(out, 0);
+        putVarint(out, run);
+    }
+    return out;
+}
+
+bool VersionHistogram::deserialize(const uint8_t* data, size_t len) {
+    if (!data || len < sizeof(MAGIC) || memcmp(data, MAGIC, sizeof(MAGIC)) != 0) return false;
+    const uint8_t* p = data + sizeof(MAGIC);
+    const uint8_t* end = data + len;
+
+    uint64_t width, depth, limit, threshold, invalid, sketched, entries;
+    if (!getVarint(p, end, width) || !getVarint(p, end, depth) || !getVarint(p, end, limit) ||
+        !getVarint(p, end, threshold) || !getVarint(p, end, invalid) || !getVarint(p, end, sketched) ||
+        !getVarint(p, end, entries)) return false;
+    if (width == 0 || depth == 0 || width > MAX_SKETCH_CELLS / depth || threshold > ALL_EXACT) return false;
+
+    VersionHistogram h((size_t)limit, (size_t)width, (size_t)depth);
+    h._threshold = threshold;
+    h._invalid = invalid;
+    for (uint64_t i = 0; i < entries; i++) {
+        uint64_t keyLen, count;
+        if (!getVarint(p, end, keyLen) || keyLen > SemVer::MAX_VERSION_LEN || (uint64_t)(end - p) < keyLen) return false;
+        std::string key((const char*)p, (size_t)keyLen);
+        p += keyLen;
+        if (!getVarint(p, end, count)) return false;
+
+        SemVer v(key.c_str());
+        if (!v.isValid() || keyOf(v) != key || h._exact.count(key)) return false;
+        bool prerelease = v.getPrerelease()[0] != '\0';
+        Entry e = { count, hash(key), prerelease };
+        h._exact.insert(std::make_pair(key, e));
+        h._exactPrereleases += prerelease;
+        h._total += count;
+    }
+
+    for (size_t i = 0; i < h._sketch.size(); ) {
+        uint64_t v;
+        if (!getVarint(p, end, v)) return false;
+        if (v != 0) {
+            h._sketch[i++] = v;
+            continue;
+        }
+        uint64_t run;
+        if (!getVarint(p, end, run) || run == 0 || run > h._sketch.size() - i) return false;
+        i += (size_t)run;
+    }
+    if (p != end || h._exactPrereleases > h._exactLimit) return false;
+
+    h._sketched = sketched;
+    h._total += sketched;
+    *this = h;
+    return true;
+}
+
+uint64_t VersionHistogram::total() const {
+    return _total;
+}
+
+uint64_t VersionHistogram::sketched() const {
+    return _sketched;
+}
+
+uint64_t VersionHistogram::invalid() const {
+    return _invalid;
+}
+
+size_t VersionHistogram::exactSize() const {
+    return _exact.size();
+}
+
+#endif // SEMVER_HOST
@@ -0,0 +1,107 @@
+#ifndef SEMVER_HISTOGRAM_H
+#define SEMVER_HISTOGRAM_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Mergeable histogram of versions for multi-node aggregation
+ *
+ * Versions are counted exactly, keyed by their text without build metadata (the
+ * same equality as operator==). Stable releases are always exact. Pre-releases
+ * are exact while their key hash is below a threshold; when more than the
+ * configured number of distinct pre-releases are tracked, the threshold halves
+ * and the entries above it move into a count-min sketch. Since whether a
+ * pre-release is exact depends only on its hash and the final threshold,
+ * merge() is associative and commutative: any grouping of node snapshots gives
+ * byte-identical serialize() output.
+ */
+class VersionHistogram {
+public:
+    struct Bucket {
+        SemVer version;
+        uint64_t count;
+    };
+
+    /**
+     * @param exactPrereleases Distinct pre-releases counted exactly before sketching
+     * @param sketchWidth Counters per count-min row
+     * @param sketchDepth Count-min rows
+     */
+    explicit VersionHistogram(size_t exactPrereleases = 256, size_t sketchWidth = 1024, size_t sketchDepth = 4);
+
+    /**
+     * @brief Count a version; invalid versions only increase invalid()
+     */
+    void add(const SemVer& version, uint64_t count = 1);
+    void add(const char* version, uint64_t count = 1);
+
+    /**
+     * @brief Count of a version: exact if tracked, otherwise a count-min upper bound
+     */
+    uint64_t estimate(const SemVer& version) const;
+
+    /**
+     * @brief Exactly counted versions with the highest counts, highest first
+     */
+    std::vector<Bucket> top(size_t k) const;
+
+    /**
+     * @brief Add another histogram's counts into this one; merging with itself doubles every count
+     * @return false if the sketch dimensions differ (nothing is merged)
+     */
+    bool merge(const VersionHistogram& other);
+
+    /**
+     * @brief Compact binary form; equal histograms serialize to equal bytes
+     */
+    std::vector<uint8_t> serialize() const;
+
+    /**
+     * @brief Replace this histogram with a serialized one
+     * @return false if the data is malformed (histogram unchanged)
+     */
+    bool deserialize(const uint8_t* data, size_t len);
+
+    uint64_t total() const;     // Valid versions counted
+    uint64_t sketched() const;  // Part of total() held in the sketch
+    uint64_t invalid() const;
+    size_t exactSize() const;   // Distinct versions counted exactly
+
+private:
+    struct Entry {
+        uint64_t count;
+        uint64_t hash;
+        bool prerelease;
+    };
+
+    typedef std::unordered_map<std::string, Entry> Map;
+
+    Map _exact;
+    std::vector<uint64_t> _sketch;  // _depth rows of _width counters
+    size_t _width;
+    size_t _depth;
+    size_t _exactLimit;
+    size_t _exactPrereleases;
+    uint64_t _threshold;            // Pre-releases with sampleHash < _threshold are exact
+    uint64_t _total;
+    uint64_t _sketched;
+    uint64_t _invalid;
+
+    void addKey(const std::string& key, uint64_t hash, bool prerelease, uint64_t count);
+    void addToSketch(uint64_t hash, uint64_t count);
+    void shrink();
+    static std::string keyOf(const SemVer& version);
+    static uint64_t hash(const std::string& key);
+    static uint64_t sampleHash(uint64_t hash);
+};
+
+#endif // SEMVER_HOST
+
+#endif
@@ -0,0 +1,92 @@
+#include "SemVerManifestSelector.h"
+
+ManifestSelector::ManifestSelector(const SemVer& current)
+    : _current(current), _target(NULL), _bestToken(0), _offered(0), _channelCount(0), _anyChannel(false) {
+}
+
+bool ManifestSelector::acceptChannel(const char* channel) {
+    if (!channel || _channelCount >= SEMVER_MAX_CHANNELS) return false;
+    _channels[_channelCount++] = channel;
+    return true;
+}
+
+void ManifestSelector::acceptAllChannels() {
+    _anyChannel = true;
+}
+
+void ManifestSelector::setTarget(const char* target) {
+    _target = target;
+}
+
+void ManifestSelector::setRange(const SemVer& requirement) {
+    _range = requirement;
+}
+
+bool ManifestSelector::offer(const char* version, const char* target, uint32_t token) {
+    _offered++;
+    // Cheap string checks first: most entries of a large manifest are for other targets
+    if (!version || !targetMatches(target)) return false;
+    return consider(SemVer(version), token);
+}
+
+bool ManifestSelector::offer(const SemVer& version, const char* target, uint32_t token) {
+    _offered++;
+    if (!targetMatches(target)) return false;
+    return consider(version, token);
+}
+
+bool ManifestSelector::consider(const SemVer& version, uint32_t token) {
+    if (!version.isValid()) return false;
+
+    // Running maximum: anything not above the current best cannot win
+    if (_best.isValid() && !(version > _best)) return false;
+    if (!(version > _current)) return false;
+    if (!channelAllowed(version)) return false;
+    // Channel policy already vetted pre-releases, so the range only checks compatibility
+    if (_range.isValid() && !version.satisfies(_range, true)) return false;
+
+    _best = version;
+    _bestToken = token;
+    return true;
+}
+
+bool ManifestSelector::hasSelection() const {
+    return _best.isValid();
+}
+
+const SemVer& ManifestSelector::selected() const {
+    return _best;
+}
+
+uint32_t ManifestSelector::selectedToken() const {
+    return _bestToken;
+}
+
+uint32_t ManifestSelector::offered() const {
+    return _offered;
+}
+
+void ManifestSelector::reset() {
+    _best = SemVer();
+    _bestToken = 0;
+    _offered = 0;
+}
+
+bool ManifestSelector::channelAllowed(const SemVer& version) const {
+    if (version.getPrerelease()[0] == '\0') return true;
+    if (_anyChannel) return true;
+    for (uint8_t i = 0; i < _channelCount; i++) {
+        if (version.isChannel(_channels[i])) return true;
+    }
+    return false;
+}
+
+bool ManifestSelector::targetMatches(const char* target) const {
+    if (!_target || !target) return true;
+    const char* a = _target;
+    while (*a && *a == *target) {
+        a++;
+        target++;
+    }
+    return *a == *target;
+}
@@ -0,0 +1,101 @@
+#ifndef SEMVER_MANIFEST_SELECTOR_H
+#define SEMVER_MANIFEST_SELECTOR_H
+
+#include "SemVerChecker.h"
+
+// Maximum number of pre-release channels a selector accepts
+// Can be configured via build flags: -DSEMVER_MAX_CHANNELS=8
+#ifndef SEMVER_MAX_CHANNELS
+#define SEMVER_MAX_CHANNELS 4
+#endif
+
+/**
+ * @brief Picks the best OTA artifact from a manifest in a single streaming pass
+ *
+ * Entries are offered one at a time as they are read from the network; only the
+ * current best candidate is kept, so memory use does not depend on manifest size.
+ * A candidate must be newer than the installed version, built for this hardware
+ * target, allowed by the channel policy and, if set, satisfy the caret range.
+ */
+class ManifestSelector {
+public:
+    /**
+     * @param current Installed version; only strictly newer entries are selected
+     */
+    explicit ManifestSelector(const SemVer& current);
+
+    /**
+     * @brief Accept pre-releases whose leading identifier matches (e.g. "beta", "rc")
+     * @param channel Channel name; must outlive the selector (string literal)
+     * @return false if SEMVER_MAX_CHANNELS channels are already accepted
+     */
+    bool acceptChannel(const char* channel);
+
+    /**
+     * @brief Accept pre-releases from any channel
+     */
+    void acceptAllChannels();
+
+    /**
+     * @brief Only select entries built for this hardware target
+     * @param target Target name; must outlive the selector. NULL accepts any target.
+     */
+    void setTarget(const char* target);
+
+    /**
+     * @brief Only select entries satisfying a caret range (see SemVer::satisfies)
+     */
+    void setRange(const SemVer& requirement);
+
+    /**
+     * @brief Consider one manifest entry
+     * @param version Entry version string
+     * @param target Hardware target of the entry (NULL = universal)
+     * @param token Caller-defined handle for the artifact (index, offset, ...)
+     * @return true if the entry became the new best candidate
+     */
+    bool offer(const char* version, const char* target = NULL, uint32_t token = 0);
+    bool offer(const SemVer& version, const char* target = NULL, uint32_t token = 0);
+
+    /**
+     * @brief Whether any entry qualified so far
+     */
+    bool hasSelection() const;
+
+    /**
+     * @brief Best version seen so far (invalid if none qualified)
+     */
+    const SemVer& selected() const;
+
+    /**
+     * @brief Token passed with the best entry
+     */
+    uint32_t selectedToken() const;
+
+    /**
+     * @brief Number of entries offered (including rejected ones)
+     */
+    uint32_t offered() const;
+
+    /**
+     * @brief Forget the current selection and start a new pass
+     */
+    void reset();
+
+private:
+    SemVer _current;
+    SemVer _range;
+    SemVer _best;
+    const char* _channels[SEMVER_MAX_CHANNELS];
+    const char* _target;
+    uint32_t _bestToken;
+    uint32_t _offered;
+    uint8_t _channelCount;
+    bool _anyChannel;
+
+    bool consider(const SemVer& version, uint32_t token);
+    bool channelAllowed(const SemVer& version) const;
+    bool targetMatches(const char* target) const;
+};
+
+#endif
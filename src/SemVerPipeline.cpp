@@ -0,0 +1,215 @@
+#include "SemVerPipeline.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+const size_t STREAM_BYTES_PER_LINE = 32; // Read size per batch from a stream, per record
+
+} // namespace
+
+// Fills batches with whole lines from memory or from a stream
+class IngestPipeline::Source {
+public:
+    Source(const char* data, size_t len, size_t batchSize)
+        : _file(NULL), _pos(data), _end(data + len), _batchSize(batchSize) {}
+
+    Source(FILE* file, size_t batchSize) : _file(file), _pos(NULL), _end(NULL), _batchSize(batchSize) {}
+
+    // Returns false once the input is exhausted. A stream batch may hold no
+    // lines (a read of blank lines only); the caller skips it and asks again.
+    bool fill(Batch& batch) {
+        batch.lines.clear();
+        if (_file) {
+            batch.storage.swap(_carry);
+            _carry.clear();
+            bool progress = !batch.storage.empty();
+            size_t want = _batchSize * STREAM_BYTES_PER_LINE;
+            for (;;) {
+                size_t used = batch.storage.size();
+                batch.storage.resize(used + want);
+                size_t n = fread(&batch.storage[used], 1, want, _file);
+                batch.storage.resize(used + n);
+                progress = progress || n > 0;
+                if (n < want) break; // End of input: the last line is complete
+                // Keep the partial last line for the next batch; with no newline
+                // at all the line continues, so read on rather than cut it
+                size_t nl = batch.storage.find_last_of('\n');
+                if (nl == std::string::npos) continue;
+                _carry.assign(batch.storage, nl + 1, std::string::npos);
+                batch.storage.resize(nl + 1);
+                break;
+            }
+            split(batch.storage.data(), batch.storage.data() + batch.storage.size(), batch, (size_t)-1);
+            return progress;
+        }
+        _pos = split(_pos, _end, batch, _batchSize);
+        return !batch.lines.empty();
+    }
+
+private:
+    FILE* _file;
+    const char* _pos;
+    const char* _end;
+    size_t _batchSize;
+    std::string _carry;
+
+    static const char* split(const char* p, const char* end, Batch& batch, size_t maxLines) {
+        while (p < end && batch.lines.size() < maxLines) {
+            const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+            const char* stop = nl ? nl : end;
+            size_t len = (size_t)(stop - p);
+            if (len && p[len - 1] == '\r') len--;
+            if (len) {
+                Line line = { p, (uint32_t)len };
+                batch.lines.push_back(line);
+            }
+            p = nl ? nl + 1 : end;
+        }
+        return p;
+    }
+};
+
+IngestPipeline::IngestPipeline(const SemVer& latest, unsigned parseThreads, size_t batchSize, size_t queueDepth)
+    : _latest(latest), _parseThreads(parseThreads), _batchSize(batchSize ? batchSize : 1),
+      _queueDepth(queueDepth ? queueDepth : 1) {
+    if (_parseThreads == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        _parseThreads = hw > 4 ? hw - 3 : 1;
+    }
+}
+
+IngestPipeline::Report IngestPipeline::run(const char* data, size_t len) {
+    Source source(data, len, _batchSize);
+    return execute(source);
+}
+
+IngestPipeline::Report IngestPipeline::run(FILE* file) {
+    Source source(file, _batchSize);
+    return execute(source);
+}
+
+IngestPipeline::Outcome IngestPipeline::classify(const SemVer& device, const SemVer& latest) {
+    if (!device.isValid()) return INVALID;
+    if (latest < device) return AHEAD;
+    switch (device.diff(latest)) {
+        case SemVer::MAJOR: return BEHIND_MAJOR;
+        case SemVer::MINOR: return BEHIND_MINOR;
+        case SemVer::PATCH: return BEHIND_PATCH;
+        case SemVer::PRERELEASE: return BEHIND_PRERELEASE;
+        default: return CURRENT;
+    }
+}
+
+SemVer IngestPipeline::parseRecord(const char* line, size_t len) {
+    size_t start = len;
+    while (start > 0 && line[start - 1] != ' ') start--;
+    size_t n = len - start;
+    if (n == 0 || n > SemVer::MAX_VERSION_LEN) return SemVer();
+    char text[SemVer::MAX_VERSION_LEN + 1];
+    memcpy(text, line + start, n);
+    text[n] = '\0';
+    return SemVer(text);
+}
+
+unsigned IngestPipeline::parseThreads() const {
+    return _parseThreads;
+}
+
+IngestPipeline::Report IngestPipeline::execute(Source& source) {
+    const unsigned workers = _parseThreads;
+    const size_t poolSize = _queueDepth * (2 * workers + 2);
+
+    std::vector<SpscQueue<Batch*>*> toParse, toClassify;
+    for (unsigned i = 0; i < workers; i++) {
+        toParse.push_back(new SpscQueue<Batch*>(_queueDepth));
+        toClassify.push_back(new SpscQueue<Batch*>(_queueDepth));
+    }
+    SpscQueue<Batch*> toAggregate(_queueDepth);
+    SpscQueue<Batch*> recycled(poolSize); // Never full: holds every batch at most once
+    std::vector<Batch*> pool;
+    std::atomic<uint64_t> stalls(0);
+
+    Report report;
+    memset(&report, 0, sizeof(report));
+
+    // A NULL batch marks the end of the stream on every queue
+    std::vector<std::thread> threads;
+    for (unsigned w = 0; w < workers; w++) {
+        threads.push_back(std::thread([&, w]() {
+            uint64_t waited = 0;
+            while (Batch* batch = toParse[w]->pop()) {
+                if (batch->versions.size() < batch->lines.size()) batch->versions.resize(batch->lines.size());
+                for (size_t i = 0; i < batch->lines.size(); i++) {
+                    batch->versions[i] = parseRecord(batch->lines[i].text, batch->lines[i].len);
+                }
+                waited += toClassify[w]->push(batch);
+            }
+            toClassify[w]->push(NULL);
+            stalls += waited;
+        }));
+    }
+    threads.push_back(std::thread([&]() {
+        uint64_t waited = 0;
+        for (size_t seq = 0;; seq++) {
+            Batch* batch = toClassify[seq % workers]->pop();
+            if (!batch) break;
+            batch->outcomes.resize(batch->lines.size());
+            for (size_t i = 0; i < batch->lines.size(); i++) {
+                batch->outcomes[i] = (uint8_t)classify(batch->versions[i], _latest);
+            }
+            waited += toAggregate.push(batch);
+        }
+        toAggregate.push(NULL);
+        stalls += waited;
+    }));
+    threads.push_back(std::thread([&]() {
+        while (Batch* batch = toAggregate.pop()) {
+            for (size_t i = 0; i < batch->outcomes.size(); i++) report.outcomes[batch->outcomes[i]]++;
+            report.records += batch->outcomes.size();
+            report.batches++;
+            recycled.push(batch);
+        }
+    }));
+
+    // Read stage on the calling thread. Only the aggregator pushes to 'recycled',
+    // so a batch that ends up empty is kept aside here instead of returned.
+    uint64_t waited = 0;
+    Batch* spare = NULL;
+    for (size_t seq = 0;;) {
+        Batch* batch = spare;
+        spare = NULL;
+        if (!batch && !recycled.tryPop(batch)) {
+            if (pool.size() < poolSize) {
+                batch = new Batch();
+                pool.push_back(batch);
+            } else {
+                batch = recycled.pop();
+                waited++;
+            }
+        }
+        if (!source.fill(*batch)) break;
+        if (batch->lines.empty()) {
+            spare = batch;
+            continue;
+        }
+        waited += toParse[seq++ % workers]->push(batch);
+    }
+    for (unsigned w = 0; w < workers; w++) toParse[w]->push(NULL);
+    stalls += waited;
+
+    for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+    report.stalls = stalls.load();
+
+    for (size_t i = 0; i < pool.size(); i++) delete pool[i];
+    for (unsigned i = 0; i < workers; i++) {
+        delete toParse[i];
+        delete toClassify[i];
+    }
+    return report;
+}
+
+#endif // SEMVER_HOST
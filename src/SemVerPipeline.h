@@ -0,0 +1,203 @@
+#ifndef SEMVER_PIPELINE_H
+#define SEMVER_PIPELINE_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <atomic>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer and one consumer thread
+ *
+ * A ring of slots indexed by two counters, each written by one side only. Each
+ * side caches the other side's counter and rereads it only when the ring looks
+ * full (producer) or empty (consumer), so most operations touch no shared
+ * cache line.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    /**
+     * @param capacity Slots; rounded up to a power of two
+     */
+    explicit SpscQueue(size_t capacity) : _mask(1) {
+        while (_mask < capacity) _mask <<= 1;
+        _slots.resize(_mask);
+        _mask--;
+        _producer.index.store(0, std::memory_order_relaxed);
+        _producer.cached = 0;
+        _consumer.index.store(0, std::memory_order_relaxed);
+        _consumer.cached = 0;
+    }
+
+    /**
+     * @brief Producer side: append unless the queue is full
+     */
+    bool tryPush(const T& value) {
+        size_t tail = _producer.index.load(std::memory_order_relaxed);
+        if (tail - _producer.cached > _mask) {
+            _producer.cached = _consumer.index.load(std::memory_order_acquire);
+            if (tail - _producer.cached > _mask) return false;
+        }
+        _slots[tail & _mask] = value;
+        _producer.index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Producer side: append, yielding while the queue is full
+     * @return true if the call had to wait (the consumer is the bottleneck)
+     */
+    bool push(const T& value) {
+        if (tryPush(value)) return false;
+        while (!tryPush(value)) std::this_thread::yield();
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: take the oldest value unless the queue is empty
+     */
+    bool tryPop(T& value) {
+        size_t head = _consumer.index.load(std::memory_order_relaxed);
+        if (head == _consumer.cached) {
+            _consumer.cached = _producer.index.load(std::memory_order_acquire);
+            if (head == _consumer.cached) return false;
+        }
+        value = _slots[head & _mask];
+        _consumer.index.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: take the oldest value, yielding while the queue is empty
+     */
+    T pop() {
+        T value;
+        while (!tryPop(value)) std::this_thread::yield();
+        return value;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    // C++11 'new' ignores extended alignment, so heap queues allocate their own
+    static void* operator new(size_t size) {
+        void* p = NULL;
+        if (posix_memalign(&p, 64, size) != 0) throw std::bad_alloc();
+        return p;
+    }
+    static void operator delete(void* p) { free(p); }
+
+private:
+    // Own index plus a cached copy of the other side's, on a separate cache line per side
+    struct alignas(64) Side {
+        std::atomic<size_t> index;
+        size_t cached;
+    };
+
+    Side _producer;
+    Side _consumer;
+    std::vector<T> _slots;
+    size_t _mask;
+
+    SpscQueue(const SpscQueue&);
+    SpscQueue& operator=(const SpscQueue&);
+};
+
+/**
+ * @brief Multi-threaded check-in ingestion: read -> parse -> classify -> aggregate
+ *
+ * Each stage runs on its own thread(s) and hands batches of records to the next
+ * through SpscQueues. The parse stage has several workers; the reader deals
+ * batches to them round-robin and the classifier collects them in the same
+ * order, so every queue keeps one producer and one consumer. Batches are
+ * recycled from the aggregator back to the reader, so at most a fixed number
+ * are in flight: when a later stage falls behind, earlier stages wait on full
+ * queues instead of buffering (backpressure).
+ *
+ * A record is one line; the version is its last space-separated field, so both
+ * "1.2.3" and "device-42 1.2.3" are accepted. Empty lines are skipped.
+ */
+class IngestPipeline {
+public:
+    enum Outcome {
+        CURRENT,            // Same precedence as the latest release
+        BEHIND_MAJOR,       // Older, by diff() against the latest release
+        BEHIND_MINOR,
+        BEHIND_PATCH,
+        BEHIND_PRERELEASE,
+        AHEAD,              // Newer than the latest release
+        INVALID,
+        OUTCOME_COUNT
+    };
+
+    struct Report {
+        uint64_t records;
+        uint64_t outcomes[OUTCOME_COUNT];
+        uint64_t batches;
+        uint64_t stalls;    // Times a stage waited on a full queue
+    };
+
+    /**
+     * @param latest Release the fleet is compared against
+     * @param parseThreads Parse workers (0 = hardware threads minus the three other stages, at least 1)
+     * @param batchSize Records per batch
+     * @param queueDepth Batches each queue holds
+     */
+    IngestPipeline(const SemVer& latest, unsigned parseThreads = 0, size_t batchSize = 1024, size_t queueDepth = 8);
+
+    /**
+     * @brief Ingest newline-separated records from memory (e.g. a mapped file)
+     */
+    Report run(const char* data, size_t len);
+
+    /**
+     * @brief Ingest newline-separated records from a stream until EOF
+     */
+    Report run(FILE* file);
+
+    /**
+     * @brief Classification used by the classify stage, for serial callers
+     */
+    static Outcome classify(const SemVer& device, const SemVer& latest);
+
+    /**
+     * @brief Version field of a record line (see class description)
+     */
+    static SemVer parseRecord(const char* line, size_t len);
+
+    unsigned parseThreads() const;
+
+private:
+    struct Line {
+        const char* text;
+        uint32_t len;
+    };
+
+    struct Batch {
+        std::string storage;         // Whole lines copied from a stream
+        std::vector<Line> lines;
+        std::vector<SemVer> versions;
+        std::vector<uint8_t> outcomes;
+    };
+
+    class Source;
+
+    SemVer _latest;
+    unsigned _parseThreads;
+    size_t _batchSize;
+    size_t _queueDepth;
+
+    Report execute(Source& source);
+};
+
+#endif // SEMVER_HOST
+
+#endif
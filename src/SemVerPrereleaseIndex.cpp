@@ -0,0 +1,177 @@
+#include "SemVerPrereleaseIndex.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+#include <string.h>
+#include <unordered_map>
+
+namespace {
+
+// A core is the release itself, so it lies above the pre-releases of a bound with the same numbers
+template <typename Core>
+int compareCore(const Core& c, const SemVer& bound) {
+    if (c.major != bound.major) return c.major < bound.major ? -1 : 1;
+    if (c.minor != bound.minor) return c.minor < bound.minor ? -1 : 1;
+    if (c.patch != bound.patch) return c.patch < bound.patch ? -1 : 1;
+    return bound.getPrerelease()[0] != '\0' ? 1 : 0;
+}
+
+} // namespace
+
+PrereleaseIndex::PrereleaseIndex() : _nodes(1) {}
+
+bool PrereleaseIndex::add(const SemVer& version) {
+    if (!version.isValid() || version.getPrerelease()[0] == '\0') return false;
+    _versions.push_back(version);
+    return true;
+}
+
+bool PrereleaseIndex::add(const char* version) {
+    return add(SemVer(version));
+}
+
+void PrereleaseIndex::build() {
+    std::stable_sort(_versions.begin(), _versions.end());
+    _cores.resize(_versions.size());
+    _nodes.assign(1, Node());
+
+    // Insert along each path; positions arrive in ascending order
+    std::vector<std::unordered_map<std::string, uint32_t> > lookup(1);
+    for (uint32_t i = 0; i < _versions.size(); i++) {
+        const SemVer& v = _versions[i];
+        Core core = { v.major, v.minor, v.patch };
+        _cores[i] = core;
+
+        uint32_t node = 0;
+        _nodes[0].positions.push_back(i);
+        const char* p = v.getPrerelease();
+        while (*p) {
+            const char* dot = strchr(p, '.');
+            std::string id(p, dot ? (size_t)(dot - p) : strlen(p));
+            std::unordered_map<std::string, uint32_t>::iterator it = lookup[node].find(id);
+            if (it == lookup[node].end()) {
+                uint32_t created = (uint32_t)_nodes.size();
+                _nodes.push_back(Node());
+                _nodes.back().identifier = id;
+                lookup.push_back(std::unordered_map<std::string, uint32_t>());
+                _nodes[node].children.push_back(created);
+                it = lookup[node].insert(std::make_pair(id, created)).first;
+            }
+            node = it->second;
+            _nodes[node].positions.push_back(i);
+            p = dot ? dot + 1 : p + id.size();
+        }
+    }
+
+    for (size_t n = 0; n < _nodes.size(); n++) {
+        std::vector<uint32_t>& children = _nodes[n].children;
+        std::sort(children.begin(), children.end(), [this](uint32_t a, uint32_t b) {
+            const std::string& x = _nodes[a].identifier;
+            const std::string& y = _nodes[b].identifier;
+            return SemVer::compareIdentifier(x.data(), x.size(), y.data(), y.size()) < 0;
+        });
+    }
+}
+
+size_t PrereleaseIndex::find(const char* prefix, std::vector<uint32_t>& out) const {
+    return find(prefix, VersionRange(), out);
+}
+
+size_t PrereleaseIndex::find(const char* prefix, const VersionRange& core, std::vector<uint32_t>& out) const {
+    int32_t node = lookup(prefix);
+    if (node < 0) return 0;
+    return appendSlice(_nodes[node], lowerCore(core), upperCore(core), out);
+}
+
+size_t PrereleaseIndex::findFrom(const char* prefix, const char* from, const VersionRange& core,
+                                 std::vector<uint32_t>& out) const {
+    int32_t node = lookup(prefix);
+    if (node < 0 || !from) return 0;
+    const std::vector<uint32_t>& children = _nodes[node].children;
+    size_t fromLen = strlen(from);
+    std::vector<uint32_t>::const_iterator it = std::partition_point(children.begin(), children.end(),
+        [this, from, fromLen](uint32_t c) {
+            const std::string& id = _nodes[c].identifier;
+            return SemVer::compareIdentifier(id.data(), id.size(), from, fromLen) < 0;
+        });
+
+    // Children hold disjoint positions; one sort restores precedence order
+    uint32_t first = lowerCore(core), last = upperCore(core);
+    size_t before = out.size();
+    for (; it != children.end(); ++it) appendSlice(_nodes[*it], first, last, out);
+    std::sort(out.begin() + before, out.end());
+    return out.size() - before;
+}
+
+void PrereleaseIndex::nextIdentifiers(const char* prefix, std::vector<std::string>& out) const {
+    int32_t node = lookup(prefix);
+    if (node < 0) return;
+    const std::vector<uint32_t>& children = _nodes[node].children;
+    for (size_t i = 0; i < children.size(); i++) out.push_back(_nodes[children[i]].identifier);
+}
+
+const SemVer& PrereleaseIndex::at(uint32_t position) const {
+    return _versions[position];
+}
+
+size_t PrereleaseIndex::size() const {
+    return _versions.size();
+}
+
+int32_t PrereleaseIndex::child(uint32_t node, const char* identifier, size_t len) const {
+    const std::vector<uint32_t>& children = _nodes[node].children;
+    size_t lo = 0, hi = children.size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        const std::string& id = _nodes[children[mid]].identifier;
+        int c = SemVer::compareIdentifier(id.data(), id.size(), identifier, len);
+        if (c == 0) return (int32_t)children[mid];
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return -1;
+}
+
+int32_t PrereleaseIndex::lookup(const char* prefix) const {
+    if (!prefix) return -1;
+    int32_t node = 0;
+    const char* p = prefix;
+    while (*p && node >= 0) {
+        const char* dot = strchr(p, '.');
+        size_t len = dot ? (size_t)(dot - p) : strlen(p);
+        if (len == 0) return -1;
+        node = child((uint32_t)node, p, len);
+        p += len + (dot ? 1 : 0);
+        if (dot && !*p) return -1; // Trailing dot
+    }
+    return node;
+}
+
+// First position whose core is not below the range
+uint32_t PrereleaseIndex::lowerCore(const VersionRange& core) const {
+    if (!core.low.isValid()) return 0;
+    return (uint32_t)(std::partition_point(_cores.begin(), _cores.end(), [&core](const Core& c) {
+        int cmp = compareCore(c, core.low);
+        return cmp < 0 || (cmp == 0 && !core.lowInclusive);
+    }) - _cores.begin());
+}
+
+// First position whose core is above the range
+uint32_t PrereleaseIndex::upperCore(const VersionRange& core) const {
+    if (!core.high.isValid()) return (uint32_t)_cores.size();
+    return (uint32_t)(std::partition_point(_cores.begin(), _cores.end(), [&core](const Core& c) {
+        int cmp = compareCore(c, core.high);
+        return cmp < 0 || (cmp == 0 && core.highInclusive);
+    }) - _cores.begin());
+}
+
+size_t PrereleaseIndex::appendSlice(const Node& node, uint32_t first, uint32_t last, std::vector<uint32_t>& out) const {
+    if (first >= last) return 0;
+    std::vector<uint32_t>::const_iterator begin = std::lower_bound(node.positions.begin(), node.positions.end(), first);
+    std::vector<uint32_t>::const_iterator end = std::lower_bound(begin, node.positions.end(), last);
+    out.insert(out.end(), begin, end);
+    return (size_t)(end - begin);
+}
+
+#endif // SEMVER_HOST
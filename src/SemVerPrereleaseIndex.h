@@ -0,0 +1,96 @@
+#ifndef SEMVER_PRERELEASE_INDEX_H
+#define SEMVER_PRERELEASE_INDEX_H
+
+#include "SemVerRange.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Finds pre-releases by leading identifiers ("rc", "beta", "nightly.20260901")
+ *
+ * build() sorts the versions by precedence and arranges their dot-separated
+ * pre-release identifiers in a trie whose children are in precedence order
+ * (numeric identifiers by value, below alphanumeric ones, which compare by
+ * ASCII). Each node lists the positions of the versions below it in ascending
+ * order, which is precedence order, and versions with the same core
+ * (major.minor.patch) are adjacent. A query therefore walks one path and
+ * returns a slice of one list, already sorted, without looking at versions
+ * that do not match.
+ *
+ * Prefixes match whole identifiers: "rc" matches 2.0.0-rc.1 and 2.0.0-rc,
+ * but not 2.0.0-rc1. Core filters apply to major.minor.patch only, so
+ * "^2.0.0" selects the pre-releases of every 2.x release, 2.0.0-rc.1 included.
+ */
+class PrereleaseIndex {
+public:
+    PrereleaseIndex();
+
+    /**
+     * @brief Add a version; only valid before build()
+     * @return false if the version is invalid or not a pre-release (not indexed)
+     */
+    bool add(const SemVer& version);
+    bool add(const char* version);
+
+    /**
+     * @brief Sort and index everything added; required before queries
+     */
+    void build();
+
+    /**
+     * @brief Append the positions (see at()) of versions whose pre-release starts with a prefix
+     * @param prefix Dot-separated identifiers; "" matches every version
+     * @param core Range of major.minor.patch to keep
+     * @return Number of positions appended, in precedence order
+     */
+    size_t find(const char* prefix, std::vector<uint32_t>& out) const;
+    size_t find(const char* prefix, const VersionRange& core, std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief As find(), but only where the identifier after the prefix is at least 'from'
+     *
+     * For example ("nightly", "20260901") returns every nightly since 2026-09-01.
+     */
+    size_t findFrom(const char* prefix, const char* from, const VersionRange& core, std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief Append the distinct identifiers that follow a prefix, in precedence order
+     *
+     * With "" these are the channels, e.g. "alpha", "beta", "rc".
+     */
+    void nextIdentifiers(const char* prefix, std::vector<std::string>& out) const;
+
+    const SemVer& at(uint32_t position) const; // Versions in precedence order
+    size_t size() const;
+
+private:
+    struct Core {
+        uint32_t major;
+        uint32_t minor;
+        uint32_t patch;
+    };
+
+    struct Node {
+        std::string identifier;
+        std::vector<uint32_t> children;   // Node indices, in identifier order
+        std::vector<uint32_t> positions;  // Ascending
+    };
+
+    std::vector<SemVer> _versions;        // Precedence order after build()
+    std::vector<Core> _cores;             // Per position
+    std::vector<Node> _nodes;             // _nodes[0] is the root
+
+    int32_t child(uint32_t node, const char* identifier, size_t len) const;
+    int32_t lookup(const char* prefix) const;
+    uint32_t lowerCore(const VersionRange& core) const;
+    uint32_t upperCore(const VersionRange& core) const;
+    size_t appendSlice(const Node& node, uint32_t first, uint32_t last, std::vector<uint32_t>& out) const;
+};
+
+#endif // SEMVER_HOST
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef SEMVER_PUBLISHED_H
+#define SEMVER_PUBLISHED_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+// Number of reader counter stripes per holder. Threads are spread over the
+// stripes so concurrent readers rarely touch the same cache line.
+#ifndef SEMVER_RCU_STRIPES
+#define SEMVER_RCU_STRIPES 32
+#endif
+
+/**
+ * @brief Read-mostly value swapped atomically on publish (RCU style)
+ *
+ * Readers open a Snapshot: the current value is one atomic pointer load, with
+ * no lock, and stays valid until the Snapshot is destroyed even if a new value
+ * is published meanwhile. publish() swaps in a new copy, then waits for a grace
+ * period (every reader that could still see the old copy has left) and frees
+ * it. Readers are tracked by per-stripe counters for two alternating epochs.
+ *
+ * Readers never wait. Publishers are serialized and wait for the grace period,
+ * so snapshots should be short-lived, and a thread must not publish while it
+ * holds a Snapshot of the same holder.
+ */
+template <typename T>
+class Published {
+public:
+    /**
+     * @brief Read-side critical section pinning the current value
+     */
+    class Snapshot {
+    public:
+        explicit Snapshot(const Published& owner) : _counter(owner.enter()) {
+            _value = owner._current.load(std::memory_order_seq_cst);
+        }
+        ~Snapshot() { _counter->fetch_sub(1, std::memory_order_release); }
+
+        const T& operator*() const { return *_value; }
+        const T* operator->() const { return _value; }
+        const T* get() const { return _value; }
+
+    private:
+        std::atomic<uint32_t>* _counter;
+        const T* _value;
+
+        Snapshot(const Snapshot&);
+        Snapshot& operator=(const Snapshot&);
+    };
+
+    explicit Published(const T& initial = T()) : _current(new T(initial)), _epoch(0) {
+        for (int i = 0; i < SEMVER_RCU_STRIPES; i++) {
+            _stripes[i].readers[0].store(0, std::memory_order_relaxed);
+            _stripes[i].readers[1].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Destroys the current value; no Snapshot may outlive the holder
+     */
+    ~Published() { delete _current.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Replace the value; returns once the previous copy has been freed
+     */
+    void publish(const T& value) {
+        T* fresh = new T(value);
+        std::lock_guard<std::mutex> guard(_publishLock);
+        T* old = _current.exchange(fresh, std::memory_order_seq_cst);
+        // A reader may have read the epoch just before a flip, so both epochs
+        // must drain once after the swap before the old copy is unreachable
+        flipAndDrain();
+        flipAndDrain();
+        delete old;
+    }
+
+    /**
+     * @brief Copy of the current value
+     */
+    T load() const {
+        Snapshot s(*this);
+        return *s;
+    }
+
+    // C++11 'new' ignores extended alignment, so heap holders allocate their own
+    static void* operator new(size_t size) {
+        void* p = NULL;
+        if (posix_memalign(&p, 64, size) != 0) throw std::bad_alloc();
+        return p;
+    }
+    static void operator delete(void* p) { free(p); }
+
+private:
+    // One cache line per stripe
+    struct alignas(64) Stripe {
+        std::atomic<uint32_t> readers[2];
+    };
+
+    std::atomic<T*> _current;
+    std::atomic<uint32_t> _epoch;
+    mutable Stripe _stripes[SEMVER_RCU_STRIPES];
+    std::mutex _publishLock;
+
+    static uint32_t stripeIndex() {
+        static std::atomic<uint32_t> nextThread(0);
+        static thread_local uint32_t index = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return index % SEMVER_RCU_STRIPES;
+    }
+
+    std::atomic<uint32_t>* enter() const {
+        Stripe& stripe = _stripes[stripeIndex()];
+        std::atomic<uint32_t>* counter = &stripe.readers[_epoch.load(std::memory_order_seq_cst) & 1];
+        counter->fetch_add(1, std::memory_order_seq_cst);
+        return counter;
+    }
+
+    void flipAndDrain() {
+        uint32_t old = _epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+        for (int i = 0; i < SEMVER_RCU_STRIPES; i++) {
+            while (_stripes[i].readers[old].load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+        }
+    }
+
+    Published(const Published&);
+    Published& operator=(const Published&);
+};
+
+typedef Published<SemVer> PublishedVersion;
+typedef Published<std::vector<SemVer> > PublishedCatalog;
+
+#endif // SEMVER_HOST
+
+#endif
@@ -0,0 +1,289 @@
+#include "SemVerRange.h"
+
+#ifdef SEMVER_HOST
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+const uint32_t MAX_NUMBER = 0xFFFFFFFFu;
+
+int compare(const SemVer& a, const SemVer& b) {
+    if (a < b) return -1;
+    if (b < a) return 1;
+    return 0;
+}
+
+// Lowest version of the next major/minor/patch: "<M+1.0.0-0" excludes its pre-releases too
+SemVer firstAbove(uint32_t major, uint32_t minor, uint32_t patch) {
+    char text[40];
+    snprintf(text, sizeof(text), "%u.%u.%u-0", (unsigned)major, (unsigned)minor, (unsigned)patch);
+    return SemVer(text);
+}
+
+SemVer release(uint32_t major, uint32_t minor, uint32_t patch) {
+    char text[40];
+    snprintf(text, sizeof(text), "%u.%u.%u", (unsigned)major, (unsigned)minor, (unsigned)patch);
+    return SemVer(text);
+}
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+// Splits one alternative into whitespace-separated tokens
+struct Tokenizer {
+    const char* p;
+    const char* end;
+    char token[SemVer::MAX_VERSION_LEN + 3];
+
+    bool next(bool& overflow) {
+        overflow = false;
+        while (p < end && isSpace(*p)) p++;
+        if (p == end) return false;
+        size_t n = 0;
+        while (p < end && !isSpace(*p)) {
+            if (n + 1 >= sizeof(token)) { overflow = true; return false; }
+            token[n++] = *p++;
+        }
+        token[n] = '\0';
+        return true;
+    }
+};
+
+bool isOperatorOnly(const char* t) {
+    return strcmp(t, ">") == 0 || strcmp(t, ">=") == 0 || strcmp(t, "<") == 0 ||
+           strcmp(t, "<=") == 0 || strcmp(t, "=") == 0 || strcmp(t, "^") == 0 || strcmp(t, "~") == 0;
+}
+
+// Range for a single comparator such as ">=1.2.3" or "^2.0.0"
+bool comparatorRange(const char* op, size_t opLen, const char* text, VersionRange& r) {
+    r = VersionRange();
+    if (opLen == 0 && strcmp(text, "*") == 0) return true;
+
+    SemVer v(text);
+    if (!v.isValid()) return false;
+
+    if (opLen == 0 || (opLen == 1 && op[0] == '=')) {
+        r.low = v;
+        r.high = v;
+    } else if (opLen == 1 && op[0] == '>') {
+        r.low = v;
+        r.lowInclusive = false;
+    } else if (opLen == 2 && op[0] == '>') {
+        r.low = v;
+    } else if (opLen == 1 && op[0] == '<') {
+        r.high = v;
+        r.highInclusive = false;
+    } else if (opLen == 2 && op[0] == '<') {
+        r.high = v;
+    } else if (op[0] == '^') {
+        r = VersionRange::caret(v);
+    } else if (op[0] == '~') {
+        r.low = v;
+        r.highInclusive = false;
+        if (v.minor != MAX_NUMBER) r.high = firstAbove(v.major, v.minor + 1, 0);
+        else if (v.major != MAX_NUMBER) r.high = firstAbove(v.major + 1, 0, 0);
+        // No representable successor: leave the range open above
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseComparator(const char* token, VersionRange& r) {
+    size_t opLen = 0;
+    while (token[opLen] && strchr("<>=^~", token[opLen])) opLen++;
+    if (opLen == 2 && !(token[1] == '=' && (token[0] == '<' || token[0] == '>'))) return false;
+    if (opLen > 2) return false;
+    return comparatorRange(token, opLen, token + opLen, r);
+}
+
+bool parseAlternative(const char* begin, const char* end, VersionRange& out) {
+    Tokenizer tok = { begin, end, { 0 } };
+    VersionRange acc; // An alternative without comparators matches any version
+    bool overflow = false;
+
+    while (tok.next(overflow)) {
+        char first[sizeof(tok.token)];
+        strcpy(first, tok.token);
+
+        // An operator may be separated from its version by spaces (">= 1.2.3")
+        if (isOperatorOnly(first)) {
+            if (!tok.next(overflow)) return false;
+            if (strlen(first) + strlen(tok.token) >= sizeof(first)) return false;
+            strcat(first, tok.token);
+        }
+
+        VersionRange r;
+        if (!parseComparator(first, r)) return false;
+
+        // Hyphen range "A - B" is inclusive on both ends
+        const char* save = tok.p;
+        if (first[0] != '*' && !strchr("<>=^~", first[0]) && tok.next(overflow) && strcmp(tok.token, "-") == 0) {
+            if (!tok.next(overflow)) return false;
+            SemVer high(tok.token);
+            if (!high.isValid()) return false;
+            r.high = high;
+        } else {
+            if (overflow) return false;
+            tok.p = save;
+        }
+
+        acc = acc.intersect(r);
+    }
+    if (overflow) return false;
+
+    out = acc;
+    return true;
+}
+
+} // namespace
+
+VersionRange::VersionRange() : lowInclusive(true), highInclusive(true) {}
+
+VersionRange VersionRange::caret(const SemVer& version) {
+    VersionRange r;
+    r.low = version;
+    r.highInclusive = false;
+    if (version.major == 0 && version.minor > 0) {
+        if (version.minor != MAX_NUMBER) r.high = firstAbove(0, version.minor + 1, 0);
+        else r.high = firstAbove(1, 0, 0);
+    } else if (version.major == 0) {
+        if (version.patch != MAX_NUMBER) r.high = firstAbove(0, 0, version.patch + 1);
+        else r.high = firstAbove(0, 1, 0);
+    } else if (version.major != MAX_NUMBER) {
+        r.high = firstAbove(version.major + 1, 0, 0);
+    }
+    // No representable successor: leave the range open above
+    return r;
+}
+
+VersionRange VersionRange::none() {
+    VersionRange r;
+    r.low = SemVer("0.0.0");
+    r.high = r.low;
+    r.highInclusive = false;
+    return r;
+}
+
+int VersionRange::compareLow(const VersionRange& a, const VersionRange& b) {
+    bool openA = !a.low.isValid(), openB = !b.low.isValid();
+    if (openA || openB) return openA == openB ? 0 : (openA ? -1 : 1);
+    int c = compare(a.low, b.low);
+    if (c != 0) return c;
+    if (a.lowInclusive == b.lowInclusive) return 0;
+    return a.lowInclusive ? -1 : 1;
+}
+
+int VersionRange::compareHigh(const VersionRange& a, const VersionRange& b) {
+    bool openA = !a.high.isValid(), openB = !b.high.isValid();
+    if (openA || openB) return openA == openB ? 0 : (openA ? 1 : -1);
+    int c = compare(a.high, b.high);
+    if (c != 0) return c;
+    if (a.highInclusive == b.highInclusive) return 0;
+    return a.highInclusive ? 1 : -1;
+}
+
+bool VersionRange::before(const VersionRange& a, const VersionRange& b) {
+    if (!a.high.isValid() || !b.low.isValid()) return false;
+    int c = compare(a.high, b.low);
+    if (c != 0) return c < 0;
+    return !(a.highInclusive && b.lowInclusive);
+}
+
+bool VersionRange::contains(const SemVer& version) const {
+    if (!version.isValid()) return false;
+    if (low.isValid()) {
+        int c = compare(low, version);
+        if (c > 0 || (c == 0 && !lowInclusive)) return false;
+    }
+    if (high.isValid()) {
+        int c = compare(version, high);
+        if (c > 0 || (c == 0 && !highInclusive)) return false;
+    }
+    return true;
+}
+
+bool VersionRange::empty() const {
+    return before(*this, *this);
+}
+
+VersionRange VersionRange::intersect(const VersionRange& other) const {
+    VersionRange r;
+    const VersionRange& lo = compareLow(*this, other) >= 0 ? *this : other;
+    const VersionRange& hi = compareHigh(*this, other) <= 0 ? *this : other;
+    r.low = lo.low;
+    r.lowInclusive = lo.lowInclusive;
+    r.high = hi.high;
+    r.highInclusive = hi.highInclusive;
+    return r;
+}
+
+bool VersionRange::parse(const char* expression, std::vector<VersionRange>& out) {
+    if (!expression) return false;
+
+    std::vector<VersionRange> ranges;
+    const char* p = expression;
+    for (;;) {
+        const char* bar = strstr(p, "||");
+        const char* end = bar ? bar : p + strlen(p);
+        VersionRange r;
+        if (!parseAlternative(p, end, r)) return false;
+        if (!r.empty()) ranges.push_back(r);
+        if (!bar) break;
+        p = bar + 2;
+    }
+    out.insert(out.end(), ranges.begin(), ranges.end());
+    return true;
+}
+
+CaretIntersection::CaretIntersection(bool includePrerelease)
+    : _count(0), _includePrerelease(includePrerelease) {}
+
+bool CaretIntersection::add(const SemVer& requirement) {
+    _count++;
+    if (!requirement.isValid()) {
+        _range = VersionRange::none();
+        _prerelease = _range;
+        return false;
+    }
+    VersionRange r = VersionRange::caret(requirement);
+    _range = _range.intersect(r);
+    if (_includePrerelease) {
+        _prerelease = _range;
+    } else if (requirement.getPrerelease()[0] != '\0') {
+        // Only pre-releases of the requirement's own major.minor.patch
+        r.high = release(requirement.major, requirement.minor, requirement.patch);
+        _prerelease = _prerelease.intersect(r);
+    } else {
+        _prerelease = VersionRange::none();
+    }
+    return !_range.empty();
+}
+
+// Both ranges are always [low, high), so at most two operator< calls decide
+bool CaretIntersection::contains(const SemVer& version) const {
+    if (!version.isValid()) return false;
+    const VersionRange& r = version.getPrerelease()[0] != '\0' ? _prerelease : _range;
+    return (!r.low.isValid() || !(version < r.low)) && (!r.high.isValid() || version < r.high);
+}
+
+bool CaretIntersection::empty() const {
+    return _range.empty();
+}
+
+const VersionRange& CaretIntersection::range() const {
+    return _range;
+}
+
+const VersionRange& CaretIntersection::prereleaseRange() const {
+    return _prerelease;
+}
+
+size_t CaretIntersection::count() const {
+    return _count;
+}
+
+#endif // SEMVER_HOST
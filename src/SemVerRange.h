@@ -0,0 +1,120 @@
+#ifndef SEMVER_RANGE_H
+#define SEMVER_RANGE_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <vector>
+
+/**
+ * @brief Contiguous interval of versions by precedence
+ *
+ * Either bound may be open (unbounded) or exclusive. Pre-releases are ordinary
+ * points of the precedence order: "<2.0.0" contains 2.0.0-rc.1. Caret and tilde
+ * ranges end just below the first pre-release of the next version (2.0.0-0),
+ * matching SemVer::satisfies().
+ */
+struct VersionRange {
+    SemVer low;          // Invalid = no lower bound
+    SemVer high;         // Invalid = no upper bound
+    bool lowInclusive;
+    bool highInclusive;
+
+    /**
+     * @brief Range containing every version
+     */
+    VersionRange();
+
+    bool contains(const SemVer& version) const;
+    bool empty() const;
+
+    /**
+     * @brief Versions contained in both ranges (possibly empty())
+     */
+    VersionRange intersect(const VersionRange& other) const;
+
+    /**
+     * @brief Range of "^version" (see class description)
+     */
+    static VersionRange caret(const SemVer& version);
+
+    /**
+     * @brief Range containing no version
+     */
+    static VersionRange none();
+
+    /**
+     * @brief Compare lower bounds (-1, 0, 1); an open bound is the lowest
+     */
+    static int compareLow(const VersionRange& a, const VersionRange& b);
+
+    /**
+     * @brief Compare upper bounds (-1, 0, 1); an open bound is the highest
+     */
+    static int compareHigh(const VersionRange& a, const VersionRange& b);
+
+    /**
+     * @brief Whether a's upper bound lies below b's lower bound (no overlap, a first)
+     */
+    static bool before(const VersionRange& a, const VersionRange& b);
+
+    /**
+     * @brief Parse a range expression, appending one range per alternative
+     *
+     * Comparators are separated by spaces and intersected; alternatives are
+     * separated by "||". Supported: "1.2.3", "=1.2.3", ">1.2.3", ">=1.2.3",
+     * "<1.2.3", "<=1.2.3", "^1.2.3", "~1.2.3", "1.2.3 - 2.0.0" and "*".
+     * Versions must be complete. Empty alternatives are dropped.
+     *
+     * @return false on a syntax error (nothing is appended)
+     */
+    static bool parse(const char* expression, std::vector<VersionRange>& out);
+};
+
+/**
+ * @brief Intersection of caret requirements, as SemVer::satisfies() applies them
+ *
+ * contains(v) equals v.satisfies(r, includePrerelease) for every added
+ * requirement r, but costs one range check however many were added. Stable
+ * versions are checked against the intersection of the caret ranges.
+ * Pre-releases are checked against a second range: without includePrerelease,
+ * satisfies() only accepts a pre-release when every requirement is a
+ * pre-release of the same major.minor.patch, so that range ends below that
+ * release (or is empty). Conflicting requirements leave empty() true.
+ */
+class CaretIntersection {
+public:
+    /**
+     * @brief No requirements yet: contains every valid version
+     */
+    explicit CaretIntersection(bool includePrerelease = false);
+
+    /**
+     * @brief Narrow to versions that also satisfy a caret requirement
+     * @return false if nothing is left (an invalid requirement matches nothing)
+     */
+    bool add(const SemVer& requirement);
+
+    bool contains(const SemVer& version) const;
+
+    /**
+     * @brief Whether no version satisfies every requirement added
+     */
+    bool empty() const;
+
+    const VersionRange& range() const;           // For stable versions
+    const VersionRange& prereleaseRange() const; // For pre-release versions
+    size_t count() const;                        // Requirements added
+
+private:
+    VersionRange _range;
+    VersionRange _prerelease;
+    size_t _count;
+    bool _includePrerelease;
+};
+
+#endif // SEMVER_HOST
+
+#endif
@@ -0,0 +1,264 @@
+#include "SemVerRegistry.h"
+
+#ifdef SEMVER_HOST
+
+#include <string.h>
+#include <thread>
+
+namespace {
+
+const uint32_t EMPTY = 0;
+const uint32_t BUSY = 1;
+
+uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return h;
+}
+
+// Whether epoch a is later than b (wrap-safe)
+bool later(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
+
+} // namespace
+
+const uint32_t VersionRegistry::NO_VERSION;
+
+VersionRegistry::VersionRegistry(size_t maxDevices, size_t maxVersions)
+    : _maxVersions(maxVersions ? maxVersions : 1), _versionCount(0),
+      _maxDevices(maxDevices ? maxDevices : 1), _deviceCount(0), _epoch(0) {
+    // Both tables stay at or below half full
+    size_t slots = 2;
+    while (slots < _maxVersions * 2) slots <<= 1;
+    _versionSlots = new std::atomic<uint32_t>[slots];
+    for (size_t i = 0; i < slots; i++) _versionSlots[i].store(EMPTY, std::memory_order_relaxed);
+    _versionMask = (uint32_t)(slots - 1);
+    _versions = new SemVer[_maxVersions];
+    _versionHashes = new uint64_t[_maxVersions];
+
+    slots = 2;
+    while (slots < _maxDevices * 2) slots <<= 1;
+    _devices = new DeviceSlot[slots];
+    for (size_t i = 0; i < slots; i++) {
+        _devices[i].key.store(0, std::memory_order_relaxed);
+        _devices[i].value.store(NO_VERSION, std::memory_order_relaxed);
+    }
+    _deviceMask = slots - 1;
+
+    _base = new std::atomic<int64_t>[_maxVersions];
+    for (size_t h = 0; h < _maxVersions; h++) _base[h].store(0, std::memory_order_relaxed);
+    for (int s = 0; s < SEMVER_REGISTRY_SHARDS; s++) {
+        for (int p = 0; p < 2; p++) {
+            _shards[s].writers[p].store(0, std::memory_order_relaxed);
+            _shards[s].deltas[p] = new std::atomic<int64_t>[_maxVersions];
+            for (size_t h = 0; h < _maxVersions; h++) _shards[s].deltas[p][h].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+VersionRegistry::~VersionRegistry() {
+    for (int s = 0; s < SEMVER_REGISTRY_SHARDS; s++) {
+        delete[] _shards[s].deltas[0];
+        delete[] _shards[s].deltas[1];
+    }
+    delete[] _base;
+    delete[] _devices;
+    delete[] _versionHashes;
+    delete[] _versions;
+    delete[] _versionSlots;
+}
+
+uint32_t VersionRegistry::shardIndex() {
+    static std::atomic<uint32_t> nextThread(0);
+    static thread_local uint32_t index = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return index % SEMVER_REGISTRY_SHARDS;
+}
+
+uint64_t VersionRegistry::hashVersion(const SemVer& version) {
+    // Hash the text without build metadata, matching operator==
+    char text[SemVer::MAX_VERSION_LEN + 1];
+    version.toString(text, sizeof(text));
+    uint64_t h = 14695981039346656037ull;
+    for (const char* p = text; *p && *p != '+'; p++) {
+        h ^= (uint8_t)*p;
+        h *= 1099511628211ull;
+    }
+    return mix(h);
+}
+
+uint32_t VersionRegistry::intern(const SemVer& version) {
+    uint64_t h = hashVersion(version);
+    for (uint32_t i = (uint32_t)h & _versionMask; ; ) {
+        uint32_t state = _versionSlots[i].load(std::memory_order_acquire);
+        if (state == EMPTY) {
+            if (!_versionSlots[i].compare_exchange_strong(state, BUSY, std::memory_order_acq_rel)) continue;
+
+            uint32_t handle = _versionCount.load(std::memory_order_relaxed);
+            do {
+                if (handle >= _maxVersions) {
+                    _versionSlots[i].store(EMPTY, std::memory_order_release);
+                    return NO_VERSION;
+                }
+            } while (!_versionCount.compare_exchange_weak(handle, handle + 1, std::memory_order_relaxed));
+
+            _versions[handle] = version;
+            _versionHashes[handle] = h;
+            _versionSlots[i].store(handle + 2, std::memory_order_release);
+            return handle;
+        }
+        if (state == BUSY) {
+            // Another thread is filling this slot; it may be our version
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t handle = state - 2;
+        if (_versionHashes[handle] == h && _versions[handle] == version) return handle;
+        i = (i + 1) & _versionMask;
+    }
+}
+
+uint32_t VersionRegistry::find(const SemVer& version) const {
+    if (!version.isValid()) return NO_VERSION;
+    uint64_t h = hashVersion(version);
+    for (uint32_t i = (uint32_t)h & _versionMask; ; ) {
+        uint32_t state = _versionSlots[i].load(std::memory_order_acquire);
+        if (state == EMPTY) return NO_VERSION;
+        if (state == BUSY) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t handle = state - 2;
+        if (_versionHashes[handle] == h && _versions[handle] == version) return handle;
+        i = (i + 1) & _versionMask;
+    }
+}
+
+VersionRegistry::DeviceSlot* VersionRegistry::findDevice(uint64_t device, bool insert) {
+    uint64_t key = device + 1;
+    for (uint64_t i = mix(key) & _deviceMask; ; i = (i + 1) & _deviceMask) {
+        DeviceSlot& slot = _devices[i];
+        uint64_t cur = slot.key.load(std::memory_order_acquire);
+        if (cur == key) return &slot;
+        if (cur != 0) continue;
+        if (!insert) return NULL;
+
+        // Reserve capacity first so the table never exceeds half full
+        if (_deviceCount.fetch_add(1, std::memory_order_relaxed) >= _maxDevices) {
+            _deviceCount.fetch_sub(1, std::memory_order_relaxed);
+            return NULL;
+        }
+        if (slot.key.compare_exchange_strong(cur, key, std::memory_order_acq_rel)) return &slot;
+        _deviceCount.fetch_sub(1, std::memory_order_relaxed);
+        if (cur == key) return &slot;
+    }
+}
+
+const VersionRegistry::DeviceSlot* VersionRegistry::findDevice(uint64_t device) const {
+    return const_cast<VersionRegistry*>(this)->findDevice(device, false);
+}
+
+bool VersionRegistry::update(uint64_t device, uint32_t handle, bool insert) {
+    if (device == UINT64_MAX) return false;
+    DeviceSlot* slot = findDevice(device, insert);
+    if (!slot) return false;
+
+    Shard& shard = _shards[shardIndex()];
+    for (;;) {
+        uint32_t epoch = _epoch.load(std::memory_order_seq_cst);
+        std::atomic<uint32_t>& writers = shard.writers[epoch & 1];
+        writers.fetch_add(1, std::memory_order_seq_cst);
+        // snapshot() may have closed the epoch before it could see us
+        if (_epoch.load(std::memory_order_seq_cst) != epoch) {
+            writers.fetch_sub(1, std::memory_order_release);
+            continue;
+        }
+
+        // Tag the slot with our epoch; a later tag means our epoch is stale
+        uint64_t cur = slot->value.load(std::memory_order_acquire);
+        uint64_t next = ((uint64_t)epoch << 32) | handle;
+        bool stale;
+        while (!(stale = later((uint32_t)(cur >> 32), epoch)) &&
+               !slot->value.compare_exchange_weak(cur, next, std::memory_order_acq_rel)) {}
+        if (stale) {
+            writers.fetch_sub(1, std::memory_order_release);
+            continue;
+        }
+
+        uint32_t old = (uint32_t)cur;
+        if (old != handle) {
+            if (old != NO_VERSION) shard.deltas[epoch & 1][old].fetch_sub(1, std::memory_order_relaxed);
+            if (handle != NO_VERSION) shard.deltas[epoch & 1][handle].fetch_add(1, std::memory_order_relaxed);
+        }
+        writers.fetch_sub(1, std::memory_order_release);
+        return insert || old != NO_VERSION;
+    }
+}
+
+bool VersionRegistry::record(uint64_t device, const SemVer& version) {
+    if (!version.isValid() || device == UINT64_MAX) return false;
+    uint32_t handle = intern(version);
+    if (handle == NO_VERSION) return false;
+    return update(device, handle, true);
+}
+
+bool VersionRegistry::record(uint64_t device, const char* version) {
+    return record(device, SemVer(version));
+}
+
+bool VersionRegistry::remove(uint64_t device) {
+    return update(device, NO_VERSION, false);
+}
+
+uint32_t VersionRegistry::handleOf(uint64_t device) const {
+    if (device == UINT64_MAX) return NO_VERSION;
+    const DeviceSlot* slot = findDevice(device);
+    return slot ? (uint32_t)slot->value.load(std::memory_order_acquire) : NO_VERSION;
+}
+
+const SemVer& VersionRegistry::version(uint32_t handle) const {
+    if (handle >= _versionCount.load(std::memory_order_acquire)) return _empty;
+    return _versions[handle];
+}
+
+int64_t VersionRegistry::count(uint32_t handle) const {
+    if (handle >= _maxVersions) return 0;
+    int64_t n = _base[handle].load(std::memory_order_relaxed);
+    for (int s = 0; s < SEMVER_REGISTRY_SHARDS; s++) {
+        n += _shards[s].deltas[0][handle].load(std::memory_order_relaxed);
+        n += _shards[s].deltas[1][handle].load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+std::vector<VersionRegistry::Entry> VersionRegistry::snapshot() {
+    std::lock_guard<std::mutex> guard(_snapshotLock);
+
+    // Close the current epoch and wait for writers still inside it
+    uint32_t parity = _epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+    for (int s = 0; s < SEMVER_REGISTRY_SHARDS; s++) {
+        while (_shards[s].writers[parity].load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+    }
+
+    // Nobody writes this parity again until the next snapshot() closes the new epoch
+    std::vector<Entry> out;
+    for (size_t h = 0; h < _maxVersions; h++) {
+        int64_t n = _base[h].load(std::memory_order_relaxed);
+        for (int s = 0; s < SEMVER_REGISTRY_SHARDS; s++) {
+            n += _shards[s].deltas[parity][h].exchange(0, std::memory_order_relaxed);
+        }
+        _base[h].store(n, std::memory_order_relaxed);
+        if (n > 0) {
+            Entry e = { _versions[h], (uint32_t)h, (uint64_t)n };
+            out.push_back(e);
+        }
+    }
+    return out;
+}
+
+size_t VersionRegistry::versionCount() const {
+    return _versionCount.load(std::memory_order_acquire);
+}
+
+#endif // SEMVER_HOST
@@ -0,0 +1,147 @@
+#ifndef SEMVER_REGISTRY_H
+#define SEMVER_REGISTRY_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <stdlib.h>
+#include <vector>
+
+// Counter shards per registry; threads are spread over them round-robin
+#ifndef SEMVER_REGISTRY_SHARDS
+#define SEMVER_REGISTRY_SHARDS 16
+#endif
+
+/**
+ * @brief Concurrent map from device ID to the version it last reported
+ *
+ * Versions are interned into compact handles (equal per operator==, so build
+ * metadata is ignored) in a lock-free hash table; devices live in a second
+ * lock-free table holding their current handle. Live device counts per version
+ * are kept as deltas in per-thread-sharded counters and summed on read.
+ *
+ * record() and remove() take no locks. snapshot() returns counts that are
+ * consistent: every device is counted exactly once, under a version it actually
+ * reported, as of one point in its update history. It does so by closing the
+ * current counting epoch: each device slot is tagged with the epoch of its last
+ * update, tags only increase, and snapshot() waits for writers still inside
+ * the closed epoch before folding its deltas. Concurrent snapshot() calls are
+ * serialized with each other, never with writers.
+ */
+class VersionRegistry {
+public:
+    static const uint32_t NO_VERSION = 0xFFFFFFFFu;
+
+    struct Entry {
+        SemVer version;
+        uint32_t handle;
+        uint64_t devices;
+    };
+
+    /**
+     * @param maxDevices Devices tracked (fixed; record() fails beyond it)
+     * @param maxVersions Distinct versions interned (fixed)
+     */
+    VersionRegistry(size_t maxDevices, size_t maxVersions = 1024);
+    ~VersionRegistry();
+
+    /**
+     * @brief Record that a device reported a version
+     * @param device Device ID (any value except UINT64_MAX)
+     * @return false if the version is invalid or a table is full
+     */
+    bool record(uint64_t device, const SemVer& version);
+    bool record(uint64_t device, const char* version);
+
+    /**
+     * @brief Stop counting a device
+     * @return false if the device was not registered
+     */
+    bool remove(uint64_t device);
+
+    /**
+     * @brief Current handle of a device, or NO_VERSION
+     */
+    uint32_t handleOf(uint64_t device) const;
+
+    /**
+     * @brief Handle of an interned version, or NO_VERSION if never reported
+     */
+    uint32_t find(const SemVer& version) const;
+
+    /**
+     * @brief Version of a handle returned by handleOf(), find() or snapshot()
+     */
+    const SemVer& version(uint32_t handle) const;
+
+    /**
+     * @brief Approximate live count (writers in flight may be missing)
+     */
+    int64_t count(uint32_t handle) const;
+
+    /**
+     * @brief Consistent per-version device counts, versions with zero omitted
+     */
+    std::vector<Entry> snapshot();
+
+    size_t versionCount() const;
+
+    // C++11 'new' ignores extended alignment, so heap holders allocate their own
+    static void* operator new(size_t size) {
+        void* p = NULL;
+        if (posix_memalign(&p, 64, size) != 0) throw std::bad_alloc();
+        return p;
+    }
+    static void operator delete(void* p) { free(p); }
+
+private:
+    // One cache line per shard
+    struct alignas(64) Shard {
+        std::atomic<uint32_t> writers[2];  // Writers inside an epoch, by parity
+        std::atomic<int64_t>* deltas[2];   // Per-handle count changes, by parity
+    };
+
+    struct DeviceSlot {
+        std::atomic<uint64_t> key;         // Device ID + 1, 0 if empty
+        std::atomic<uint64_t> value;       // Epoch << 32 | handle
+    };
+
+    // Version table
+    std::atomic<uint32_t>* _versionSlots; // EMPTY, BUSY or handle + 2
+    SemVer* _versions;
+    uint64_t* _versionHashes;
+    uint32_t _versionMask;
+    size_t _maxVersions;
+    std::atomic<uint32_t> _versionCount;
+
+    // Device table
+    DeviceSlot* _devices;
+    uint64_t _deviceMask;
+    size_t _maxDevices;
+    std::atomic<size_t> _deviceCount;
+
+    Shard _shards[SEMVER_REGISTRY_SHARDS];
+    std::atomic<uint32_t> _epoch;
+    std::atomic<int64_t>* _base;           // Counts folded by snapshot()
+    SemVer _empty;
+    std::mutex _snapshotLock;
+
+    uint32_t intern(const SemVer& version);
+    DeviceSlot* findDevice(uint64_t device, bool insert);
+    const DeviceSlot* findDevice(uint64_t device) const;
+    bool update(uint64_t device, uint32_t handle, bool insert);
+    static uint64_t hashVersion(const SemVer& version);
+    static uint32_t shardIndex();
+
+    VersionRegistry(const VersionRegistry&);
+    VersionRegistry& operator=(const VersionRegistry&);
+};
+
+#endif // SEMVER_HOST
+
+#endif
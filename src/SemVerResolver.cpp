@@ -0,0 +1,435 @@
+#include "SemVerResolver.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+std::string keyOf(const SemVer& version) {
+    char text[SemVer::MAX_VERSION_LEN + 1];
+    version.toString(text, sizeof(text));
+    char* plus = strchr(text, '+');
+    if (plus) *plus = '\0';
+    return text;
+}
+
+bool has(const std::vector<uint64_t>& set, size_t i) {
+    return (set[i / 64] >> (i % 64)) & 1;
+}
+
+int popcount(const uint64_t* words, size_t n) {
+    int count = 0;
+    for (size_t i = 0; i < n; i++) count += __builtin_popcountll(words[i]);
+    return count;
+}
+
+} // namespace
+
+const uint32_t DependencyResolver::NO_PACKAGE;
+const uint32_t DependencyResolver::ROOT;
+
+DependencyResolver::DependencyResolver()
+    : _decisions(0), _conflictDepth(0), _steps(0), _stepLimit(0), _memoHits(0),
+      _prepared(false), _preparedPrerelease(false) {
+    _conflict.package = NO_PACKAGE;
+}
+
+uint32_t DependencyResolver::addPackage(const char* name) {
+    std::unordered_map<std::string, uint32_t>::const_iterator it = _byName.find(name);
+    if (it != _byName.end()) return it->second;
+    uint32_t id = (uint32_t)_packages.size();
+    _packages.push_back(Package());
+    _packages.back().name = name;
+    _byName[name] = id;
+    _prepared = false;
+    return id;
+}
+
+uint32_t DependencyResolver::find(const char* name) const {
+    std::unordered_map<std::string, uint32_t>::const_iterator it = _byName.find(name);
+    return it == _byName.end() ? NO_PACKAGE : it->second;
+}
+
+const char* DependencyResolver::name(uint32_t package) const {
+    return package < _packages.size() ? _packages[package].name.c_str() : "";
+}
+
+size_t DependencyResolver::packageCount() const {
+    return _packages.size();
+}
+
+bool DependencyResolver::addRelease(uint32_t package, const SemVer& version) {
+    if (package >= _packages.size() || !version.isValid()) return false;
+    Package& p = _packages[package];
+    std::string key = keyOf(version);
+    if (p.index.count(key)) return false;
+    p.index[key] = (uint32_t)p.releases.size();
+    p.releases.push_back(version);
+    p.deps.push_back(std::vector<Dependency>());
+    _prepared = false;
+    return true;
+}
+
+bool DependencyResolver::addDependency(uint32_t package, const SemVer& release, uint32_t dependency,
+                                       const SemVer& requirement) {
+    if (package >= _packages.size() || dependency >= _packages.size() || !requirement.isValid()) return false;
+    Package& p = _packages[package];
+    std::unordered_map<std::string, uint32_t>::const_iterator it = p.index.find(keyOf(release));
+    if (it == p.index.end()) return false;
+    Dependency dep = { dependency, requirement, 0 };
+    p.deps[it->second].push_back(dep);
+    _prepared = false;
+    return true;
+}
+
+DependencyResolver::Status DependencyResolver::resolve(const std::vector<Requirement>& requirements,
+                                                       bool includePrerelease, uint64_t stepLimit) {
+    prepare(includePrerelease);
+
+    size_t n = _packages.size();
+    _allowed.assign(_packages.empty() ? 0 : _packages.back().offset + _packages.back().words, 0);
+    for (size_t p = 0; p < n; p++) {
+        const Package& pkg = _packages[p];
+        for (size_t r = 0; r < pkg.releases.size(); r++) _allowed[pkg.offset + r / 64] |= 1ull << (r % 64);
+    }
+    _excluded.assign(_allowed.size(), 0);
+    _constrained.assign(n, 0);
+    _decided.assign(n, NO_PACKAGE);
+    _constraints.assign(n, std::vector<Constraint>());
+    _trail.clear();
+    _savedWords.clear();
+    _failed.clear();
+    _solution.clear();
+    _decisions = 0;
+    _conflictDepth = 0xFFFFFFFFu;
+    _conflict.package = NO_PACKAGE;
+    _conflict.chosen = SemVer();
+    _conflict.constraints.clear();
+    _steps = 0;
+    _stepLimit = stepLimit;
+    _memoHits = 0;
+
+    for (size_t i = 0; i < requirements.size(); i++) {
+        const Requirement& req = requirements[i];
+        Constraint c = { req.package, req.version, ROOT, SemVer() };
+        if (req.package >= n) {
+            _conflict.package = req.package;
+            _conflict.constraints.push_back(c);
+            return UNSATISFIABLE;
+        }
+        if (!constrain(c, bitsetFor(req.package, req.version, includePrerelease))) return UNSATISFIABLE;
+    }
+
+    Explanation why;
+    Status status = search(why);
+    if (status == RESOLVED) {
+        _solution.assign(n, SemVer());
+        for (size_t p = 0; p < n; p++) {
+            if (_decided[p] != NO_PACKAGE) _solution[p] = _packages[p].releases[_decided[p]];
+        }
+    }
+    return status;
+}
+
+const SemVer& DependencyResolver::selected(uint32_t package) const {
+    return package < _solution.size() ? _solution[package] : _none;
+}
+
+const DependencyResolver::Conflict& DependencyResolver::conflict() const {
+    return _conflict;
+}
+
+uint64_t DependencyResolver::steps() const {
+    return _steps;
+}
+
+uint64_t DependencyResolver::memoHits() const {
+    return _memoHits;
+}
+
+void DependencyResolver::prepare(bool includePrerelease) {
+    if (_prepared && _preparedPrerelease == includePrerelease) return;
+
+    // Sort catalogs ascending, carrying dependencies and the text index along
+    size_t offset = 0;
+    for (size_t p = 0; p < _packages.size(); p++) {
+        Package& pkg = _packages[p];
+        std::vector<uint32_t> order(pkg.releases.size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = (uint32_t)i;
+        std::sort(order.begin(), order.end(), [&pkg](uint32_t a, uint32_t b) {
+            return pkg.releases[a] < pkg.releases[b];
+        });
+        std::vector<SemVer> releases(order.size());
+        std::vector<std::vector<Dependency> > deps(order.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            releases[i] = pkg.releases[order[i]];
+            deps[i].swap(pkg.deps[order[i]]);
+            pkg.index[keyOf(releases[i])] = (uint32_t)i;
+        }
+        pkg.releases.swap(releases);
+        pkg.deps.swap(deps);
+        pkg.words = (pkg.releases.size() + 63) / 64;
+        pkg.offset = offset;
+        offset += pkg.words;
+    }
+
+    _bitsets.clear();
+    _bitsetIds.clear();
+    std::vector<std::vector<uint32_t> > targeting(_packages.size());
+    for (size_t p = 0; p < _packages.size(); p++) {
+        Package& pkg = _packages[p];
+        for (size_t r = 0; r < pkg.deps.size(); r++) {
+            for (size_t d = 0; d < pkg.deps[r].size(); d++) {
+                Dependency& dep = pkg.deps[r][d];
+                size_t before = _bitsets.size();
+                dep.bits = bitsetFor(dep.package, dep.version, includePrerelease);
+                if (_bitsets.size() != before) targeting[dep.package].push_back(dep.bits);
+            }
+        }
+    }
+
+    // Releases allowed by exactly the same requirements are interchangeable once decided
+    for (size_t q = 0; q < _packages.size(); q++) {
+        Package& pkg = _packages[q];
+        std::unordered_map<std::string, uint32_t> classes;
+        pkg.classOf.assign(pkg.releases.size(), 0);
+        for (size_t r = 0; r < pkg.releases.size(); r++) {
+            std::string signature(targeting[q].size(), '0');
+            for (size_t i = 0; i < targeting[q].size(); i++) {
+                if (_bitsets[targeting[q][i]][r / 64] & (1ull << (r % 64))) signature[i] = '1';
+            }
+            std::unordered_map<std::string, uint32_t>::iterator it = classes.find(signature);
+            if (it == classes.end()) it = classes.insert(std::make_pair(signature, (uint32_t)classes.size())).first;
+            pkg.classOf[r] = it->second;
+        }
+    }
+
+    _prepared = true;
+    _preparedPrerelease = includePrerelease;
+}
+
+uint32_t DependencyResolver::bitsetFor(uint32_t package, const SemVer& requirement, bool includePrerelease) {
+    char text[16];
+    snprintf(text, sizeof(text), "%u:", (unsigned)package);
+    std::string key = text + keyOf(requirement);
+    std::unordered_map<std::string, uint32_t>::const_iterator it = _bitsetIds.find(key);
+    if (it != _bitsetIds.end()) return it->second;
+
+    const Package& pkg = _packages[package];
+    std::vector<uint64_t> bits(pkg.words, 0);
+    for (size_t r = 0; r < pkg.releases.size(); r++) {
+        if (pkg.releases[r].satisfies(requirement, includePrerelease)) bits[r / 64] |= 1ull << (r % 64);
+    }
+    uint32_t id = (uint32_t)_bitsets.size();
+    _bitsets.push_back(bits);
+    _bitsetIds[key] = id;
+    return id;
+}
+
+// Narrows a package's candidates; false (and the conflict recorded) if none are left
+bool DependencyResolver::constrain(const Constraint& constraint, uint32_t bits) {
+    uint32_t p = constraint.package;
+    const Package& pkg = _packages[p];
+    uint64_t* allowed = pkg.words ? &_allowed[pkg.offset] : NULL;
+
+    Saved saved = { p, _constrained[p], _savedWords.size() };
+    _savedWords.insert(_savedWords.end(), allowed, allowed + pkg.words);
+    _trail.push_back(saved);
+    _constraints[p].push_back(constraint);
+    _constrained[p] = 1;
+
+    const std::vector<uint64_t>& mask = _bitsets[bits];
+    uint64_t any = 0;
+    for (size_t w = 0; w < pkg.words; w++) {
+        allowed[w] &= mask[w];
+        any |= allowed[w];
+    }
+    uint32_t chosen = _decided[p];
+    bool ok = chosen == NO_PACKAGE ? any != 0 : (allowed[chosen / 64] & (1ull << (chosen % 64))) != 0;
+    if (!ok) recordConflict(p);
+    return ok;
+}
+
+void DependencyResolver::undo(size_t trailSize) {
+    while (_trail.size() > trailSize) {
+        const Saved& saved = _trail.back();
+        const Package& pkg = _packages[saved.package];
+        std::copy(_savedWords.begin() + saved.words, _savedWords.begin() + saved.words + pkg.words,
+                  _allowed.begin() + pkg.offset);
+        _savedWords.resize(saved.words);
+        _constrained[saved.package] = saved.constrained;
+        _constraints[saved.package].pop_back();
+        _trail.pop_back();
+    }
+}
+
+// Keeps the conflict reached with the fewest decisions, as the one closest to the roots
+void DependencyResolver::recordConflict(uint32_t package) {
+    if (_decisions >= _conflictDepth) return;
+    _conflictDepth = _decisions;
+    _conflict.package = package;
+    _conflict.chosen = _decided[package] == NO_PACKAGE ? SemVer() : _packages[package].releases[_decided[package]];
+    _conflict.constraints = _constraints[package];
+}
+
+// Undecided required package with the fewest candidates left
+uint32_t DependencyResolver::pickPackage() const {
+    uint32_t best = NO_PACKAGE;
+    int bestCount = 0;
+    for (size_t p = 0; p < _packages.size(); p++) {
+        if (!_constrained[p] || _decided[p] != NO_PACKAGE) continue;
+        int count = popcount(&_allowed[_packages[p].offset], _packages[p].words);
+        if (best == NO_PACKAGE || count < bestCount) {
+            best = (uint32_t)p;
+            bestCount = count;
+        }
+    }
+    return best;
+}
+
+std::string DependencyResolver::stateKey() const {
+    std::string key;
+    for (size_t p = 0; p < _packages.size(); p++) {
+        if (_decided[p] != NO_PACKAGE) {
+            uint32_t cls = _packages[p].classOf[_decided[p]];
+            key += 'D';
+            key.append((const char*)&cls, sizeof(cls));
+        } else if (_constrained[p]) {
+            key += 'C';
+            key.append((const char*)&_allowed[_packages[p].offset], _packages[p].words * sizeof(uint64_t));
+        } else {
+            key += 'U';
+        }
+    }
+    return key;
+}
+
+// Whether a failure explained by 'why' depends on the current decision of p:
+// p's own release matters, p narrowed an involved package, or p alone requires one
+bool DependencyResolver::dependsOn(const Explanation& why, uint32_t p) const {
+    if (has(why.state, p)) return true;
+    for (size_t u = 0; u < _packages.size(); u++) {
+        bool state = has(why.state, u);
+        if ((!state && !has(why.required, u)) || _decided[u] != NO_PACKAGE) continue;
+        const std::vector<Constraint>& constraints = _constraints[u];
+        bool onlyP = !constraints.empty();
+        for (size_t i = 0; i < constraints.size(); i++) {
+            if (constraints[i].from == p && state) return true;
+            if (constraints[i].from != p) onlyP = false;
+        }
+        if (onlyP) return true;
+    }
+    return false;
+}
+
+// Whether the failure of p's current release follows from the root requirements alone
+bool DependencyResolver::rootOnly(const Explanation& why, uint32_t p) const {
+    for (size_t u = 0; u < _packages.size(); u++) {
+        if (u == p || (!has(why.state, u) && !has(why.required, u))) continue;
+        if (_decided[u] != NO_PACKAGE) return false;
+        const std::vector<Constraint>& constraints = _constraints[u];
+        for (size_t i = 0; i < constraints.size(); i++) {
+            if (constraints[i].from != ROOT && constraints[i].from != p) return false;
+        }
+    }
+    return true;
+}
+
+// Removes a release from the search for good, including from states saved on the trail
+void DependencyResolver::exclude(uint32_t p, uint32_t release) {
+    size_t w = _packages[p].offset + release / 64;
+    uint64_t bit = 1ull << (release % 64);
+    _excluded[w] |= bit;
+    _allowed[w] &= ~bit;
+    for (size_t i = 0; i < _trail.size(); i++) {
+        if (_trail[i].package == p) _savedWords[_trail[i].words + release / 64] &= ~bit;
+    }
+}
+
+// Returns UNSATISFIABLE with 'why' naming the packages whose state explains the
+// failure: any state that agrees with this one on them fails too
+DependencyResolver::Status DependencyResolver::search(Explanation& why) {
+    uint32_t p = pickPackage();
+    if (p == NO_PACKAGE) return RESOLVED;
+
+    std::string key = stateKey();
+    std::unordered_map<std::string, Explanation>::const_iterator known = _failed.find(key);
+    if (known != _failed.end()) {
+        _memoHits++;
+        why = known->second;
+        return UNSATISFIABLE;
+    }
+    size_t words = (_packages.size() + 63) / 64;
+    why.state.assign(words, 0);
+    why.required.assign(words, 0);
+
+    const Package& pkg = _packages[p];
+    const uint64_t* excluded = &_excluded[pkg.offset];
+    std::vector<uint64_t> candidates(_allowed.begin() + pkg.offset, _allowed.begin() + pkg.offset + pkg.words);
+    Explanation below;
+    for (size_t w = pkg.words; w-- > 0;) {
+        while (candidates[w]) {
+            int bit = 63 - __builtin_clzll(candidates[w]);
+            candidates[w] &= ~(1ull << bit);
+            uint32_t r = (uint32_t)(w * 64 + bit);
+            if (++_steps > _stepLimit) return STEP_LIMIT;
+
+            size_t mark = _trail.size();
+            _decided[p] = r;
+            _decisions++;
+            bool ok = true;
+            const std::vector<Dependency>& deps = pkg.deps[r];
+            for (size_t d = 0; d < deps.size() && ok; d++) {
+                Constraint c = { deps[d].package, deps[d].version, p, pkg.releases[r] };
+                ok = constrain(c, deps[d].bits);
+                if (!ok) {
+                    below.state.assign(words, 0);
+                    below.required.assign(words, 0);
+                    below.state[c.package / 64] |= 1ull << (c.package % 64);
+                }
+            }
+            if (ok) {
+                Status status = search(below);
+                if (status != UNSATISFIABLE) return status;
+            }
+            bool learned = rootOnly(below, p);
+            // A failure that p's release did not cause recurs for every release of p
+            bool jump = ok && !dependsOn(below, p);
+            undo(mark);
+            _decided[p] = NO_PACKAGE;
+            _decisions--;
+            if (learned) exclude(p, r);
+            if (jump) {
+                why = below;
+                _failed[key] = why;
+                return UNSATISFIABLE;
+            }
+            for (size_t i = 0; i < words; i++) {
+                why.state[i] |= below.state[i];
+                why.required[i] |= below.required[i];
+            }
+        }
+    }
+
+    // Restate the explanation for this state, before any release of p was tried:
+    // p must be required, and its candidates matter only if something narrowed them
+    why.state[p / 64] &= ~(1ull << (p % 64));
+    for (size_t u = 0; u < _packages.size(); u++) {
+        if (has(why.required, u) && !has(why.state, u) && !_constrained[u]) {
+            why.required[u / 64] &= ~(1ull << (u % 64));
+        }
+    }
+    why.required[p / 64] |= 1ull << (p % 64);
+    for (size_t w = 0; w < pkg.words; w++) {
+        uint64_t all = w + 1 < pkg.words || pkg.releases.size() % 64 == 0
+            ? ~0ull : (1ull << (pkg.releases.size() % 64)) - 1;
+        if ((_allowed[pkg.offset + w] | excluded[w]) != all) why.state[p / 64] |= 1ull << (p % 64);
+    }
+    _failed[key] = why;
+    return UNSATISFIABLE;
+}
+
+#endif // SEMVER_HOST
@@ -0,0 +1,191 @@
+#ifndef SEMVER_RESOLVER_H
+#define SEMVER_RESOLVER_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Picks mutually compatible versions for a set of packages
+ *
+ * Each package has a release catalog; each release may carry caret requirements
+ * (see SemVer::satisfies) on other packages. resolve() finds one release per
+ * required package such that every requirement of every picked release holds.
+ *
+ * Catalogs are sorted once, and every distinct (package, requirement) pair is
+ * turned into a bitset of the releases it allows, so narrowing a package's
+ * candidates is a bitwise AND and the newest candidate is the highest set bit.
+ * The search is depth-first with backtracking: it always decides the package
+ * with the fewest candidates left, trying its newest candidate first.
+ *
+ * Failed states are memoized. A state is the candidate sets of the undecided
+ * packages plus, for decided ones, which requirements their release satisfies,
+ * so releases that no requirement tells apart (patch releases, typically) fail
+ * once, not once each. Each failure also carries the packages that explain it:
+ * when the last decision is not among them the search jumps straight past it,
+ * and a release whose failure follows from the root requirements alone is
+ * excluded for the rest of the search. Graphs built to defeat this can still
+ * take exponential time, which the step limit bounds.
+ */
+class DependencyResolver {
+public:
+    static const uint32_t NO_PACKAGE = 0xFFFFFFFFu;
+    static const uint32_t ROOT = 0xFFFFFFFEu; // Constraint::from for resolve() requirements
+
+    enum Status {
+        RESOLVED,
+        UNSATISFIABLE,  // See conflict()
+        STEP_LIMIT      // Gave up after the step limit
+    };
+
+    struct Requirement {
+        uint32_t package;
+        SemVer version;    // Caret requirement
+    };
+
+    struct Constraint {
+        uint32_t package;  // Constrained package
+        SemVer version;    // Caret requirement on it
+        uint32_t from;     // Requiring package, or ROOT
+        SemVer fromVersion; // Release of 'from' (invalid for ROOT)
+    };
+
+    /**
+     * @brief Requirements that could not be met together
+     *
+     * Either no release of the package satisfies all constraints, or they
+     * exclude the release already chosen for it (chosen is then valid).
+     */
+    struct Conflict {
+        uint32_t package;
+        SemVer chosen;
+        std::vector<Constraint> constraints;
+    };
+
+    DependencyResolver();
+
+    /**
+     * @brief Register a package, or look up one already registered
+     * @return Package id
+     */
+    uint32_t addPackage(const char* name);
+
+    /**
+     * @return Package id, or NO_PACKAGE
+     */
+    uint32_t find(const char* name) const;
+    const char* name(uint32_t package) const;
+    size_t packageCount() const;
+
+    /**
+     * @brief Add a release to a package catalog
+     * @return false if the package is unknown, the version invalid or already listed
+     */
+    bool addRelease(uint32_t package, const SemVer& version);
+
+    /**
+     * @brief Declare that a release requires a caret range of another package
+     * @return false if the release is not in the catalog or the requirement is invalid
+     */
+    bool addDependency(uint32_t package, const SemVer& release, uint32_t dependency, const SemVer& requirement);
+
+    /**
+     * @brief Find the newest compatible set of releases for the given requirements
+     * @param requirements Root requirements (e.g. what the firmware image needs)
+     * @param includePrerelease Passed to SemVer::satisfies
+     * @param stepLimit Maximum candidate releases tried
+     */
+    Status resolve(const std::vector<Requirement>& requirements, bool includePrerelease = false,
+                   uint64_t stepLimit = 1000000);
+
+    /**
+     * @brief Release picked for a package by the last successful resolve()
+     * @return Invalid version if the package is not part of the solution
+     */
+    const SemVer& selected(uint32_t package) const;
+
+    /**
+     * @brief Conflict found closest to the root requirements when resolve() fails
+     */
+    const Conflict& conflict() const;
+
+    uint64_t steps() const;       // Candidate releases tried by the last resolve()
+    uint64_t memoHits() const;    // States skipped because they failed before
+
+private:
+    struct Dependency {
+        uint32_t package;
+        SemVer version;
+        uint32_t bits;      // Index into _bitsets, set by prepare()
+    };
+
+    struct Package {
+        std::string name;
+        std::vector<SemVer> releases;                  // Ascending after prepare()
+        std::vector<std::vector<Dependency> > deps;    // Per release
+        std::unordered_map<std::string, uint32_t> index; // Version text -> release
+        std::vector<uint32_t> classOf;                 // Per release, see class description
+        size_t words;                                  // Bitset words
+        size_t offset;                                 // Into _allowed
+    };
+
+    // Packages (one bit each) whose candidates or release, and whose being
+    // required, explain why a search state has no solution
+    struct Explanation {
+        std::vector<uint64_t> state;
+        std::vector<uint64_t> required;
+    };
+
+    struct Saved {
+        uint32_t package;
+        uint8_t constrained;
+        size_t words;       // Start of the saved bitset in _savedWords
+    };
+
+    std::vector<Package> _packages;
+    std::unordered_map<std::string, uint32_t> _byName;
+    std::vector<std::vector<uint64_t> > _bitsets;
+    std::unordered_map<std::string, uint32_t> _bitsetIds; // "package:requirement" -> bitset
+    std::unordered_map<std::string, Explanation> _failed; // Failed state key -> explanation
+
+    // Search state
+    std::vector<uint64_t> _allowed;
+    std::vector<uint64_t> _excluded;                   // Releases proven unusable, same layout
+    std::vector<uint8_t> _constrained;
+    std::vector<uint32_t> _decided;                    // Release index or NO_PACKAGE
+    std::vector<std::vector<Constraint> > _constraints;
+    std::vector<Saved> _trail;
+    std::vector<uint64_t> _savedWords;
+    uint32_t _decisions;
+    uint32_t _conflictDepth;
+    uint64_t _steps;
+    uint64_t _stepLimit;
+    uint64_t _memoHits;
+    bool _prepared;
+    bool _preparedPrerelease;
+
+    std::vector<SemVer> _solution;
+    Conflict _conflict;
+    SemVer _none;
+
+    void prepare(bool includePrerelease);
+    uint32_t bitsetFor(uint32_t package, const SemVer& requirement, bool includePrerelease);
+    bool constrain(const Constraint& constraint, uint32_t bits);
+    void undo(size_t trailSize);
+    void recordConflict(uint32_t package);
+    uint32_t pickPackage() const;
+    std::string stateKey() const;
+    bool dependsOn(const Explanation& why, uint32_t p) const;
+    bool rootOnly(const Explanation& why, uint32_t p) const;
+    void exclude(uint32_t p, uint32_t release);
+    Status search(Explanation& why);
+};
+
+#endif // SEMVER_HOST
+
+#endif
@@ -0,0 +1,39 @@
+#include "SemVerStats.h"
+
+#ifdef SEMVER_STATS
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__aarch64__)
+#include <chrono>
+#endif
+
+std::atomic<uint64_t> SemVerStats::_counters[SemVerStats::COUNTER_COUNT];
+std::atomic<uint64_t> SemVerStats::_cycles[SemVerStats::TIMER_COUNT];
+
+SemVerStats::Snapshot SemVerStats::snapshot() {
+    Snapshot s;
+    for (int i = 0; i < COUNTER_COUNT; i++) s.counters[i] = _counters[i].load(std::memory_order_relaxed);
+    for (int i = 0; i < TIMER_COUNT; i++) s.cycles[i] = _cycles[i].load(std::memory_order_relaxed);
+    return s;
+}
+
+void SemVerStats::reset() {
+    for (int i = 0; i < COUNTER_COUNT; i++) _counters[i].store(0, std::memory_order_relaxed);
+    for (int i = 0; i < TIMER_COUNT; i++) _cycles[i].store(0, std::memory_order_relaxed);
+}
+
+uint64_t SemVerStats::now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+#endif // SEMVER_STATS
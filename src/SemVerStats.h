@@ -0,0 +1,121 @@
+#ifndef SEMVER_STATS_H
+#define SEMVER_STATS_H
+
+// Hot-path instrumentation, enabled with -DSEMVER_STATS.
+// Add -DSEMVER_STATS_TIMING to also accumulate cycle counts around parse,
+// operator<, satisfies and toString. Without SEMVER_STATS every hook below
+// expands to nothing, so the library build is byte-for-byte unchanged.
+
+#ifdef SEMVER_STATS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+class SemVerStats {
+public:
+    enum Counter {
+        PARSES,             // Parse attempts (every constructor taking a string)
+        INVALID_INPUTS,     // Parse attempts that were rejected
+        COMPARISONS,        // operator< and compareTotal() calls (>, <= and >= route through operator<; == and != are not counted)
+        SLOW_COMPARISONS,   // Those whose cores were equal
+        PRERELEASE_COMPARES,// comparePrerelease invocations
+        SATISFIES_CALLS,
+        TO_STRING_CALLS,
+        COUNTER_COUNT
+    };
+
+    enum Timer {
+        TIME_PARSE,
+        TIME_COMPARE,
+        TIME_SATISFIES,
+        TIME_TO_STRING,
+        TIMER_COUNT
+    };
+
+    /**
+     * @brief Point-in-time copy of all counters
+     *
+     * Counters are monotonic; rates are obtained by diffing two snapshots.
+     * Cycle totals stay zero unless built with SEMVER_STATS_TIMING.
+     */
+    struct Snapshot {
+        uint64_t counters[COUNTER_COUNT];
+        uint64_t cycles[TIMER_COUNT];
+    };
+
+    static Snapshot snapshot();
+    static void reset();
+
+    static void add(Counter c) {
+        _counters[c].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void addCycles(Timer t, uint64_t n) {
+        _cycles[t].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Raw cycle counter (TSC on x86, virtual counter on AArch64, ns elsewhere)
+     */
+    static uint64_t now();
+
+    /**
+     * @brief Counts a parse on scope exit, and an invalid input if the flag is false
+     */
+    class ParseScope {
+    public:
+        explicit ParseScope(const bool& valid) : _valid(valid) {
+#ifdef SEMVER_STATS_TIMING
+            _start = now();
+#endif
+        }
+        ~ParseScope() {
+#ifdef SEMVER_STATS_TIMING
+            addCycles(TIME_PARSE, now() - _start);
+#endif
+            add(PARSES);
+            if (!_valid) add(INVALID_INPUTS);
+        }
+    private:
+        const bool& _valid;
+#ifdef SEMVER_STATS_TIMING
+        uint64_t _start;
+#endif
+    };
+
+    /**
+     * @brief Accumulates cycles spent in the enclosing scope
+     */
+    class TimerScope {
+    public:
+        explicit TimerScope(Timer t) : _timer(t), _start(now()) {}
+        ~TimerScope() { addCycles(_timer, now() - _start); }
+    private:
+        Timer _timer;
+        uint64_t _start;
+    };
+
+private:
+    static std::atomic<uint64_t> _counters[COUNTER_COUNT];
+    static std::atomic<uint64_t> _cycles[TIMER_COUNT];
+};
+
+#define SEMVER_STAT_INC(counter) SemVerStats::add(SemVerStats::counter)
+#define SEMVER_STAT_PARSE(validFlag) SemVerStats::ParseScope _semverParseScope(validFlag)
+
+#ifdef SEMVER_STATS_TIMING
+#define SEMVER_STAT_TIME(timer) SemVerStats::TimerScope _semverTimerScope(SemVerStats::timer)
+#else
+#define SEMVER_STAT_TIME(timer) ((void)0)
+#endif
+
+#else
+
+#define SEMVER_STAT_INC(counter) ((void)0)
+#define SEMVER_STAT_PARSE(validFlag) ((void)0)
+#define SEMVER_STAT_TIME(timer) ((void)0)
+
+#endif // SEMVER_STATS
+
+#endif
@@ -0,0 +1,71 @@
+#include "SemVerUpgradePlanner.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+
+namespace {
+
+bool isEligible(const SemVer& v, bool includePrerelease) {
+    return v.isValid() && (includePrerelease || v.getPrerelease()[0] == '\0');
+}
+
+} // namespace
+
+UpgradePlanner::UpgradePlanner() {}
+
+size_t UpgradePlanner::publish(const std::vector<SemVer>& catalog,
+                               const std::vector<SemVer>& steppingStones,
+                               bool includePrerelease) {
+    _hops.clear();
+
+    std::vector<SemVer> releases;
+    releases.reserve(catalog.size());
+    for (size_t i = 0; i < catalog.size(); i++) {
+        if (isEligible(catalog[i], includePrerelease)) releases.push_back(catalog[i]);
+    }
+    if (releases.empty()) return 0;
+
+    std::sort(releases.begin(), releases.end());
+    const SemVer& newest = releases.back();
+
+    for (size_t i = 0; i < steppingStones.size(); i++) {
+        const SemVer& stone = steppingStones[i];
+        if (!isEligible(stone, includePrerelease)) continue;
+        if (!(stone < newest)) continue; // Latest is always the final hop anyway
+        if (!std::binary_search(releases.begin(), releases.end(), stone)) continue;
+        _hops.push_back(stone);
+    }
+
+    std::sort(_hops.begin(), _hops.end());
+    _hops.erase(std::unique(_hops.begin(), _hops.end()), _hops.end());
+    size_t stones = _hops.size();
+
+    _hops.push_back(newest);
+    return stones;
+}
+
+size_t UpgradePlanner::firstHopAbove(const SemVer& from) const {
+    return (size_t)(std::upper_bound(_hops.begin(), _hops.end(), from) - _hops.begin());
+}
+
+UpgradePlanner::Chain UpgradePlanner::plan(const SemVer& from) const {
+    Chain chain = { NULL, 0 };
+    if (!from.isValid() || _hops.empty()) return chain;
+
+    size_t first = firstHopAbove(from);
+    chain.hops = _hops.data() + first;
+    chain.count = _hops.size() - first;
+    return chain;
+}
+
+const SemVer* UpgradePlanner::nextHop(const SemVer& from) const {
+    Chain chain = plan(from);
+    return chain.empty() ? NULL : chain.hops;
+}
+
+const SemVer& UpgradePlanner::latest() const {
+    return _hops.empty() ? _empty : _hops.back();
+}
+
+#endif // SEMVER_HOST
@@ -0,0 +1,80 @@
+#ifndef SEMVER_UPGRADE_PLANNER_H
+#define SEMVER_UPGRADE_PLANNER_H
+
+#include "SemVerChecker.h"
+
+// Host-side component (update servers, tooling). Requires the C++ standard
+// library, so it is only compiled when built with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <vector>
+
+/**
+ * @brief Plans upgrade chains over a release catalog with mandatory stepping stones
+ *
+ * A stepping stone is a release every device must install before moving past it
+ * (e.g. a data migration in 2.0.0). The shortest chain from any version is the
+ * list of stepping stones above it followed by the latest release, so all chains
+ * are suffixes of a single hop table built once per publish(). A query is a
+ * binary search into that table and returns a view, without any allocation.
+ */
+class UpgradePlanner {
+public:
+    /**
+     * @brief Read-only view of an upgrade chain inside the planner's hop table
+     *
+     * Valid until the next call to publish().
+     */
+    struct Chain {
+        const SemVer* hops;
+        size_t count;
+
+        const SemVer& operator[](size_t i) const { return hops[i]; }
+        const SemVer* begin() const { return hops; }
+        const SemVer* end() const { return hops + count; }
+        bool empty() const { return count == 0; }
+    };
+
+    UpgradePlanner();
+
+    /**
+     * @brief Precompute chains for a newly published catalog
+     * @param catalog Releases in any order; invalid entries and duplicates are ignored
+     * @param steppingStones Releases that must be passed through; entries not in the
+     *        catalog (or not eligible under the prerelease policy) are ignored
+     * @param includePrerelease If true, pre-release versions may be the target
+     * @return Number of stepping stones retained
+     */
+    size_t publish(const std::vector<SemVer>& catalog,
+                   const std::vector<SemVer>& steppingStones,
+                   bool includePrerelease = false);
+
+    /**
+     * @brief Shortest upgrade chain from a device version to the latest release
+     * @param from Currently installed version
+     * @return Hops in install order (empty if up to date, invalid or no catalog)
+     */
+    Chain plan(const SemVer& from) const;
+
+    /**
+     * @brief Next release to install from a device version
+     * @return Pointer into the hop table, or NULL if no upgrade is needed
+     */
+    const SemVer* nextHop(const SemVer& from) const;
+
+    /**
+     * @brief Latest eligible release of the published catalog
+     * @return Latest version (invalid if nothing was published)
+     */
+    const SemVer& latest() const;
+
+private:
+    std::vector<SemVer> _hops; // Stepping stones in ascending order, then latest
+    SemVer _empty;
+
+    size_t firstHopAbove(const SemVer& from) const;
+};
+
+#endif // SEMVER_HOST
+
+#endif
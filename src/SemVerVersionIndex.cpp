@@ -0,0 +1,447 @@
+#include "SemVerVersionIndex.h"
+
+#ifdef SEMVER_HOST
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const uint32_t VersionIndex::NOT_FOUND;
+const uint16_t VersionIndex::FORMAT_VERSION;
+const size_t VersionIndex::HEADER_SIZE;
+
+namespace {
+
+const size_t CHECKSUM_OFFSET = 60;
+const size_t RECORD_SIZE = 8;
+const size_t CHANNEL_SIZE = 12;
+const size_t MIN_KEY_WIDTH = 12; // The core, so majorAt() reads the packed array only
+
+uint16_t loadU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+uint32_t loadU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void storeU16(std::vector<uint8_t>& out, size_t at, uint16_t v) {
+    out[at] = (uint8_t)v;
+    out[at + 1] = (uint8_t)(v >> 8);
+}
+
+void storeU32(std::vector<uint8_t>& out, size_t at, uint32_t v) {
+    for (int i = 0; i < 4; i++) out[at + i] = (uint8_t)(v >> (8 * i));
+}
+
+size_t alignTo8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+// Bytes [begin, end) into lane i % 4; begin is a multiple of 4
+void checksumLanes(const uint8_t* data, size_t begin, size_t end, uint32_t* lane) {
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        lane[0] = (lane[0] ^ data[i]) * 16777619u;
+        lane[1] = (lane[1] ^ data[i + 1]) * 16777619u;
+        lane[2] = (lane[2] ^ data[i + 2]) * 16777619u;
+        lane[3] = (lane[3] ^ data[i + 3]) * 16777619u;
+    }
+    for (; i < end; i++) lane[i % 4] = (lane[i % 4] ^ data[i]) * 16777619u;
+}
+
+// FNV-1a over four interleaved byte lanes, folded at the end: the lanes are
+// independent multiply chains, so a large file verifies about 4x faster
+uint32_t indexChecksum(const uint8_t* data, size_t len) {
+    uint32_t lane[4] = { 2166136261u, 2166136261u, 2166136261u, 2166136261u };
+    checksumLanes(data, 0, CHECKSUM_OFFSET, lane);
+    checksumLanes(data, CHECKSUM_OFFSET + 4, len, lane);
+    uint32_t h = 2166136261u;
+    for (int k = 0; k < 4; k++) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            h ^= (uint8_t)(lane[k] >> shift);
+            h *= 16777619u;
+        }
+    }
+    return h;
+}
+
+// Section [offset, offset + count * size) lies inside len
+bool sectionFits(uint32_t offset, uint32_t count, size_t size, size_t len) {
+    return offset <= len && (uint64_t)count * size <= len - offset;
+}
+
+// Key without build metadata: build bytes are the key's tail
+size_t precedenceKey(const SemVer& version, uint8_t* key) {
+    size_t len = version.sortKey(key, SemVer::MAX_SORT_KEY_LEN);
+    size_t build = strlen(version.getBuild());
+    return len >= build ? len - build : 0;
+}
+
+} // namespace
+
+VersionIndex::VersionIndex()
+    : _data(NULL), _len(0), _mapped(NULL), _mappedLen(0), _count(0), _channels(0), _keyWidth(0),
+      _keys(NULL), _records(NULL), _channelTable(NULL), _positions(NULL), _strings(NULL) {
+}
+
+VersionIndex::~VersionIndex() {
+    close();
+}
+
+bool VersionIndex::map(const char* path, bool verify) {
+    close();
+    if (!path) return false;
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        mapped = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+    _mapped = mapped;
+    _mappedLen = (size_t)st.st_size;
+    if (attach((const uint8_t*)mapped, _mappedLen, verify)) return true;
+    close();
+    return false;
+}
+
+bool VersionIndex::open(const uint8_t* data, size_t len, bool verify) {
+    close();
+    return attach(data, len, verify);
+}
+
+bool VersionIndex::attach(const uint8_t* data, size_t len, bool verify) {
+    if (!data || len < HEADER_SIZE || memcmp(data, "SVIX", 4) != 0) return false;
+    if (loadU16(data + 4) != FORMAT_VERSION) return false;
+    uint32_t total = loadU32(data + 48);
+    if (total < HEADER_SIZE || total > len) return false;
+    if (verify && indexChecksum(data, total) != loadU32(data + CHECKSUM_OFFSET)) return false;
+
+    uint16_t keyWidth = loadU16(data + 6);
+    uint32_t count = loadU32(data + 8);
+    uint32_t channels = loadU32(data + 12);
+    uint32_t keys = loadU32(data + 16), records = loadU32(data + 20), channelTable = loadU32(data + 24);
+    uint32_t positions = loadU32(data + 28), strings = loadU32(data + 32), stringBytes = loadU32(data + 36);
+    if (keyWidth < MIN_KEY_WIDTH || keyWidth > SemVer::MAX_SORT_KEY_LEN) return false;
+    if (!sectionFits(keys, count, keyWidth, total) || !sectionFits(records, count, RECORD_SIZE, total) ||
+        !sectionFits(channelTable, channels, CHANNEL_SIZE, total) || !sectionFits(positions, count, 4, total) ||
+        !sectionFits(strings, stringBytes, 1, total)) {
+        return false;
+    }
+
+    _data = data;
+    _count = count;
+    _channels = channels;
+    _keyWidth = keyWidth;
+    _keys = data + keys;
+    _records = data + records;
+    _channelTable = data + channelTable;
+    _positions = data + positions;
+    _strings = data + strings;
+    _len = strings + stringBytes; // End of the string area
+
+    if (validate()) return true;
+    _data = NULL;
+    _count = 0;
+    _channels = 0;
+    return false;
+}
+
+void VersionIndex::close() {
+    if (_mapped) munmap(_mapped, _mappedLen);
+    _mapped = NULL;
+    _mappedLen = 0;
+    _data = NULL;
+    _count = 0;
+    _channels = 0;
+}
+
+uint32_t VersionIndex::size() const {
+    return _count;
+}
+
+const char* VersionIndex::text(uint32_t position) const {
+    if (position >= _count) return NULL;
+    return (const char*)_data + loadU32(_records + RECORD_SIZE * position);
+}
+
+bool VersionIndex::get(uint32_t position, SemVer& version) const {
+    const char* s = text(position);
+    if (!s) return false;
+    version = SemVer(s);
+    return version.isValid();
+}
+
+uint32_t VersionIndex::lowerBound(const SemVer& version) const {
+    uint8_t key[SemVer::MAX_SORT_KEY_LEN];
+    if (!_data || !version.isValid()) return _count;
+    return search(key, precedenceKey(version, key), false);
+}
+
+uint32_t VersionIndex::upperBound(const SemVer& version) const {
+    uint8_t key[SemVer::MAX_SORT_KEY_LEN];
+    if (!_data || !version.isValid()) return _count;
+    return search(key, precedenceKey(version, key), true);
+}
+
+uint32_t VersionIndex::find(const SemVer& version) const {
+    uint8_t key[SemVer::MAX_SORT_KEY_LEN];
+    if (!_data || !version.isValid()) return NOT_FOUND;
+    size_t keyLen = version.sortKey(key, sizeof(key));
+    uint32_t position = search(key, keyLen, false);
+    // The first version starting with the key is the exact one, if present
+    if (position < _count && compare(position, key, keyLen) == 0 && loadU16(_records + RECORD_SIZE * position + 6) == keyLen) {
+        return position;
+    }
+    return NOT_FOUND;
+}
+
+size_t VersionIndex::channels() const {
+    return _channels;
+}
+
+const char* VersionIndex::channelName(size_t channel) const {
+    if (channel >= _channels) return NULL;
+    return (const char*)_data + loadU32(_channelTable + CHANNEL_SIZE * channel);
+}
+
+int32_t VersionIndex::findChannel(const char* name) const {
+    if (!name) return -1;
+    uint32_t lo = 0, hi = _channels;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int c = strcmp(channelName(mid), name);
+        if (c == 0) return (int32_t)mid;
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return -1;
+}
+
+uint32_t VersionIndex::channelSize(size_t channel) const {
+    if (channel >= _channels) return 0;
+    return loadU32(_channelTable + CHANNEL_SIZE * channel + 8);
+}
+
+uint32_t VersionIndex::channelPosition(size_t channel, uint32_t i) const {
+    if (i >= channelSize(channel)) return NOT_FOUND;
+    uint32_t first = loadU32(_channelTable + CHANNEL_SIZE * channel + 4);
+    return loadU32(_positions + 4 * (first + i));
+}
+
+uint32_t VersionIndex::latest(const char* channel) const {
+    int32_t c = findChannel(channel);
+    if (c < 0) return NOT_FOUND;
+    return channelPosition((size_t)c, channelSize((size_t)c) - 1);
+}
+
+uint32_t VersionIndex::latest(const char* channel, uint32_t major) const {
+    int32_t c = findChannel(channel);
+    if (c < 0) return NOT_FOUND;
+    uint32_t n = channelSize((size_t)c);
+    // Positions ascend, so majors do too: find the last one not above major
+    uint32_t lo = 0, hi = n;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (majorAt(channelPosition((size_t)c, mid)) <= major) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == 0) return NOT_FOUND;
+    uint32_t position = channelPosition((size_t)c, lo - 1);
+    return majorAt(position) == major ? position : NOT_FOUND;
+}
+
+// Bounds of every record and channel, checked once so that queries can trust them
+bool VersionIndex::validate() const {
+    size_t stringsBegin = (size_t)(_strings - _data);
+    for (uint32_t i = 0; i < _count; i++) {
+        const uint8_t* record = _records + RECORD_SIZE * i;
+        uint32_t offset = loadU32(record);
+        uint16_t textLen = loadU16(record + 4), keyLen = loadU16(record + 6);
+        size_t extra = keyLen > _keyWidth ? keyLen : 0;
+        if (keyLen < MIN_KEY_WIDTH || keyLen > SemVer::MAX_SORT_KEY_LEN || offset < stringsBegin ||
+            (uint64_t)offset + textLen + 1 + extra > _len || _data[offset + textLen] != '\0') {
+            return false;
+        }
+    }
+    uint32_t listed = 0;
+    for (uint32_t c = 0; c < _channels; c++) {
+        const uint8_t* entry = _channelTable + CHANNEL_SIZE * c;
+        uint32_t name = loadU32(entry), first = loadU32(entry + 4), n = loadU32(entry + 8);
+        if (name < stringsBegin || name >= _len || !memchr(_data + name, 0, _len - name)) return false;
+        if (n == 0 || first != listed || n > _count - listed) return false;
+        if (c > 0 && strcmp(channelName(c - 1), channelName(c)) >= 0) return false;
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t position = loadU32(_positions + 4 * (first + i));
+            if (position >= _count || (i > 0 && position <= loadU32(_positions + 4 * (first + i - 1)))) return false;
+        }
+        listed += n;
+    }
+    return listed == _count;
+}
+
+// Entry key against a probe key; 0 if the entry starts with the probe
+int VersionIndex::compare(uint32_t position, const uint8_t* key, size_t keyLen) const {
+    // Most comparisons are settled by the packed array (zero padding never sorts above a key byte)
+    const uint8_t* slot = _keys + (size_t)_keyWidth * position;
+    int c = memcmp(slot, key, keyLen < _keyWidth ? keyLen : _keyWidth);
+    if (c != 0) return c < 0 ? -1 : 1;
+
+    const uint8_t* record = _records + RECORD_SIZE * position;
+    size_t entryLen = loadU16(record + 6);
+    const uint8_t* full = entryLen <= _keyWidth ? slot : _data + loadU32(record) + loadU16(record + 4) + 1;
+    c = memcmp(full, key, entryLen < keyLen ? entryLen : keyLen);
+    if (c != 0) return c < 0 ? -1 : 1;
+    return entryLen < keyLen ? -1 : 0;
+}
+
+uint32_t VersionIndex::search(const uint8_t* key, size_t keyLen, bool upper) const {
+    uint32_t lo = 0, hi = _count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int c = compare(mid, key, keyLen);
+        if (c < 0 || (upper && c == 0)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+uint32_t VersionIndex::majorAt(uint32_t position) const {
+    const uint8_t* p = _keys + (size_t)_keyWidth * position;
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+VersionIndexBuilder::VersionIndexBuilder(uint16_t keyWidth) : _keyWidth(keyWidth) {
+    if (_keyWidth < MIN_KEY_WIDTH) _keyWidth = MIN_KEY_WIDTH;
+    if (_keyWidth > SemVer::MAX_SORT_KEY_LEN) _keyWidth = SemVer::MAX_SORT_KEY_LEN;
+}
+
+bool VersionIndexBuilder::add(const SemVer& version) {
+    if (!version.isValid()) return false;
+    _versions.push_back(version);
+    return true;
+}
+
+bool VersionIndexBuilder::add(const char* version) {
+    return add(SemVer(version));
+}
+
+size_t VersionIndexBuilder::count() const {
+    return _versions.size();
+}
+
+void VersionIndexBuilder::build(std::vector<uint8_t>& out) const {
+    std::vector<SemVer> versions(_versions);
+    std::sort(versions.begin(), versions.end(), [](const SemVer& a, const SemVer& b) {
+        return a.compareTotal(b) < 0;
+    });
+    versions.erase(std::unique(versions.begin(), versions.end(), [](const SemVer& a, const SemVer& b) {
+        return a.compareTotal(b) == 0;
+    }), versions.end());
+
+    uint32_t count = (uint32_t)versions.size();
+    std::vector<std::string> keys(count), texts(count);
+    std::map<std::string, std::vector<uint32_t> > channels;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t key[SemVer::MAX_SORT_KEY_LEN];
+        keys[i].assign((const char*)key, versions[i].sortKey(key, sizeof(key)));
+        char text[SemVer::MAX_VERSION_LEN + 1];
+        versions[i].toString(text, sizeof(text));
+        texts[i] = text;
+        const char* pre = versions[i].getPrerelease();
+        channels[std::string(pre, strcspn(pre, "."))].push_back(i);
+    }
+
+    size_t keysOffset = VersionIndex::HEADER_SIZE;
+    size_t recordsOffset = alignTo8(keysOffset + (size_t)_keyWidth * count);
+    size_t channelsOffset = alignTo8(recordsOffset + RECORD_SIZE * count);
+    size_t positionsOffset = alignTo8(channelsOffset + CHANNEL_SIZE * channels.size());
+    size_t stringsOffset = alignTo8(positionsOffset + 4 * (size_t)count);
+    out.assign(stringsOffset, 0);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const std::string& key = keys[i];
+        memcpy(&out[keysOffset + (size_t)_keyWidth * i], key.data(), std::min(key.size(), (size_t)_keyWidth));
+        size_t record = recordsOffset + RECORD_SIZE * i;
+        storeU32(out, record, (uint32_t)out.size());
+        storeU16(out, record + 4, (uint16_t)texts[i].size());
+        storeU16(out, record + 6, (uint16_t)key.size());
+        out.insert(out.end(), texts[i].begin(), texts[i].end());
+        out.push_back(0);
+        if (key.size() > _keyWidth) out.insert(out.end(), key.begin(), key.end());
+    }
+    uint32_t c = 0, listed = 0;
+    for (std::map<std::string, std::vector<uint32_t> >::const_iterator it = channels.begin(); it != channels.end(); ++it, c++) {
+        size_t entry = channelsOffset + CHANNEL_SIZE * c;
+        storeU32(out, entry, (uint32_t)out.size());
+        storeU32(out, entry + 4, listed);
+        storeU32(out, entry + 8, (uint32_t)it->second.size());
+        out.insert(out.end(), it->first.begin(), it->first.end());
+        out.push_back(0);
+        for (size_t i = 0; i < it->second.size(); i++) storeU32(out, positionsOffset + 4 * (listed + i), it->second[i]);
+        listed += (uint32_t)it->second.size();
+    }
+
+    memcpy(&out[0], "SVIX", 4);
+    storeU16(out, 4, VersionIndex::FORMAT_VERSION);
+    storeU16(out, 6, _keyWidth);
+    storeU32(out, 8, count);
+    storeU32(out, 12, (uint32_t)channels.size());
+    storeU32(out, 16, (uint32_t)keysOffset);
+    storeU32(out, 20, (uint32_t)recordsOffset);
+    storeU32(out, 24, (uint32_t)channelsOffset);
+    storeU32(out, 28, (uint32_t)positionsOffset);
+    storeU32(out, 32, (uint32_t)stringsOffset);
+    storeU32(out, 36, (uint32_t)(out.size() - stringsOffset));
+    storeU32(out, 48, (uint32_t)out.size());
+    storeU32(out, CHECKSUM_OFFSET, indexChecksum(out.data(), out.size()));
+}
+
+bool VersionIndexBuilder::write(const char* path) const {
+    if (!path) return false;
+    std::vector<uint8_t> bytes;
+    build(bytes);
+
+    // The temporary file must be on the same file system as path for rename()
+    std::string temp = std::string(path) + ".XXXXXX";
+    int fd = mkstemp(&temp[0]);
+    if (fd < 0) return false;
+    bool ok = fchmod(fd, 0644) == 0;
+    for (size_t done = 0; ok && done < bytes.size();) {
+        ssize_t n = ::write(fd, bytes.data() + done, bytes.size() - done);
+        if (n < 0 && errno == EINTR) continue;
+        ok = n > 0;
+        if (ok) done += (size_t)n;
+    }
+    // The data must be on disk before the rename makes it visible under path
+    ok = ok && fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    // rename() replaces path atomically; processes that mapped the old file keep it
+    if (!ok || rename(temp.c_str(), path) != 0) {
+        unlink(temp.c_str());
+        return false;
+    }
+
+    // Persist the rename itself
+    const char* slash = strrchr(path, '/');
+    std::string dir = slash ? std::string(path, slash == path ? 1 : (size_t)(slash - path)) : std::string(".");
+    int dirFd = ::open(dir.c_str(), O_RDONLY);
+    if (dirFd < 0) return false;
+    ok = fsync(dirFd) == 0;
+    ::close(dirFd);
+    return ok;
+}
+
+#endif // SEMVER_HOST
@@ -0,0 +1,168 @@
+#ifndef SEMVER_VERSION_INDEX_H
+#define SEMVER_VERSION_INDEX_H
+
+#include "SemVerChecker.h"
+
+// Host-side component, only compiled with -DSEMVER_HOST.
+#ifdef SEMVER_HOST
+
+#include <vector>
+
+/**
+ * @brief Prebuilt version index file that is queried straight from mmap
+ *
+ * A VersionIndexBuilder writes the file once; every server process then maps
+ * it read-only with map() and answers queries at once, without parsing or
+ * allocating. The kernel shares the pages between all processes that map the
+ * same file.
+ *
+ * Layout (integers little-endian, sections 8-byte aligned):
+ *   header     "SVIX", u16 format, u16 key width, u32 count, u32 channels,
+ *              u32 offsets of keys, records, channels, positions and strings,
+ *              u32 string bytes, u32 total size, reserved, u32 checksum
+ *   keys       per version, sortKey() padded or cut to the key width; sorted
+ *   records    per version: u32 string offset, u16 text length, u16 key length
+ *   channels   per channel, by name: u32 name offset, u32 first position, u32 count
+ *   positions  per channel, ascending version positions
+ *   strings    version text, then the full key if longer than the key width;
+ *              channel names
+ *
+ * Binary search compares probe keys with the packed key array and only reads
+ * a record when the packed prefixes tie. The checksum is FNV-1a in four
+ * interleaved lanes over the whole file, checksum field excluded. map() uses POSIX mmap().
+ */
+class VersionIndex {
+public:
+    static const uint32_t NOT_FOUND = 0xFFFFFFFFu;
+    static const uint16_t FORMAT_VERSION = 1;
+    static const size_t HEADER_SIZE = 64;
+
+    VersionIndex();
+    ~VersionIndex();
+
+    /**
+     * @brief Map an index file read-only and open it
+     * @param verify Check the checksum; costs one pass over the file
+     * @return false if the file cannot be mapped or is not a valid index
+     */
+    bool map(const char* path, bool verify = true);
+
+    /**
+     * @brief Open an index already in memory, which must outlive this object
+     */
+    bool open(const uint8_t* data, size_t len, bool verify = true);
+
+    /**
+     * @brief Unmap the file, if any; the index is then empty
+     */
+    void close();
+
+    uint32_t size() const;
+
+    /**
+     * @return Version string at a position (points into the index), or NULL
+     */
+    const char* text(uint32_t position) const;
+    bool get(uint32_t position, SemVer& version) const;
+
+    /**
+     * @brief First position not below 'version' by precedence; size() if none
+     */
+    uint32_t lowerBound(const SemVer& version) const;
+
+    /**
+     * @brief First position above 'version' by precedence; size() if none
+     */
+    uint32_t upperBound(const SemVer& version) const;
+
+    /**
+     * @brief Position of the version with equal compareTotal() (build metadata included), or NOT_FOUND
+     */
+    uint32_t find(const SemVer& version) const;
+
+    /**
+     * @brief Channels: the leading pre-release identifier, "" for stable releases
+     */
+    size_t channels() const;
+    const char* channelName(size_t channel) const;
+    int32_t findChannel(const char* name) const;      // -1 if absent
+    uint32_t channelSize(size_t channel) const;
+    uint32_t channelPosition(size_t channel, uint32_t i) const; // Ascending in i
+
+    /**
+     * @brief Position of the highest version of a channel
+     * @return NOT_FOUND if there is none
+     */
+    uint32_t latest(const char* channel) const;
+
+    /**
+     * @brief Position of the highest version of a channel within one major
+     * @return NOT_FOUND if there is none
+     */
+    uint32_t latest(const char* channel, uint32_t major) const;
+
+private:
+    const uint8_t* _data;
+    size_t _len;
+    void* _mapped;
+    size_t _mappedLen;
+    uint32_t _count;
+    uint32_t _channels;
+    uint16_t _keyWidth;
+    const uint8_t* _keys;
+    const uint8_t* _records;
+    const uint8_t* _channelTable;
+    const uint8_t* _positions;
+    const uint8_t* _strings;
+
+    bool attach(const uint8_t* data, size_t len, bool verify);
+    bool validate() const;
+    int compare(uint32_t position, const uint8_t* key, size_t keyLen) const;
+    uint32_t search(const uint8_t* key, size_t keyLen, bool upper) const;
+    uint32_t majorAt(uint32_t position) const;
+
+    VersionIndex(const VersionIndex&);
+    VersionIndex& operator=(const VersionIndex&);
+};
+
+/**
+ * @brief Writes VersionIndex files
+ */
+class VersionIndexBuilder {
+public:
+    /**
+     * @param keyWidth Bytes of each version's key kept in the packed array
+     *        (at least 12, the core); longer keys are completed from the string area
+     */
+    explicit VersionIndexBuilder(uint16_t keyWidth = 24);
+
+    /**
+     * @return false if the version is invalid
+     */
+    bool add(const SemVer& version);
+    bool add(const char* version);
+
+    /**
+     * @brief Sort, drop exact duplicates (compareTotal() == 0) and encode
+     */
+    void build(std::vector<uint8_t>& out) const;
+
+    /**
+     * @brief Build and write to path via a temporary file and rename, so
+     *        processes that map path never see a partial index
+     *
+     * The temporary file is created with mkstemp() next to path and synced
+     * before the rename; the directory is synced after it.
+     */
+    bool write(const char* path) const;
+
+    size_t count() const; // Versions added, duplicates included
+
+private:
+    std::vector<SemVer> _versions;
+    uint16_t _keyWidth;
+};
+
+#endif // SEMVER_HOST
+
+#endif
@@ -6,6 +6,26 @@
 #include <algorithm>
 #include <cctype>
 #include <vector>
+#include <stdint.h>
+
+// Mock for AVR flash (PROGMEM) access. Flash strings are ordinary RAM strings
+// here, but every read goes through pgm_read_byte so tests can verify that the
+// flash code paths never dereference the pointer directly.
+#define PROGMEM
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(PSTR(string_literal)))
+
+inline unsigned long& pgmReadCount() {
+    static unsigned long count = 0;
+    return count;
+}
+
+inline uint8_t pgm_read_byte(const void* addr) {
+    pgmReadCount()++;
+    return *static_cast<const uint8_t*>(addr);
+}
 
 // Mock for Arduino Print class
 class Print {
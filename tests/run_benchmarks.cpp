@@ -0,0 +1,612 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+// Same setup as run_tests.cpp: mock Arduino environment plus the library sources
+#include "Arduino.h"
+#include "../src/SemVerChecker.cpp"
+#include "../src/SemVerPublished.h"
+#include "../src/SemVerPipeline.cpp"
+#include "../src/SemVerResolver.cpp"
+#include "../src/SemVerRange.cpp"
+#include "../src/SemVerPrereleaseIndex.cpp"
+#include "../src/SemVerBuildMetadata.cpp"
+#include "../src/SemVerCompressedCatalog.cpp"
+#include "../src/SemVerVersionIndex.cpp"
+
+// Keeps results observable so the optimizer cannot drop the measured work
+volatile unsigned long benchSink = 0;
+
+typedef std::chrono::steady_clock BenchClock;
+
+double nsPerOp(BenchClock::time_point start, BenchClock::time_point end, size_t ops) {
+    return std::chrono::duration<double, std::nano>(end - start).count() / (double)ops;
+}
+
+void report(const char* name, double ns) {
+    std::cout << "  " << std::left << std::setw(44) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << ns << " ns/op" << std::endl;
+}
+
+struct InputSet {
+    const char* name;
+    std::vector<std::string> inputs;
+};
+
+void benchValidate(const InputSet& set, size_t rounds) {
+    size_t ops = rounds * set.inputs.size();
+    std::cout << "\n" << set.name << " (" << set.inputs.size() << " inputs)" << std::endl;
+
+    BenchClock::time_point t0 = BenchClock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < set.inputs.size(); i++) {
+            SemVer v(set.inputs[i].c_str());
+            benchSink += v.isValid();
+        }
+    }
+    BenchClock::time_point t1 = BenchClock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < set.inputs.size(); i++) {
+            const std::string& s = set.inputs[i];
+            benchSink += SemVer::validate(s.data(), s.size()).ok();
+        }
+    }
+    BenchClock::time_point t2 = BenchClock::now();
+
+    double ctor = nsPerOp(t0, t1, ops);
+    double val = nsPerOp(t1, t2, ops);
+    report("SemVer(str).isValid()", ctor);
+    report("SemVer::validate(str, len)", val);
+    std::cout << "  speedup: " << std::setprecision(2) << ctor / val << "x" << std::endl;
+}
+
+// Device check-ins against a 'latest' swapped by a publisher every millisecond.
+// Returns check-ins per microsecond summed over all readers.
+template <typename CheckIn>
+double checkInRate(int readers, CheckIn checkIn, void (*publishNext)(uint32_t)) {
+    std::atomic<bool> start(false), stop(false);
+    std::atomic<unsigned long> total(0), upgradeTotal(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < readers; t++) {
+        threads.push_back(std::thread([&, t]() {
+            SemVer device(t % 2 ? "1.4.2" : "2.0.0-rc.1");
+            unsigned long n = 0, upgrades = 0;
+            while (!start.load()) std::this_thread::yield();
+            while (!stop.load(std::memory_order_relaxed)) {
+                upgrades += checkIn(device);
+                n++;
+            }
+            upgradeTotal += upgrades;
+            total += n;
+        }));
+    }
+
+    const int publishes = 200;
+    start.store(true);
+    BenchClock::time_point t0 = BenchClock::now();
+    for (uint32_t i = 0; i < publishes; i++) {
+        publishNext(i);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stop.store(true);
+    BenchClock::time_point t1 = BenchClock::now();
+    for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+    benchSink += upgradeTotal.load();
+
+    return (double)total.load() / std::chrono::duration<double, std::micro>(t1 - t0).count();
+}
+
+std::mutex latestLock;
+SemVer lockedLatest("2.0.0");
+PublishedVersion publishedLatest(SemVer("2.0.0"));
+
+SemVer releaseNumber(uint32_t i) {
+    char text[32];
+    snprintf(text, sizeof(text), "2.%u.0", (unsigned)i);
+    return SemVer(text);
+}
+
+void publishLocked(uint32_t i) {
+    SemVer next = releaseNumber(i);
+    std::lock_guard<std::mutex> guard(latestLock);
+    lockedLatest = next;
+}
+
+void publishRcu(uint32_t i) {
+    publishedLatest.publish(releaseNumber(i));
+}
+
+int main() {
+    std::cout << "\nSemVerChecker Benchmarks (Local Native)" << std::endl;
+    const size_t rounds = 200000;
+
+    // --- validate() vs constructor ---
+    std::cout << "\n--- validate() vs constructor + isValid() ---" << std::endl;
+    {
+        InputSet valid = { "Valid versions", {
+            "1.2.3", "10.20.30", "2.5.3-rc.1+build.789", "1.0.0-alpha.beta.1",
+            "4294967295.4294967295.4294967295", "0.0.1+20261014.g1a2b3c4.ci789",
+            "1.2.3----RC-SNAPSHOT.12.9.1--.12+788", "3.1.0-beta.11"
+        } };
+        benchValidate(valid, rounds);
+
+        std::string lateBad = "1.2.3-";
+        for (int i = 0; i < 56; i++) lateBad += (i % 9 == 8) ? '.' : 'a';
+        lateBad += '!';
+        std::string tooLong(4096, '9');
+        std::string dots(60, '.');
+
+        InputSet adversarial = { "Adversarial inputs", {
+            lateBad,                  // Error in the last byte
+            tooLong,                  // Far beyond MAX_VERSION_LEN
+            dots,                     // Only separators
+            "01.2.3",                 // Leading zero
+            "99999999999.0.0",        // Overflow
+            "1.2.3-alpha..1",         // Empty identifier
+            "9.8.7+meta+meta",        // Second '+'
+            " 1.0.0"                  // Leading whitespace
+        } };
+        benchValidate(adversarial, rounds);
+    }
+
+    // --- Flash (PROGMEM) parsing ---
+    std::cout << "\n--- Flash parsing vs copy-to-RAM first ---" << std::endl;
+    {
+        static const char firmware[] PROGMEM = "2.5.3-rc.1+build.789";
+        const __FlashStringHelper* flash = reinterpret_cast<const __FlashStringHelper*>(firmware);
+        const size_t ops = rounds * 8;
+
+        BenchClock::time_point t0 = BenchClock::now();
+        for (size_t i = 0; i < ops; i++) {
+            // What sketches did before: strcpy_P into a RAM buffer, then parse
+            char ram[SemVer::MAX_VERSION_LEN + 1];
+            size_t n = 0;
+            while (n < SemVer::MAX_VERSION_LEN && (ram[n] = (char)pgm_read_byte(firmware + n)) != '\0') n++;
+            ram[n] = '\0';
+            SemVer v(ram);
+            benchSink += v.isValid();
+        }
+        BenchClock::time_point t1 = BenchClock::now();
+        for (size_t i = 0; i < ops; i++) {
+            SemVer v = SemVer::fromFlash(flash);
+            benchSink += v.isValid();
+        }
+        BenchClock::time_point t2 = BenchClock::now();
+
+        report("copy to RAM + SemVer(char*)", nsPerOp(t0, t1, ops));
+        report("SemVer::fromFlash()", nsPerOp(t1, t2, ops));
+        std::cout << "  (native mock: pgm_read_byte is a counted RAM load; saves "
+                  << SemVer::MAX_VERSION_LEN + 1 << " bytes of stack on AVR)" << std::endl;
+    }
+
+    // --- Published version: mutex vs RCU ---
+    std::cout << "\n--- Concurrent check-ins: mutex vs PublishedVersion ---" << std::endl;
+    {
+        std::cout << "  " << std::left << std::setw(10) << "readers"
+                  << std::right << std::setw(16) << "mutex ops/us" << std::setw(16) << "rcu ops/us" << std::endl;
+        int counts[] = { 1, 2, 4, 8, 16 };
+        for (int readers : counts) {
+            double locked = checkInRate(readers, [](const SemVer& device) {
+                std::lock_guard<std::mutex> guard(latestLock);
+                return device < lockedLatest;
+            }, publishLocked);
+            double rcu = checkInRate(readers, [](const SemVer& device) {
+                PublishedVersion::Snapshot latest(publishedLatest);
+                return device < *latest;
+            }, publishRcu);
+            std::cout << "  " << std::left << std::setw(10) << readers << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(16) << locked << std::setw(16) << rcu << std::endl;
+        }
+        std::cout << "  (hardware threads: " << std::thread::hardware_concurrency() << ")" << std::endl;
+    }
+
+    // --- Ingest: serial loop vs pipeline ---
+    std::cout << "\n--- Ingest: serial loop vs IngestPipeline ---" << std::endl;
+    {
+        std::string data;
+        uint32_t seed = 5;
+        const size_t records = 2000000;
+        for (size_t i = 0; i < records; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char line[64];
+            int n = snprintf(line, sizeof(line), "device-%u %u.%u.%u%s\n", (unsigned)i, 1 + (seed >> 10) % 3,
+                             (seed >> 12) % 20, (seed >> 16) % 10, (seed >> 20) % 6 ? "" : "-beta.3");
+            data.append(line, (size_t)n);
+        }
+        SemVer latest("3.19.9");
+
+        // What the ingest job did: one thread, one loop
+        BenchClock::time_point t0 = BenchClock::now();
+        uint64_t counts[IngestPipeline::OUTCOME_COUNT] = { 0 };
+        const char* p = data.data();
+        const char* end = p + data.size();
+        while (p < end) {
+            const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+            counts[IngestPipeline::classify(IngestPipeline::parseRecord(p, (size_t)(nl - p)), latest)]++;
+            p = nl + 1;
+        }
+        double serial = (double)records / std::chrono::duration<double>(BenchClock::now() - t0).count();
+        benchSink += counts[IngestPipeline::CURRENT];
+        std::cout << "  " << std::left << std::setw(24) << "serial loop" << std::right << std::setw(12)
+                  << std::setprecision(2) << serial / 1e6 << " M records/s" << std::endl;
+
+        unsigned workers[] = { 1, 2, 4, 8 };
+        for (unsigned w : workers) {
+            IngestPipeline pipeline(latest, w);
+            BenchClock::time_point t1 = BenchClock::now();
+            IngestPipeline::Report r = pipeline.run(data.data(), data.size());
+            double rate = (double)r.records / std::chrono::duration<double>(BenchClock::now() - t1).count();
+            bool same = r.outcomes[IngestPipeline::CURRENT] == counts[IngestPipeline::CURRENT] &&
+                        r.outcomes[IngestPipeline::BEHIND_MINOR] == counts[IngestPipeline::BEHIND_MINOR];
+            std::string label = "pipeline, " + std::to_string(w) + " parser" + (w > 1 ? "s" : "");
+            std::cout << "  " << std::left << std::setw(24) << label << std::right << std::setw(12) << rate / 1e6 << " M records/s  (" << std::setprecision(2) << rate / serial
+                      << "x, " << r.stalls << " stalls" << (same ? "" : ", MISMATCH") << ")" << std::endl;
+        }
+        std::cout << "  (hardware threads: " << std::thread::hardware_concurrency() << ")" << std::endl;
+    }
+
+    // --- Requirement checks ---
+    std::cout << "\n--- Three caret requirements: satisfies() each vs CaretIntersection ---" << std::endl;
+    {
+        const SemVer reqs[] = { SemVer("1.2.0"), SemVer("1.4.3"), SemVer("1.4.0-beta.2") };
+        CaretIntersection set;
+        for (size_t k = 0; k < 3; k++) set.add(reqs[k]);
+        std::vector<SemVer> catalog;
+        for (int minor = 0; minor < 10; minor++) {
+            for (int patch = 0; patch < 10; patch++) {
+                char text[32];
+                snprintf(text, sizeof(text), "1.%d.%d%s", minor, patch, patch == 9 ? "-rc.1" : "");
+                catalog.push_back(SemVer(text));
+            }
+        }
+        const size_t passes = rounds / 20;
+        const size_t ops = passes * catalog.size();
+
+        BenchClock::time_point t0 = BenchClock::now();
+        for (size_t r = 0; r < passes; r++) {
+            for (size_t i = 0; i < catalog.size(); i++) {
+                benchSink += catalog[i].satisfies(reqs[0]) && catalog[i].satisfies(reqs[1]) && catalog[i].satisfies(reqs[2]);
+            }
+        }
+        BenchClock::time_point t1 = BenchClock::now();
+        for (size_t r = 0; r < passes; r++) {
+            for (size_t i = 0; i < catalog.size(); i++) benchSink += set.contains(catalog[i]);
+        }
+        BenchClock::time_point t2 = BenchClock::now();
+
+        report("satisfies() x3", nsPerOp(t0, t1, ops));
+        report("CaretIntersection::contains()", nsPerOp(t1, t2, ops));
+    }
+
+    // --- Pre-release queries ---
+    std::cout << "\n--- rc builds of 2.x among 100000 pre-releases: scan vs PrereleaseIndex ---" << std::endl;
+    {
+        const char* tags[] = { "alpha", "beta", "rc", "nightly" };
+        std::vector<SemVer> catalog;
+        PrereleaseIndex index;
+        uint32_t seed = 46;
+        for (int i = 0; i < 100000; i++) {
+            char text[64];
+            seed = seed * 1103515245u + 12345u;
+            unsigned tag = (seed >> 8) % 4;
+            snprintf(text, sizeof(text), "%u.%u.%u-%s.%u", (seed >> 12) % 10, (seed >> 16) % 20, (seed >> 20) % 10,
+                     tags[tag], tag == 3 ? 20260800 + (seed >> 24) % 60 : 1 + (seed >> 24) % 5);
+            catalog.push_back(SemVer(text));
+            index.add(catalog.back());
+        }
+        BenchClock::time_point t0 = BenchClock::now();
+        index.build();
+        BenchClock::time_point t1 = BenchClock::now();
+
+        VersionRange v2;
+        v2.low = SemVer("2.0.0");
+        v2.high = SemVer("3.0.0");
+        v2.highInclusive = false;
+        const int queries = 20;
+        size_t found = 0;
+        for (int q = 0; q < queries; q++) {
+            // What callers did before: filter with getPrerelease() string work, then sort
+            std::vector<SemVer> hits;
+            for (size_t i = 0; i < catalog.size(); i++) {
+                const char* pre = catalog[i].getPrerelease();
+                if (catalog[i].major == 2 && strncmp(pre, "rc", 2) == 0 && (pre[2] == '\0' || pre[2] == '.')) {
+                    hits.push_back(catalog[i]);
+                }
+            }
+            std::stable_sort(hits.begin(), hits.end());
+            found = hits.size();
+            benchSink += found;
+        }
+        BenchClock::time_point t2 = BenchClock::now();
+        std::vector<uint32_t> positions;
+        for (int q = 0; q < queries; q++) {
+            positions.clear();
+            benchSink += index.find("rc", v2, positions);
+        }
+        BenchClock::time_point t3 = BenchClock::now();
+
+        std::cout << "  build: " << std::setprecision(1) << std::chrono::duration<double, std::milli>(t1 - t0).count()
+                  << " ms, " << found << " matches per query" << std::endl;
+        report("scan + stable_sort, per query", nsPerOp(t1, t2, queries));
+        report("PrereleaseIndex::find(), per query", nsPerOp(t2, t3, queries));
+    }
+
+    // --- Build metadata lookups ---
+    std::cout << "\n--- Lookup by commit among 100000 builds: split getBuild() vs BuildIndex ---" << std::endl;
+    {
+        std::vector<SemVer> builds;
+        BuildIndex index;
+        for (uint32_t i = 0; i < 100000; i++) {
+            char text[64];
+            snprintf(text, sizeof(text), "%u.%u.%u+%u.g%07x.ci%u", 1 + i / 20000, (i / 100) % 200, i % 100,
+                     20260101 + i / 1000, (i * 2654435761u) & 0xFFFFFFF, i);
+            builds.push_back(SemVer(text));
+        }
+        BenchClock::time_point t0 = BenchClock::now();
+        for (size_t i = 0; i < builds.size(); i++) index.add(builds[i]);
+        BenchClock::time_point t1 = BenchClock::now();
+
+        const int queries = 20;
+        char commit[16];
+        snprintf(commit, sizeof(commit), "g%07x", (77777u * 2654435761u) & 0xFFFFFFF);
+        for (int q = 0; q < queries; q++) {
+            // What callers did before: re-split every build string
+            size_t found = 0;
+            for (size_t i = 0; i < builds.size(); i++) {
+                std::string build = builds[i].getBuild();
+                size_t start = 0;
+                for (;;) {
+                    size_t dot = build.find('.', start);
+                    if (build.compare(start, dot == std::string::npos ? std::string::npos : dot - start, commit) == 0) found++;
+                    if (dot == std::string::npos) break;
+                    start = dot + 1;
+                }
+            }
+            benchSink += found;
+        }
+        BenchClock::time_point t2 = BenchClock::now();
+        std::vector<uint32_t> hits;
+        for (int q = 0; q < queries; q++) {
+            hits.clear();
+            benchSink += index.find(commit, hits);
+        }
+        BenchClock::time_point t3 = BenchClock::now();
+
+        std::cout << "  index build: " << std::setprecision(1) << std::chrono::duration<double, std::milli>(t1 - t0).count()
+                  << " ms, " << index.keys() << " identifiers" << std::endl;
+        report("split every getBuild(), per query", nsPerOp(t1, t2, queries));
+        report("BuildIndex::find(), per query", nsPerOp(t2, t3, queries));
+    }
+
+    // --- Total order ---
+    std::cout << "\n--- Sort 100000 versions with build metadata: toString() vs compareTotal() vs sortKey() ---" << std::endl;
+    {
+        std::vector<SemVer> versions;
+        uint32_t seed = 48;
+        for (int i = 0; i < 100000; i++) {
+            char text[64];
+            seed = seed * 1103515245u + 12345u;
+            snprintf(text, sizeof(text), "%u.%u.%u%s+%u.g%07x", (seed >> 8) % 4, (seed >> 12) % 20, (seed >> 18) % 10,
+                     (seed >> 24) % 4 == 0 ? "-rc.1" : "", 20261000 + (seed >> 26) % 31, seed & 0xFFFFFFF);
+            versions.push_back(SemVer(text));
+        }
+
+        // What callers did before: precedence, then compare the formatted strings
+        std::vector<SemVer> a = versions;
+        BenchClock::time_point t0 = BenchClock::now();
+        std::sort(a.begin(), a.end(), [](const SemVer& x, const SemVer& y) {
+            if (x < y) return true;
+            if (y < x) return false;
+            char bx[SemVer::MAX_VERSION_LEN + 1], by[SemVer::MAX_VERSION_LEN + 1];
+            x.toString(bx, sizeof(bx));
+            y.toString(by, sizeof(by));
+            return strcmp(bx, by) < 0;
+        });
+        BenchClock::time_point t1 = BenchClock::now();
+        std::vector<SemVer> b = versions;
+        std::sort(b.begin(), b.end(), [](const SemVer& x, const SemVer& y) { return x.compareTotal(y) < 0; });
+        BenchClock::time_point t2 = BenchClock::now();
+        std::vector<std::string> keys(versions.size());
+        for (size_t i = 0; i < versions.size(); i++) {
+            uint8_t key[SemVer::MAX_SORT_KEY_LEN];
+            keys[i].assign((const char*)key, versions[i].sortKey(key, sizeof(key)));
+        }
+        std::sort(keys.begin(), keys.end());
+        BenchClock::time_point t3 = BenchClock::now();
+
+        bool same = true;
+        for (size_t i = 0; i < a.size(); i++) same = same && a[i].compareTotal(b[i]) == 0;
+        report("operator< then toString() ties", nsPerOp(t0, t1, versions.size()));
+        report("compareTotal()", nsPerOp(t1, t2, versions.size()));
+        report("sortKey() strings (incl. building them)", nsPerOp(t2, t3, versions.size()));
+        std::cout << "  (ns per element; orders " << (same ? "agree" : "DIFFER") << ")" << std::endl;
+    }
+
+    // --- Release catalog ---
+    std::cout << "\n--- Catalog of 100000 releases: newline text vs CompressedCatalog ---" << std::endl;
+    {
+        std::string text;
+        CompressedCatalogBuilder builder;
+        std::vector<SemVer> probes;
+        uint32_t seed = 49;
+        for (uint32_t major = 0; major < 10; major++) {
+            for (uint32_t minor = 0; minor < 100; minor++) {
+                for (uint32_t patch = 0; patch < 100; patch++) {
+                    char line[48];
+                    seed = seed * 1103515245u + 12345u;
+                    // Every fifth patch ships release candidates first
+                    if (patch % 5 == 0 && (seed >> 24) % 2 == 0) {
+                        snprintf(line, sizeof(line), "%u.%u.%u-rc.1", major, minor, patch);
+                        text += line;
+                        text += '\n';
+                        builder.add(line);
+                    }
+                    snprintf(line, sizeof(line), "%u.%u.%u", major, minor, patch);
+                    text += line;
+                    text += '\n';
+                    builder.add(line);
+                    if ((seed >> 8) % 100 == 0) probes.push_back(SemVer(line));
+                }
+            }
+        }
+        std::vector<uint8_t> bytes;
+        builder.build(bytes);
+        CompressedCatalog catalog;
+        catalog.open(bytes.data(), bytes.size());
+
+        // What gateways did before: parse lines until the first one not below the probe
+        BenchClock::time_point t0 = BenchClock::now();
+        for (size_t q = 0; q < probes.size(); q++) {
+            const char* line = text.c_str();
+            uint32_t position = 0;
+            while (*line) {
+                const char* eol = strchr(line, '\n');
+                std::string one(line, eol - line);
+                if (!(SemVer(one.c_str()) < probes[q])) break;
+                position++;
+                line = eol + 1;
+            }
+            benchSink += position;
+        }
+        BenchClock::time_point t1 = BenchClock::now();
+        for (size_t q = 0; q < probes.size(); q++) benchSink += catalog.lowerBound(probes[q]);
+        BenchClock::time_point t2 = BenchClock::now();
+        CompressedCatalog::Cursor cursor = catalog.cursor();
+        CompressedCatalog::Entry entry;
+        while (cursor.next(entry)) benchSink += entry.patch;
+        BenchClock::time_point t3 = BenchClock::now();
+
+        std::cout << "  " << catalog.size() << " versions: text " << text.size() << " bytes, compressed " << bytes.size()
+                  << " bytes (" << std::setprecision(1) << (double)text.size() / bytes.size() << "x smaller)" << std::endl;
+        report("parse lines to lower bound, per query", nsPerOp(t0, t1, probes.size()));
+        report("CompressedCatalog::lowerBound()", nsPerOp(t1, t2, probes.size()));
+        report("Cursor::next(Entry&), per version", nsPerOp(t2, t3, catalog.size()));
+    }
+
+    // --- Service startup ---
+    std::cout << "\n--- Startup with 100000 versions: parse text + sort vs map() a VersionIndex ---" << std::endl;
+    {
+        std::vector<std::string> lines;
+        VersionIndexBuilder builder;
+        uint32_t seed = 50;
+        for (int i = 0; i < 100000; i++) {
+            char text[64];
+            seed = seed * 1103515245u + 12345u;
+            const char* channel[] = { "", "", "-beta.1", "-rc.2" };
+            snprintf(text, sizeof(text), "%u.%u.%u%s+%u", (seed >> 8) % 10, (seed >> 12) % 50, (seed >> 18) % 200,
+                     channel[(seed >> 26) % 4], 20260000 + i);
+            lines.push_back(text);
+            builder.add(text);
+        }
+        std::string path = "/tmp/semver-bench-" + std::to_string(getpid()) + ".svix";
+        builder.write(path.c_str());
+
+        // What workers did before: parse the catalog and sort it at startup
+        BenchClock::time_point t0 = BenchClock::now();
+        std::vector<SemVer> parsed;
+        parsed.reserve(lines.size());
+        for (size_t i = 0; i < lines.size(); i++) parsed.push_back(SemVer(lines[i].c_str()));
+        std::sort(parsed.begin(), parsed.end(), [](const SemVer& a, const SemVer& b) { return a.compareTotal(b) < 0; });
+        BenchClock::time_point t1 = BenchClock::now();
+        VersionIndex index;
+        index.map(path.c_str());
+        BenchClock::time_point t2 = BenchClock::now();
+        VersionIndex unchecked;
+        unchecked.map(path.c_str(), false);
+        BenchClock::time_point t3 = BenchClock::now();
+
+        std::vector<SemVer> probes;
+        for (size_t i = 0; i < lines.size(); i += 97) probes.push_back(SemVer(lines[i].c_str()));
+        BenchClock::time_point t4 = BenchClock::now();
+        for (size_t q = 0; q < probes.size(); q++) benchSink += index.find(probes[q]);
+        BenchClock::time_point t5 = BenchClock::now();
+        for (size_t q = 0; q < probes.size(); q++) benchSink += index.latest("rc", probes[q].major);
+        BenchClock::time_point t6 = BenchClock::now();
+
+        benchSink += parsed.size() + index.size();
+        report("parse + sort text catalog", nsPerOp(t0, t1, 1));
+        report("map() with checksum", nsPerOp(t1, t2, 1));
+        report("map() without checksum", nsPerOp(t2, t3, 1));
+        report("VersionIndex::find()", nsPerOp(t4, t5, probes.size()));
+        report("VersionIndex::latest(channel, major)", nsPerOp(t5, t6, probes.size()));
+        unlink(path.c_str());
+    }
+
+    // --- Dependency resolution ---
+    std::cout << "\n--- Dependency resolution: 50 packages x 500 releases ---" << std::endl;
+    {
+        // Package i depends on packages i+1, i+2 and i+5. A release x.y.z requires
+        // ^x.(y/2).0 of each, except that x.9.z already moved to the next major of
+        // its dependencies, so the newest releases disagree and force backtracking.
+        const int packages = 50;
+        static const int offsets[] = { 1, 2, 5 };
+        DependencyResolver resolver;
+        for (int p = 0; p < packages; p++) {
+            char name[16];
+            snprintf(name, sizeof(name), "module-%02d", p);
+            resolver.addPackage(name);
+        }
+        BenchClock::time_point t0 = BenchClock::now();
+        size_t edges = 0;
+        for (int p = 0; p < packages; p++) {
+            for (int major = 1; major <= 5; major++) {
+                for (int minor = 0; minor < 10; minor++) {
+                    for (int patch = 0; patch < 10; patch++) {
+                        char text[32];
+                        snprintf(text, sizeof(text), "%d.%d.%d", major, minor, patch);
+                        SemVer release(text);
+                        resolver.addRelease(p, release);
+                        for (int k = 0; k < 3 && p + offsets[k] < packages; k++) {
+                            int depMajor = minor == 9 && major < 5 ? major + 1 : major;
+                            snprintf(text, sizeof(text), "%d.%d.0", depMajor, minor / 2);
+                            resolver.addDependency(p, release, p + offsets[k], SemVer(text));
+                            edges++;
+                        }
+                    }
+                }
+            }
+        }
+        BenchClock::time_point t1 = BenchClock::now();
+
+        std::vector<DependencyResolver::Requirement> roots;
+        for (int p = 0; p < 3; p++) {
+            DependencyResolver::Requirement r = { (uint32_t)p, SemVer(p == 1 ? "4.2.0" : "4.0.0") };
+            roots.push_back(r);
+        }
+        DependencyResolver::Status first = resolver.resolve(roots);
+        BenchClock::time_point t2 = BenchClock::now();
+        const int repeats = 20;
+        for (int i = 0; i < repeats; i++) benchSink += resolver.resolve(roots);
+        BenchClock::time_point t3 = BenchClock::now();
+
+        size_t picked = 0;
+        for (int p = 0; p < packages; p++) picked += resolver.selected(p).isValid();
+        std::cout << "  catalog: " << packages * 500 << " releases, " << edges << " requirements, built in "
+                  << std::setprecision(1) << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+        std::cout << "  first resolve (sorts catalogs, builds bitsets): " << std::setprecision(2)
+                  << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+        std::cout << "  resolve: " << std::chrono::duration<double, std::milli>(t3 - t2).count() / repeats << " ms, "
+                  << (first == DependencyResolver::RESOLVED ? "resolved " : "FAILED ") << picked << " packages, "
+                  << resolver.steps() << " releases tried, " << resolver.memoHits() << " memo hits" << std::endl;
+
+        // Pinning the last module to an older major leaves no solution
+        DependencyResolver::Requirement pin = { (uint32_t)(packages - 1), SemVer("3.0.0") };
+        roots.push_back(pin);
+        BenchClock::time_point t4 = BenchClock::now();
+        DependencyResolver::Status pinned = resolver.resolve(roots);
+        BenchClock::time_point t5 = BenchClock::now();
+        std::cout << "  unsatisfiable: " << std::chrono::duration<double, std::milli>(t5 - t4).count() << " ms, "
+                  << (pinned == DependencyResolver::UNSATISFIABLE ? "proven " : "NOT PROVEN ")
+                  << resolver.steps() << " releases tried, " << resolver.memoHits() << " memo hits" << std::endl;
+    }
+
+    std::cout << "\n(sink " << benchSink << ")" << std::endl;
+    return 0;
+}
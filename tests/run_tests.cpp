@@ -2,6 +2,8 @@
 #include <string>
 #include <vector>
 #include <cstring>
+#include <thread>
+#include <dirent.h>
 
 // Include local mock Arduino environment
 #include "Arduino.h"
@@ -11,6 +13,25 @@
 // The library header will include <Arduino.h>, which we want to resolve to our mock.
 // We will handle this by adding -I. to the compiler flags.
 #include "../src/SemVerChecker.cpp"
+#include "../src/SemVerStats.cpp"
+#include "../src/SemVerManifestSelector.cpp"
+#include "../src/SemVerUpgradePlanner.cpp"
+#include "../src/SemVerCache.cpp"
+#include "../src/SemVerChannelTracker.cpp"
+#include "../src/SemVerPublished.h"
+#include "../src/SemVerDecisionTable.cpp"
+#include "../src/SemVerRange.cpp"
+#include "../src/SemVerAdvisoryIndex.cpp"
+#include "../src/SemVerFleetJoin.cpp"
+#include "../src/SemVerHistogram.cpp"
+#include "../src/SemVerRegistry.cpp"
+#include "../src/SemVerExternalSort.cpp"
+#include "../src/SemVerPipeline.cpp"
+#include "../src/SemVerResolver.cpp"
+#include "../src/SemVerPrereleaseIndex.cpp"
+#include "../src/SemVerBuildMetadata.cpp"
+#include "../src/SemVerCompressedCatalog.cpp"
+#include "../src/SemVerVersionIndex.cpp"
 
 int testsPassed = 0;
 int testsFailed = 0;
@@ -101,6 +122,52 @@ int main() {
         assert(v1 < v2, "1.0.0-alpha < 1.0.0-alpha.1");
     }
 
+    // --- Total Order Tests ---
+    std::cout << "\n--- Total Order Tests ---" << std::endl;
+    {
+        SemVer a("1.0.0+a"), b("1.0.0+b"), plain("1.0.0");
+        assert(a == b && a.compareTotal(b) < 0 && b.compareTotal(a) > 0, "Build metadata breaks precedence ties");
+        assert(plain.compareTotal(a) < 0 && a.compareTotal(SemVer("1.0.0+a")) == 0, "No build sorts first; same build equal");
+        assert(SemVer("1.0.0-rc.1+z").compareTotal(a) < 0, "Precedence decides before build metadata");
+        assert(SemVer("x").compareTotal(SemVer("0.0.0")) < 0 && SemVer("x").compareTotal(SemVer("y")) == 0, "Invalid sorts first");
+        assert(a.hashTotal() != b.hashTotal() && a.hashTotal() == SemVer("1.0.0+a").hashTotal(), "hashTotal() sees build metadata");
+        assert(SemVer("1.0.0-a").hashTotal() != SemVer("1.0.0+a").hashTotal(), "Pre-release and build hash differently");
+
+        uint8_t key[SemVer::MAX_SORT_KEY_LEN];
+        assertEqual(SemVer("x").sortKey(key, sizeof(key)), 0, "Invalid version has no key");
+        assertEqual(plain.sortKey(key, 12), 0, "Too small a buffer");
+        assertEqual(plain.sortKey(key, 13), 13, "Release key is the core plus one byte");
+
+        // Every pair: compareTotal(), sortKey() and hashTotal() agree with each other and with precedence
+        const char* versions[] = { "0.9.9", "1.0.0-0", "1.0.0-1", "1.0.0-2", "1.0.0-11", "1.0.0-a", "1.0.0-a.1", "1.0.0-a.b",
+                                   "1.0.0-a-", "1.0.0-ab", "1.0.0-alpha", "1.0.0-alpha+a", "1.0.0-alpha.0", "1.0.0-rc.1",
+                                   "1.0.0-rc.10", "1.0.0", "1.0.0+0", "1.0.0+a", "1.0.0+a-", "1.0.0+a.b", "1.0.0+b", "1.0.1-rc.1",
+                                   "1.0.1", "1.2.0", "2.0.0-0a", "255.0.0", "256.0.0", "4294967295.4294967295.4294967295" };
+        const int n = sizeof(versions) / sizeof(versions[0]);
+        int mismatches = 0;
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                SemVer x(versions[i]), y(versions[j]);
+                uint8_t kx[SemVer::MAX_SORT_KEY_LEN], ky[SemVer::MAX_SORT_KEY_LEN];
+                size_t lx = x.sortKey(kx, sizeof(kx)), ly = y.sortKey(ky, sizeof(ky));
+                int c = memcmp(kx, ky, lx < ly ? lx : ly);
+                int byKey = c != 0 ? (c < 0 ? -1 : 1) : (lx == ly ? 0 : (lx < ly ? -1 : 1));
+                int total = x.compareTotal(y);
+                int precedence = x < y ? -1 : (y < x ? 1 : 0);
+                if (total != (i < j ? -1 : (i > j ? 1 : 0)) || byKey != total) mismatches++;
+                if (precedence != 0 && precedence != total) mismatches++;
+                if ((total == 0) != (x.hashTotal() == y.hashTotal())) mismatches++;
+            }
+        }
+        assertEqual(mismatches, 0, "compareTotal(), sortKey() and hashTotal() agree for all pairs");
+
+        char longPre[SemVer::MAX_VERSION_LEN + 1] = "1.0.0-";
+        while (strlen(longPre) < SemVer::MAX_VERSION_LEN) strcat(longPre, strlen(longPre) % 2 ? "." : "1");
+        if (longPre[strlen(longPre) - 1] == '.') longPre[strlen(longPre) - 1] = '\0';
+        SemVer worst(longPre);
+        assert(worst.isValid() && worst.sortKey(key, sizeof(key)) > 0, "Worst-case key fits MAX_SORT_KEY_LEN");
+    }
+
     // --- isUpgrade Tests ---
     std::cout << "\n--- isUpgrade Tests ---" << std::endl;
     assert(SemVer::isUpgrade("1.0.0", "1.0.1"), "isUpgrade(1.0.0, 1.0.1) -> true");
@@ -316,6 +383,17 @@ int main() {
         assert(v6 < v7, "beta.11 < rc.1");
         assert(v7 < v8, "rc.1 < 1.0.0");
     }
+    {
+        // Shared helpers used by the catalog, index and sorter components
+        assertEqual(SemVer::compareIdentifier("2", 1, "11", 2), -1, "compareIdentifier numeric by value");
+        assertEqual(SemVer::compareIdentifier("11", 2, "alpha", 5), -1, "compareIdentifier numeric below alphanumeric");
+        assertEqual(SemVer::compareIdentifier("beta", 4, "alpha", 5), 1, "compareIdentifier alphanumeric by bytes");
+        assertEqual(SemVer::compareIdentifier("rc", 2, "rc1", 3), -1, "compareIdentifier shorter prefix first");
+        assertEqual(SemVer::comparePrerelease("alpha.1", 7, "alpha.1", 7), 0, "comparePrerelease equal");
+        assertEqual(SemVer::comparePrerelease("alpha", 5, "alpha.1", 7), -1, "comparePrerelease more identifiers rank higher");
+        assertEqual(SemVer::comparePrerelease("beta.11", 7, "beta.2", 6), 1, "comparePrerelease numeric field");
+        assertEqual(SemVer::comparePrerelease("rc.1.x", 4, "rc.1", 4), 0, "comparePrerelease honours the lengths");
+    }
     {
         SemVer v1("1.2.3-alpha-beta"); // Identifiers with dashes
         assert(v1.isValid(), "Dashes in prerelease are valid");
@@ -868,6 +946,1717 @@ int main() {
         assertString(v.getBuild(), "", "Default build is empty");
     }
 
+    // --- Parse Error Reporting Tests ---
+    std::cout << "\n--- Parse Error Reporting Tests ---" << std::endl;
+    {
+        struct ErrorCase {
+            const char* input;
+            SemVer::ParseError error;
+            unsigned offset;
+        };
+        const ErrorCase cases[] = {
+            { "1.2.3-rc.1+b.7",        SemVer::PARSE_OK,               0 },
+            { "",                      SemVer::PARSE_EMPTY,            0 },
+            { "1.2",                   SemVer::PARSE_MISSING_PART,     3 },
+            { "1",                     SemVer::PARSE_MISSING_PART,     1 },
+            { ".1.2",                  SemVer::PARSE_EMPTY_IDENTIFIER, 0 },
+            { "1..2",                  SemVer::PARSE_EMPTY_IDENTIFIER, 2 },
+            { "1.2.",                  SemVer::PARSE_EMPTY_IDENTIFIER, 4 },
+            { "01.2.3",                SemVer::PARSE_LEADING_ZERO,     0 },
+            { "1.2.03",                SemVer::PARSE_LEADING_ZERO,     4 },
+            { "1.0.0-alpha.01",        SemVer::PARSE_LEADING_ZERO,     12 },
+            { "1.2.3.4",               SemVer::PARSE_INVALID_CHAR,     5 },
+            { " 1.0.0",                SemVer::PARSE_INVALID_CHAR,     0 },
+            { "1.x.0",                 SemVer::PARSE_INVALID_CHAR,     2 },
+            { "1.0.0-alpha_beta",      SemVer::PARSE_INVALID_CHAR,     11 },
+            { "1.0.0+build@123",       SemVer::PARSE_INVALID_CHAR,     11 },
+            { "9.8.7+meta+meta",       SemVer::PARSE_INVALID_CHAR,     10 },
+            { "1.0.0-",                SemVer::PARSE_EMPTY_IDENTIFIER, 6 },
+            { "1.0.0+",                SemVer::PARSE_EMPTY_IDENTIFIER, 6 },
+            { "1.0.0-alpha..1",        SemVer::PARSE_EMPTY_IDENTIFIER, 12 },
+            { "1.0.0-alpha.",          SemVer::PARSE_EMPTY_IDENTIFIER, 12 },
+            { "1.0.0+build..1",        SemVer::PARSE_EMPTY_IDENTIFIER, 12 },
+            { "4294967296.0.0",        SemVer::PARSE_OVERFLOW,         9 },
+            { "1.99999999999.0-a..b",  SemVer::PARSE_OVERFLOW,         11 },
+        };
+        for (const ErrorCase& c : cases) {
+            SemVer::ParseResult r;
+            SemVer v(c.input, r);
+            String msg = "ParseResult for '";
+            msg += c.input;
+            msg += "'";
+            assert(r.error == c.error && r.offset == c.offset && v.isValid() == r.ok(), msg.c_str());
+
+            SemVer::ParseResult vr = SemVer::validate(c.input, strlen(c.input));
+            msg += " matches validate()";
+            assert(vr.error == r.error && vr.offset == r.offset, msg.c_str());
+        }
+    }
+    {
+        String longVer = "1.2.3-";
+        for (int i = 0; i < 100; i++) longVer += "a";
+        SemVer::ParseResult r;
+        SemVer v(longVer, r);
+        assert(r.error == SemVer::PARSE_TOO_LONG, "ParseResult too long (String)");
+        assertEqual(r.offset, SemVer::MAX_VERSION_LEN, "ParseResult too long offset");
+
+        SemVer n(NULL, r);
+        assert(r.error == SemVer::PARSE_EMPTY && !n.isValid(), "ParseResult NULL input");
+    }
+
+    // --- validate() Tests ---
+    std::cout << "\n--- validate() Tests ---" << std::endl;
+    {
+        assert(SemVer::validate("1.2.3-rc.1+build.5").ok(), "validate() accepts valid version");
+        assert(!SemVer::validate("1.2.3-rc.01").ok(), "validate() rejects leading zero");
+        assert(SemVer::validate(NULL).error == SemVer::PARSE_EMPTY, "validate(NULL) is PARSE_EMPTY");
+        assert(SemVer::validate("", 0).error == SemVer::PARSE_EMPTY, "validate() empty range is PARSE_EMPTY");
+
+        const char header[] = "2.0.1-beta;garbage";
+        assert(SemVer::validate(header, 10).ok(), "validate() honours explicit length");
+        assert(!SemVer::validate(header, 11).ok(), "validate() sees byte after length limit");
+
+        const char withNul[] = "1.2.3\0";
+        SemVer::ParseResult r = SemVer::validate(withNul, sizeof(withNul));
+        assert(r.error == SemVer::PARSE_INVALID_CHAR && r.offset == 5, "validate() rejects embedded NUL");
+
+        std::string huge(10000, '1');
+        r = SemVer::validate(huge.data(), huge.size());
+        assert(r.error == SemVer::PARSE_TOO_LONG, "validate() rejects overlong input up front");
+    }
+    {
+        // validate() and the constructor share one scanner; spot-check agreement
+        const char* inputs[] = {
+            "0.0.4", "1.0.0-alpha.beta.1", "1.0.0+0.build.1-rc.10000aaa-kk-0.1", "1.2.3----RC-SNAPSHOT.12.9.1--.12+788",
+            "1.2-SNAPSHOT", "1.2.31.2.3----RC-SNAPSHOT.12.09.1--..12+788", "-1.0.3-gamma+b7718", "1.0.0-alpha_beta",
+            "1.1.2+.123", "alpha.beta.1", "1.2.3.DEV", "9.8.7-whatever+meta+meta"
+        };
+        bool agree = true;
+        for (const char* in : inputs) {
+            if (SemVer::validate(in).ok() != SemVer(in).isValid()) agree = false;
+        }
+        assert(agree, "validate() agrees with constructor");
+    }
+
+    // --- Flash String (PROGMEM) Tests ---
+    std::cout << "\n--- Flash String (PROGMEM) Tests ---" << std::endl;
+    {
+        unsigned long before = pgmReadCount();
+        SemVer v = SemVer::fromFlash(F("2.5.3-rc.1+build.789"));
+        assert(v.isValid(), "fromFlash() parses valid version");
+        assertString(v.toString(), "2.5.3-rc.1+build.789", "fromFlash() round-trips");
+        assert(pgmReadCount() - before >= 20, "fromFlash() reads input through pgm_read_byte");
+
+        SemVer::ParseResult r;
+        SemVer bad = SemVer::fromFlash(F("1.2.03"), r);
+        assert(r.error == SemVer::PARSE_LEADING_ZERO && r.offset == 4 && !bad.isValid(), "fromFlash() reports parse errors");
+
+        String longVer = "1.2.3-";
+        for (int i = 0; i < 100; i++) longVer += "a";
+        before = pgmReadCount();
+        SemVer tooLong = SemVer::fromFlash(F(longVer.c_str()), r);
+        assert(r.error == SemVer::PARSE_TOO_LONG && !tooLong.isValid(), "fromFlash() rejects overlong input");
+        assertEqual(pgmReadCount() - before, SemVer::MAX_VERSION_LEN + 1, "fromFlash() stops reading after MAX_VERSION_LEN");
+
+        const __FlashStringHelper* nullFlash = NULL;
+        assert(!SemVer::fromFlash(nullFlash).isValid(), "fromFlash(NULL) is invalid");
+
+        // NULL literals still pick the const char* overloads
+        assert(!SemVer(NULL).isValid(), "SemVer(NULL) is invalid");
+        assert(!SemVer::isUpgrade(NULL, "1.0.0"), "isUpgrade(NULL, ...) is false");
+    }
+    {
+        assert(SemVer::isUpgrade_P(F("2.1.5"), "2.1.6"), "isUpgrade_P(F, const char*)");
+        assert(!SemVer::isUpgrade_P(F("2.3.0"), "2.1.5"), "isUpgrade_P downgrade");
+        assert(!SemVer::isUpgrade_P(F("bogus"), "2.1.6"), "isUpgrade_P with invalid base");
+        assert(!SemVer::isUpgrade_P(F("2.1.5"), NULL), "isUpgrade_P with NULL new version");
+
+        SemVer installed("2.1.3");
+        assert(installed.satisfies(F("2.0.0")), "satisfies(F()) compatible");
+        assert(!installed.satisfies(F("1.5.0")), "satisfies(F()) major mismatch");
+        assert(SemVer("2.2.0-beta").satisfies(F("2.0.0"), true), "satisfies(F(), includePrerelease)");
+    }
+
+    // --- Channel Tests ---
+    std::cout << "\n--- Channel Tests ---" << std::endl;
+    {
+        assert(SemVer("1.2.0-beta.3").isChannel("beta"), "1.2.0-beta.3 is in channel beta");
+        assert(SemVer("1.2.0-rc").isChannel("rc"), "1.2.0-rc is in channel rc");
+        assert(!SemVer("1.2.0-beta2").isChannel("beta"), "beta2 is not channel beta");
+        assert(!SemVer("1.2.0-be").isChannel("beta"), "be is not channel beta");
+        assert(SemVer("1.2.0").isChannel(""), "Stable release is channel \"\"");
+        assert(!SemVer("1.2.0-rc.1").isChannel(""), "Prerelease is not stable channel");
+        assert(!SemVer("bogus").isChannel(""), "Invalid version has no channel");
+    }
+
+    // --- Manifest Selector Tests ---
+    std::cout << "\n--- Manifest Selector Tests ---" << std::endl;
+    {
+        struct Entry {
+            const char* version;
+            const char* target;
+        };
+        const Entry manifest[] = {
+            { "2.3.0",        "esp32" },
+            { "2.4.0-beta.1", "esp32" },
+            { "2.9.0",        "esp8266" },
+            { "3.0.0",        "esp32" },
+            { "2.3.5",        "esp32" },
+            { "2.5.0-rc.2",   "esp32" },
+            { "garbage",      "esp32" },
+            { "2.0.0",        NULL },
+            { "2.3.4",        NULL },
+        };
+        const uint32_t count = sizeof(manifest) / sizeof(manifest[0]);
+
+        ManifestSelector stable(SemVer("2.1.5"));
+        stable.setTarget("esp32");
+        stable.setRange(SemVer("2.1.5"));
+        for (uint32_t i = 0; i < count; i++) stable.offer(manifest[i].version, manifest[i].target, i);
+        assert(stable.hasSelection(), "Stable selector found an update");
+        assertString(stable.selected().toString(), "2.3.5", "Stable selector picks newest compatible stable");
+        assertEqual(stable.selectedToken(), 4, "Stable selector keeps artifact token");
+        assertEqual(stable.offered(), count, "Selector counts offered entries");
+
+        ManifestSelector beta(SemVer("2.1.5"));
+        beta.setTarget("esp32");
+        beta.setRange(SemVer("2.1.5"));
+        assert(beta.acceptChannel("beta"), "Selector accepts channel");
+        for (uint32_t i = 0; i < count; i++) beta.offer(manifest[i].version, manifest[i].target, i);
+        assertString(beta.selected().toString(), "2.4.0-beta.1", "Beta selector skips rc channel");
+
+        beta.reset();
+        beta.acceptAllChannels();
+        for (uint32_t i = 0; i < count; i++) beta.offer(manifest[i].version, manifest[i].target, i);
+        assertString(beta.selected().toString(), "2.5.0-rc.2", "Any-channel selector picks rc");
+
+        ManifestSelector major(SemVer("2.1.5"));
+        for (uint32_t i = 0; i < count; i++) major.offer(manifest[i].version, manifest[i].target, i);
+        assertString(major.selected().toString(), "3.0.0", "No range or target: newest stable wins");
+
+        ManifestSelector none(SemVer("3.0.0"));
+        for (uint32_t i = 0; i < count; i++) none.offer(manifest[i].version, manifest[i].target, i);
+        assert(!none.hasSelection(), "Up-to-date device gets no selection");
+        assert(!none.selected().isValid(), "No selection is invalid version");
+    }
+    {
+        ManifestSelector s(SemVer("1.0.0"));
+        assert(s.offer(SemVer("1.1.0")), "offer(SemVer) selects newer");
+        assert(!s.offer(SemVer("1.0.5")), "offer(SemVer) ignores older than best");
+        assert(!s.offer(NULL), "offer(NULL) rejected");
+        for (int i = 0; i < SEMVER_MAX_CHANNELS; i++) s.acceptChannel("x");
+        assert(!s.acceptChannel("overflow"), "acceptChannel bounded by SEMVER_MAX_CHANNELS");
+    }
+
+#ifdef SEMVER_STATS
+    // --- Instrumentation Tests ---
+    std::cout << "\n--- Instrumentation Tests ---" << std::endl;
+    {
+        SemVerStats::reset();
+        SemVer a("1.0.0-alpha");
+        SemVer b("1.0.0-beta");
+        SemVer c("2.0.0");
+        SemVer bad("1.0");
+        assertEqual(SemVerStats::snapshot().counters[SemVerStats::PARSES], 4, "Stats count parses");
+        assertEqual(SemVerStats::snapshot().counters[SemVerStats::INVALID_INPUTS], 1, "Stats count invalid inputs");
+
+        bool lt = a < b;   // Equal cores: slow path + prerelease compare
+        lt = a < c;        // Fast path
+        (void)lt;
+        SemVerStats::Snapshot s = SemVerStats::snapshot();
+        assertEqual(s.counters[SemVerStats::COMPARISONS], 2, "Stats count comparisons");
+        assertEqual(s.counters[SemVerStats::SLOW_COMPARISONS], 1, "Stats count slow comparisons");
+        assertEqual(s.counters[SemVerStats::PRERELEASE_COMPARES], 1, "Stats count prerelease compares");
+
+        c.satisfies(SemVer("2.0.0"));
+        char buf[16];
+        c.toString(buf, sizeof(buf));
+        s = SemVerStats::snapshot();
+        assertEqual(s.counters[SemVerStats::SATISFIES_CALLS], 1, "Stats count satisfies");
+        assertEqual(s.counters[SemVerStats::TO_STRING_CALLS], 1, "Stats count toString");
+#ifdef SEMVER_STATS_TIMING
+        assert(s.cycles[SemVerStats::TIME_PARSE] > 0, "Stats accumulate parse cycles");
+#endif
+        SemVerStats::reset();
+        assertEqual(SemVerStats::snapshot().counters[SemVerStats::PARSES], 0, "Stats reset");
+    }
+
+#endif
+    // --- Upgrade Planner Tests ---
+    std::cout << "\n--- Upgrade Planner Tests ---" << std::endl;
+    {
+        std::vector<SemVer> catalog;
+        const char* releases[] = {
+            "3.1.0", "1.4.0", "2.0.0", "1.5.2", "2.3.1", "3.0.0", "3.2.0-beta.1", "bogus", "2.0.0"
+        };
+        for (const char* r : releases) catalog.push_back(SemVer(r));
+
+        std::vector<SemVer> stones;
+        stones.push_back(SemVer("3.0.0"));
+        stones.push_back(SemVer("2.0.0"));
+        stones.push_back(SemVer("2.5.0")); // Not in catalog, ignored
+
+        UpgradePlanner planner;
+        assertEqual(planner.publish(catalog, stones), 2, "Planner keeps stepping stones present in catalog");
+        assertString(planner.latest().toString(), "3.1.0", "Planner latest skips prerelease by default");
+
+        UpgradePlanner::Chain chain = planner.plan(SemVer("1.4.0"));
+        assertEqual(chain.count, 3, "1.4.0 chain has 3 hops");
+        assertString(chain[0].toString(), "2.0.0", "1.4.0 first hop is 2.0.0");
+        assertString(chain[1].toString(), "3.0.0", "1.4.0 second hop is 3.0.0");
+        assertString(chain[2].toString(), "3.1.0", "1.4.0 final hop is latest");
+
+        chain = planner.plan(SemVer("2.0.0"));
+        assertEqual(chain.count, 2, "Chain from a stepping stone skips it");
+        assertString(chain[0].toString(), "3.0.0", "2.0.0 first hop is 3.0.0");
+
+        chain = planner.plan(SemVer("2.0.0-rc.1"));
+        assertString(chain[0].toString(), "2.0.0", "Prerelease of a stepping stone must still pass it");
+
+        chain = planner.plan(SemVer("3.0.5"));
+        assertEqual(chain.count, 1, "Past all stones: direct hop to latest");
+        assert(planner.plan(SemVer("3.1.0")).empty(), "Up to date: empty chain");
+        assert(planner.plan(SemVer("4.0.0")).empty(), "Newer than latest: empty chain");
+        assert(planner.plan(SemVer("invalid")).empty(), "Invalid start: empty chain");
+        assert(planner.nextHop(SemVer("3.1.0")) == NULL, "nextHop NULL when up to date");
+        assertString(planner.nextHop(SemVer("0.9.0"))->toString(), "2.0.0", "nextHop from 0.9.0");
+
+        assertEqual(planner.publish(catalog, stones, true), 2, "Planner republish with prereleases");
+        assertString(planner.latest().toString(), "3.2.0-beta.1", "Planner latest includes prerelease when allowed");
+    }
+    {
+        UpgradePlanner planner;
+        assert(!planner.latest().isValid(), "Unpublished planner latest is invalid");
+        assert(planner.plan(SemVer("1.0.0")).empty(), "Unpublished planner gives empty chain");
+        std::vector<SemVer> none;
+        assertEqual(planner.publish(none, none), 0, "Empty catalog publishes nothing");
+    }
+
+    // --- Parse Cache Tests ---
+    std::cout << "\n--- Parse Cache Tests ---" << std::endl;
+    {
+        SemVerCache cache(2);
+        SemVer v = cache.parse("1.2.3-beta.1+build.7");
+        assert(v.isValid(), "Cache miss returns parsed version");
+        assertString(v.getPrerelease(), "beta.1", "Cached prerelease");
+        assertString(v.getBuild(), "build.7", "Cached build");
+
+        v = cache.parse("1.2.3-beta.1+build.7");
+        assert(v == SemVer("1.2.3-beta.1"), "Cache hit returns same version");
+        assertEqual(cache.stats().hits, 1, "Cache counts hit");
+        assertEqual(cache.stats().misses, 1, "Cache counts miss");
+
+        assert(!cache.parse("01.0.0").isValid(), "Cache returns invalid on miss");
+        assert(!cache.parse("01.0.0").isValid(), "Cache returns invalid on hit");
+        assertEqual(cache.stats().hits, 2, "Invalid inputs are cached too");
+
+        cache.parse("1.2.3-beta.1+build.7"); // Touch: 01.0.0 becomes LRU
+        cache.parse("2.0.0");
+        assertEqual(cache.size(), 2, "Cache size bounded by capacity");
+        assertEqual(cache.stats().evictions, 1, "Cache counts eviction");
+        cache.parse("1.2.3-beta.1+build.7");
+        assertEqual(cache.stats().hits, 4, "Recently used entry survived eviction");
+        cache.parse("01.0.0");
+        assertEqual(cache.stats().misses, 4, "LRU entry was evicted");
+    }
+    {
+        SemVerCache cache(8);
+        const char raw[] = "1.2.3\0junk";
+        assert(!cache.parse(raw, sizeof(raw) - 1).isValid(), "Cache rejects embedded NUL");
+        assert(cache.parse("3.4.5-rc.1 trailing", 10) == SemVer("3.4.5-rc.1"), "Cache parses byte range");
+        assert(!cache.parse(NULL).isValid(), "Cache handles NULL");
+        assert(!cache.parse("", 0).isValid(), "Cache handles empty input");
+
+        String longVer = "1.2.3-";
+        for (int i = 0; i < 100; i++) longVer += "a";
+        assert(!cache.parse(longVer.c_str()).isValid(), "Cache rejects overlong input");
+        cache.clear();
+        assertEqual(cache.size(), 0, "Cache clear empties entries");
+        assert(cache.parse("1.0.0").isValid(), "Cache usable after clear");
+    }
+    {
+        ShardedSemVerCache cache(64, 4);
+        assertEqual(cache.shardCount(), 4, "Sharded cache shard count");
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; t++) {
+            workers.push_back(std::thread([&cache]() {
+                char buf[16];
+                for (int i = 0; i < 1000; i++) {
+                    snprintf(buf, sizeof(buf), "1.%d.0", i % 20);
+                    cache.parse(buf);
+                }
+            }));
+        }
+        for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+
+        SemVerCache::Stats s = cache.stats();
+        assertEqual(s.hits + s.misses, 4000, "Sharded cache counts every lookup");
+        assert(s.misses >= 20 && s.misses <= 80, "Sharded cache mostly hits on repeated inputs");
+        assert(cache.parse("1.7.0") == SemVer("1.7.0"), "Sharded cache returns parsed version");
+        assert(cache.size() >= 20, "Sharded cache holds distinct inputs");
+    }
+    {
+        // Four entries per shard: if only 256 of the 1024 shards were reachable,
+        // at most 1024 of the 4096 inputs could stay cached
+        ShardedSemVerCache cache(4096, 1024);
+        char buf[16];
+        for (int i = 0; i < 4096; i++) {
+            snprintf(buf, sizeof(buf), "%d.%d.0", i / 64, i % 64);
+            cache.parse(buf);
+        }
+        assert(cache.size() > 2048, "Sharded cache spreads inputs over more than 256 shards");
+    }
+
+    // --- Channel Tracker Tests ---
+    std::cout << "\n--- Channel Tracker Tests ---" << std::endl;
+    {
+        ChannelTracker tracker;
+        const char* releases[] = {
+            "3.0.0", "3.1.0-beta.1", "2.9.4", "3.1.0-rc.1", "3.0.2", "4.0.0-beta.2",
+            "3.1.0-beta.3", "2.9.1", "bogus", "4.0.0-beta.1"
+        };
+        for (const char* r : releases) tracker.publish(SemVer(r));
+
+        assertString(tracker.latest("").toString(), "3.0.2", "Latest stable");
+        assertString(tracker.latest("beta").toString(), "4.0.0-beta.2", "Latest beta across majors");
+        assertString(tracker.latest("beta", 3).toString(), "3.1.0-beta.3", "Latest beta in 3.x");
+        assertString(tracker.latest("rc", 3).toString(), "3.1.0-rc.1", "Latest rc in 3.x");
+        assertString(tracker.latest("", 2).toString(), "2.9.4", "Latest stable in 2.x");
+        assert(!tracker.latest("rc", 4).isValid(), "No rc in 4.x");
+        assert(!tracker.latest("alpha").isValid(), "Unknown channel");
+        assert(!tracker.latest(NULL).isValid(), "NULL channel");
+
+        assert(tracker.publish(SemVer("3.0.3")), "Newer stable is published");
+        assert(!tracker.publish(SemVer("3.0.1")), "Older stable is not latest");
+        assert(!tracker.publish(SemVer("1.0.0-averyveryverylongchannel")), "Overlong channel rejected");
+        assertEqual(tracker.size(), 8, "One entry per (channel, major) plus one per channel");
+
+        ChannelTracker small(2);
+        assert(small.publish(SemVer("1.0.0")), "Small tracker accepts first release");
+        assert(!small.publish(SemVer("1.0.0-rc.1")), "Full tracker rejects new channel");
+        assertEqual(small.size(), 2, "Full tracker stays at capacity");
+
+        // One slot left: a new channel needs two, so neither view changes
+        ChannelTracker three(3);
+        assert(three.publish(SemVer("1.0.0")), "Tracker of three accepts first release");
+        assert(!three.publish(SemVer("1.0.0-beta.1")), "Release needing two entries rejected with one left");
+        assert(!three.latest("beta", 1).isValid() && !three.latest("beta").isValid(), "Rejected release in neither view");
+        assertEqual(three.size(), 2, "Rejected release takes no entry");
+        assert(three.publish(SemVer("2.0.0")), "Release needing one entry fills the tracker");
+        assertEqual(three.size(), 3, "Tracker filled to capacity");
+        assert(three.publish(SemVer("2.0.1")), "Existing entries still update when full");
+        assertString(three.latest("").toString(), "2.0.1", "Channel-wide entry updated when full");
+
+        // The channel-wide entry is not keyed by a major, so the highest major is an ordinary one
+        ChannelTracker top;
+        assert(top.publish(SemVer("1.0.0")), "Stable 1.x published");
+        assert(!top.latest("", 0xFFFFFFFFu).isValid(), "No release with major 4294967295");
+        assert(top.publish(SemVer("4294967295.0.0")), "Major 4294967295 published");
+        assertString(top.latest("", 0xFFFFFFFFu).toString(), "4294967295.0.0", "Latest with major 4294967295");
+        assertEqual(top.size(), 3, "Major 4294967295 has its own entry");
+    }
+    {
+        // Readers must only ever see published values, never a half-written one
+        ChannelTracker tracker;
+        std::atomic<bool> done(false);
+        std::atomic<int> torn(0);
+        std::atomic<int> regressions(0);
+
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; t++) {
+            readers.push_back(std::thread([&]() {
+                uint32_t last = 0;
+                while (!done.load()) {
+                    SemVer v = tracker.latest("beta", 1);
+                    if (!v.isValid()) continue;
+                    // Writer publishes 1.<n>.<n>-beta.<n>
+                    char expected[48];
+                    snprintf(expected, sizeof(expected), "1.%u.%u-beta.%u", v.minor, v.minor, v.minor);
+                    char actual[48];
+                    v.toString(actual, sizeof(actual));
+                    if (v.patch != v.minor || strcmp(expected, actual) != 0) torn++;
+                    if (v.minor < last) regressions++;
+                    last = v.minor;
+                }
+            }));
+        }
+        for (uint32_t n = 1; n <= 20000; n++) {
+            char text[48];
+            snprintf(text, sizeof(text), "1.%u.%u-beta.%u", n, n, n);
+            tracker.publish(SemVer(text));
+        }
+        done.store(true);
+        for (size_t i = 0; i < readers.size(); i++) readers[i].join();
+
+        assertEqual(torn.load(), 0, "Concurrent readers never see torn values");
+        assertEqual(regressions.load(), 0, "Concurrent readers see monotonic latest");
+        assertString(tracker.latest("beta").toString(), "1.20000.20000-beta.20000", "Final latest after concurrent reads");
+    }
+
+    // --- Published Version Tests ---
+    std::cout << "\n--- Published Version Tests ---" << std::endl;
+    {
+        PublishedVersion latest(SemVer("1.0.0"));
+        {
+            PublishedVersion::Snapshot s(latest);
+            assertString(s->toString(), "1.0.0", "Snapshot sees initial value");
+            assert(SemVer("0.9.0") < *s, "Snapshot usable in comparisons");
+        }
+        latest.publish(SemVer("1.1.0"));
+        assertString(latest.load().toString(), "1.1.0", "load() sees published value");
+
+        std::vector<SemVer> releases;
+        releases.push_back(SemVer("2.0.0"));
+        PublishedCatalog catalog;
+        assertEqual(catalog.load().size(), 0, "Catalog starts empty");
+        catalog.publish(releases);
+        PublishedCatalog::Snapshot s(catalog);
+        assertEqual(s->size(), 1, "Catalog snapshot sees published list");
+
+        PublishedVersion* heap = new PublishedVersion(SemVer("1.0.0"));
+        assert((uintptr_t)heap % 64 == 0 && sizeof(PublishedVersion) >= 64 * SEMVER_RCU_STRIPES,
+               "Heap holder stripes on separate cache lines");
+        delete heap;
+    }
+    {
+        // Values are poisoned on destruction; a reader seeing a freed copy would notice
+        struct Tracked {
+            uint32_t alive;
+            uint32_t serial;
+            Tracked() : alive(0xA11FEu), serial(0) {}
+            explicit Tracked(uint32_t n) : alive(0xA11FEu), serial(n) {}
+            ~Tracked() { alive = 0; }
+        };
+        Published<Tracked> holder;
+        std::atomic<bool> done(false);
+        std::atomic<int> bad(0);
+
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; t++) {
+            readers.push_back(std::thread([&]() {
+                uint32_t last = 0;
+                while (!done.load()) {
+                    Published<Tracked>::Snapshot s(holder);
+                    if (s->alive != 0xA11FEu || s->serial < last) bad++;
+                    last = s->serial;
+                    if (s->alive != 0xA11FEu) bad++;
+                }
+            }));
+        }
+        for (uint32_t n = 1; n <= 2000; n++) holder.publish(Tracked(n));
+        done.store(true);
+        for (size_t i = 0; i < readers.size(); i++) readers[i].join();
+
+        assertEqual(bad.load(), 0, "Readers never see a reclaimed value");
+        assertEqual(holder.load().serial, 2000, "Last published value is current");
+    }
+
+    // --- Decision Table Tests ---
+    std::cout << "\n--- Decision Table Tests ---" << std::endl;
+    {
+        std::vector<SemVer> catalog;
+        const char* releases[] = {
+            "1.4.0", "1.4.2", "1.5.0", "2.0.0", "2.0.1", "2.1.0-beta.1", "2.3.0", "2.3.4", "3.0.0-rc.1", "bogus"
+        };
+        for (const char* r : releases) catalog.push_back(SemVer(r));
+
+        UpdatePolicy policy;
+        policy.minimum = SemVer("1.4.2");
+        policy.allowedDiffs = UpdatePolicy::allow(SemVer::MINOR) | UpdatePolicy::allow(SemVer::PATCH);
+
+        DecisionTable table;
+        table.compile(policy, catalog);
+        assertEqual(table.bucketCount(), 4, "One bucket per (major, minor) with a stable release");
+
+        DecisionTable::Decision d = table.decide(SemVer("1.4.1"));
+        assertEqual(d.action, DecisionTable::REQUIRED, "Below minimum is required");
+        assertString(d.target->toString(), "2.3.4", "Required update goes to latest");
+        d = table.decide(SemVer("1.2.0"));
+        assertEqual(d.action, DecisionTable::REQUIRED, "Bucket below minimum is required");
+        d = table.decide(SemVer("1.4.2"));
+        assertString(d.target->toString(), "1.5.0", "Minor update within major");
+        d = table.decide(SemVer("2.0.0"));
+        assertString(d.target->toString(), "2.3.4", "Newest minor within major");
+        d = table.decide(SemVer("2.3.1"));
+        assertString(d.target->toString(), "2.3.4", "Patch update in boundary bucket");
+        d = table.decide(SemVer("2.3.4"));
+        assertEqual(d.action, DecisionTable::UP_TO_DATE, "Latest is up to date");
+        assert(d.target == NULL, "Up to date has no target");
+        d = table.decide(SemVer("1.9.0"));
+        assertEqual(d.action, DecisionTable::UP_TO_DATE, "Major update not allowed");
+        d = table.decide(SemVer("2.2.7"));
+        assertString(d.target->toString(), "2.3.4", "Bucket without releases uses its major");
+        assertEqual(table.decide(SemVer()).action, DecisionTable::INVALID, "Invalid device");
+
+        // Cross-check against a direct scan for many devices and policies
+        uint32_t seed = 12345;
+        std::vector<SemVer> devices;
+        for (int i = 0; i < 3000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char text[40];
+            const char* pre[] = { "", "-beta.1", "-rc.1", "-alpha" };
+            snprintf(text, sizeof(text), "%u.%u.%u%s", (seed >> 8) % 4, (seed >> 12) % 7, (seed >> 16) % 6, pre[(seed >> 20) % 4]);
+            devices.push_back(SemVer(text));
+        }
+
+        int mismatches = 0;
+        const char* minimums[] = { "", "1.4.2", "2.0.0-rc.1", "2.3.0", "9.0.0" };
+        for (int mask = 0; mask < 32; mask += 2) {
+            for (const char* minimum : minimums) {
+                for (int pre = 0; pre < 2; pre++) {
+                    UpdatePolicy p;
+                    p.minimum = SemVer(minimum);
+                    p.allowedDiffs = (uint8_t)mask;
+                    p.includePrerelease = pre != 0;
+                    DecisionTable t;
+                    t.compile(p, catalog);
+
+                    std::vector<SemVer> eligible;
+                    for (size_t i = 0; i < catalog.size(); i++) {
+                        if (catalog[i].isValid() && (pre || catalog[i].getPrerelease()[0] == '\0')) eligible.push_back(catalog[i]);
+                    }
+                    std::sort(eligible.begin(), eligible.end());
+                    SemVer effMin = p.minimum;
+                    if (effMin.isValid() && eligible.back() < effMin) effMin = eligible.back();
+
+                    for (size_t i = 0; i < devices.size(); i++) {
+                        const SemVer& dev = devices[i];
+                        DecisionTable::Action action = DecisionTable::UP_TO_DATE;
+                        const SemVer* target = NULL;
+                        if (effMin.isValid() && dev < effMin) {
+                            action = DecisionTable::REQUIRED;
+                            target = &eligible.back();
+                        } else {
+                            for (size_t j = eligible.size(); j > 0; j--) {
+                                if (dev < eligible[j - 1] && (mask & UpdatePolicy::allow(dev.diff(eligible[j - 1])))) {
+                                    action = DecisionTable::OFFER;
+                                    target = &eligible[j - 1];
+                                    break;
+                                }
+                            }
+                        }
+                        DecisionTable::Decision got = t.decide(dev);
+                        if (got.action != action || (target && (!got.target || !(*got.target == *target)))) mismatches++;
+                    }
+                }
+            }
+        }
+        assertEqual(mismatches, 0, "Decision table matches direct scan for all policies");
+    }
+
+    // --- Version Range Tests ---
+    std::cout << "\n--- Version Range Tests ---" << std::endl;
+    {
+        std::vector<VersionRange> r;
+        assert(VersionRange::parse(">=1.2.0 <1.4.5", r) && r.size() == 1, "Parse comparator set");
+        assert(r[0].contains(SemVer("1.2.0")) && r[0].contains(SemVer("1.4.5-rc.1")), "Comparator set contains bounds by precedence");
+        assert(!r[0].contains(SemVer("1.4.5")) && !r[0].contains(SemVer("1.1.9")), "Comparator set excludes outside");
+
+        r.clear();
+        assert(VersionRange::parse("^1.2.3", r), "Parse caret");
+        assert(r[0].contains(SemVer("1.9.9")) && !r[0].contains(SemVer("2.0.0-rc.1")), "Caret stops below next major pre-releases");
+        r.clear();
+        VersionRange::parse("^0.2.3", r);
+        assert(r[0].contains(SemVer("0.2.9")) && !r[0].contains(SemVer("0.3.0")), "Caret on 0.x stops at next minor");
+        r.clear();
+        VersionRange::parse("^0.0.3", r);
+        assert(r[0].contains(SemVer("0.0.3")) && !r[0].contains(SemVer("0.0.4-0")), "Caret on 0.0.x is one patch");
+        r.clear();
+        VersionRange::parse("~1.2.3", r);
+        assert(r[0].contains(SemVer("1.2.9")) && !r[0].contains(SemVer("1.3.0")), "Tilde stops at next minor");
+        r.clear();
+        VersionRange::parse("1.0.0 - 2.0.0 || >= 3.0.0 || 2.5.0", r);
+        assertEqual(r.size(), 3, "Alternatives split on ||");
+        assert(r[0].contains(SemVer("2.0.0")) && r[1].contains(SemVer("7.0.0")) && r[2].contains(SemVer("2.5.0")), "Hyphen, spaced operator and exact");
+        r.clear();
+        assert(VersionRange::parse("*", r) && r[0].contains(SemVer("0.0.1")), "Star matches anything");
+        r.clear();
+        assert(VersionRange::parse(">2.0.0 <1.0.0", r) && r.empty(), "Empty intersection dropped");
+        assert(!VersionRange::parse(">=1.2", r), "Incomplete version rejected");
+        assert(!VersionRange::parse("=>1.2.3", r), "Unknown operator rejected");
+        assert(!VersionRange::parse("1.0.0 -", r), "Dangling hyphen rejected");
+
+        for (const char* req : { "1.2.3", "0.2.3", "0.0.3", "2.0.0-beta.2" }) {
+            r.clear();
+            std::string expr = std::string("^") + req;
+            VersionRange::parse(expr.c_str(), r);
+            bool same = true;
+            const char* probes[] = { "0.0.3", "0.0.4", "0.2.3", "0.2.9", "0.3.0", "1.2.2", "1.2.3", "1.9.0", "2.0.0-rc.1",
+                                     "2.0.0-beta.1", "2.0.0-beta.2", "2.0.0", "2.9.9", "3.0.0-0" };
+            for (const char* probe : probes) {
+                SemVer v(probe);
+                if (r[0].contains(v) != v.satisfies(SemVer(req), true)) same = false;
+            }
+            assert(same, (std::string("Caret range matches satisfies() for ") + req).c_str());
+        }
+    }
+    {
+        CaretIntersection all;
+        assert(!all.empty() && all.contains(SemVer("0.0.1")) && all.contains(SemVer("3.0.0-rc.1")), "No requirements contains everything");
+
+        CaretIntersection c;
+        assert(c.add(SemVer("1.2.0")) && c.add(SemVer("1.4.3")), "Compatible requirements");
+        assert(c.contains(SemVer("1.4.3")) && c.contains(SemVer("1.9.0")), "Intersection contains the newer minimum and above");
+        assert(!c.contains(SemVer("1.4.2")) && !c.contains(SemVer("2.0.0")), "Intersection excludes outside");
+        assert(c.range().low == SemVer("1.4.3") && c.range().high == SemVer("2.0.0-0"), "Normalized bounds");
+        assert(!c.contains(SemVer("1.5.0-rc.1")), "Stable requirements reject pre-releases");
+        assert(c.add(SemVer("1.4.0-beta.2")) && c.count() == 3, "Pre-release requirement within the range");
+        assert(!c.contains(SemVer("1.4.0-rc.1")), "Still no pre-releases once a stable requirement was added");
+
+        CaretIntersection pre;
+        pre.add(SemVer("1.4.0-beta.2"));
+        pre.add(SemVer("1.4.0-rc.1"));
+        assert(pre.contains(SemVer("1.4.0-rc.2")) && !pre.contains(SemVer("1.4.0-beta.3")), "Pre-releases of the same release above both");
+        assert(!pre.contains(SemVer("1.4.1-rc.1")) && pre.contains(SemVer("1.4.1")), "Only that release's pre-releases, any stable above");
+
+        CaretIntersection major;
+        major.add(SemVer("1.2.0"));
+        assert(!major.add(SemVer("2.0.0")) && major.empty(), "Different majors conflict");
+        CaretIntersection zero;
+        zero.add(SemVer("0.2.0"));
+        assert(!zero.add(SemVer("0.3.0")) && zero.empty(), "Different 0.x minors conflict");
+        CaretIntersection invalid;
+        assert(!invalid.add(SemVer("1.x")) && invalid.empty() && !invalid.contains(SemVer("1.0.0")), "Invalid requirement matches nothing");
+
+        // Random requirement sets against satisfies() for every one
+        const char* versions[] = { "0.0.3", "0.0.4", "0.2.3", "0.2.9", "0.3.0", "1.2.0", "1.2.3-alpha", "1.2.3-beta.1", "1.2.3",
+                                   "1.4.0-beta.2", "1.4.0-rc.1", "1.4.0", "1.4.3", "1.5.0-rc.1", "1.9.9", "2.0.0-rc.1", "2.0.0" };
+        const size_t n = sizeof(versions) / sizeof(versions[0]);
+        uint32_t seed = 45;
+        int mismatches = 0, conflicts = 0;
+        for (int round = 0; round < 2000; round++) {
+            bool includePrerelease = round % 2 != 0;
+            CaretIntersection set(includePrerelease);
+            std::vector<SemVer> reqs;
+            seed = seed * 1103515245u + 12345u;
+            for (unsigned k = 0; k < 1 + (seed >> 16) % 3; k++) {
+                seed = seed * 1103515245u + 12345u;
+                reqs.push_back(SemVer(versions[(seed >> 16) % n]));
+                set.add(reqs.back());
+            }
+            conflicts += set.empty();
+            bool any = false;
+            for (size_t i = 0; i < n; i++) {
+                SemVer v(versions[i]);
+                bool expected = true;
+                for (size_t k = 0; k < reqs.size(); k++) expected = expected && v.satisfies(reqs[k], includePrerelease);
+                if (set.contains(v) != expected) mismatches++;
+                any = any || expected;
+            }
+            if (set.empty() && any) mismatches++;
+        }
+        assertEqual(mismatches, 0, "contains() equals satisfies() for every requirement");
+        assert(conflicts > 100 && conflicts < 1900, "Random sets cover conflicts and overlaps");
+    }
+
+    // --- Advisory Index Tests ---
+    std::cout << "\n--- Advisory Index Tests ---" << std::endl;
+    {
+        AdvisoryIndex index;
+        assert(index.add(1, ">=1.0.0 <1.2.5"), "Add advisory 1");
+        assert(index.add(2, "^1.2.0 || ^2.0.0"), "Add advisory 2");
+        assert(index.add(3, "<0.9.0"), "Add advisory 3");
+        assert(index.add(4, "1.2.4"), "Add advisory 4");
+        assert(index.add(5, "^1.0.0 || >=1.1.0 <2.1.0"), "Add advisory 5 with overlapping ranges");
+        assert(!index.add(6, ">=x"), "Unparsable advisory rejected");
+        index.build();
+        assertEqual(index.size(), 6, "Overlapping ranges of one advisory are merged");
+
+        std::vector<uint32_t> hits;
+        index.query(SemVer("1.2.4"), hits);
+        std::sort(hits.begin(), hits.end());
+        assertEqual(hits.size(), 4, "1.2.4 matches four advisories");
+        assert(hits[0] == 1 && hits[1] == 2 && hits[2] == 4 && hits[3] == 5, "1.2.4 matches 1, 2, 4, 5");
+        hits.clear();
+        assertEqual(index.query(SemVer("0.5.0"), hits), 1, "0.5.0 matches advisory 3 only");
+        hits.clear();
+        assertEqual(index.query(SemVer("3.0.0"), hits), 0, "3.0.0 matches nothing");
+
+        // Cross-check against scanning every range
+        AdvisoryIndex big;
+        std::vector<std::vector<VersionRange> > ranges;
+        uint32_t seed = 777;
+        for (uint32_t a = 0; a < 400; a++) {
+            char expr[128];
+            seed = seed * 1103515245u + 12345u;
+            unsigned m1 = (seed >> 8) % 6, n1 = (seed >> 12) % 10, m2 = m1 + (seed >> 16) % 2, n2 = (seed >> 20) % 10;
+            const char* ops[] = { "^", "~", ">=", ">", "<", "<=", "" };
+            snprintf(expr, sizeof(expr), ">=%u.%u.0 <%u.%u.%u || %s%u.%u.%u%s", m1, n1, m2, n2, (seed >> 24) % 3,
+                     ops[(seed >> 4) % 7], (seed >> 2) % 5, (seed >> 5) % 4, (seed >> 9) % 3, (seed & 1) ? "-rc.1" : "");
+            std::vector<VersionRange> parsed;
+            VersionRange::parse(expr, parsed);
+            ranges.push_back(parsed);
+            big.add(a, expr);
+        }
+        big.build();
+
+        int mismatches = 0;
+        for (unsigned m = 0; m < 7; m++) {
+            for (unsigned n = 0; n < 11; n++) {
+                for (unsigned p = 0; p < 4; p++) {
+                    for (int pre = 0; pre < 2; pre++) {
+                        char text[40];
+                        snprintf(text, sizeof(text), "%u.%u.%u%s", m, n, p, pre ? "-rc.1" : "");
+                        SemVer v(text);
+                        std::vector<uint32_t> expected, got;
+                        for (uint32_t a = 0; a < ranges.size(); a++) {
+                            for (size_t i = 0; i < ranges[a].size(); i++) {
+                                if (ranges[a][i].contains(v)) { expected.push_back(a); break; }
+                            }
+                        }
+                        big.query(v, got);
+                        std::sort(got.begin(), got.end());
+                        if (got != expected) mismatches++;
+                    }
+                }
+            }
+        }
+        assertEqual(mismatches, 0, "Stabbing queries match a linear scan");
+    }
+
+    // --- Fleet Join Tests ---
+    std::cout << "\n--- Fleet Join Tests ---" << std::endl;
+    {
+        std::vector<SemVer> fleet;
+        const char* devices[] = { "1.2.4", "1.2.4", "2.0.1", "0.5.0", "bogus", "1.0.0", "3.1.0", "2.0.0-rc.1", "1.2.4" };
+        for (const char* d : devices) fleet.push_back(SemVer(d));
+
+        FleetJoin join;
+        assert(join.addAdvisory(10, ">=1.0.0 <1.2.5"), "Add advisory 10");
+        assert(join.addAdvisory(20, "^1.2.0 || ^2.0.0"), "Add advisory 20");
+        assert(join.addAdvisory(30, "<0.9.0 || <0.6.0"), "Add advisory 30");
+        assert(join.addAdvisory(40, ">=5.0.0"), "Add advisory 40");
+        join.run(fleet, 2, true);
+
+        const std::vector<FleetJoin::AdvisoryCount>& c = join.counts();
+        assertEqual(c.size(), 4, "One count per advisory");
+        assert(c[0].advisory == 10 && c[0].devices == 4, "Advisory 10 hits 1.0.0 and three 1.2.4");
+        assert(c[1].advisory == 20 && c[1].devices == 4, "Advisory 20 hits 1.2.4 x3 and 2.0.1");
+        assert(c[2].advisory == 30 && c[2].devices == 1, "Overlapping ranges count a device once");
+        assert(c[3].devices == 0, "Advisory above the fleet hits nothing");
+        assertEqual(join.distinctVersions(), 6, "Distinct valid versions");
+        assertEqual(join.bitsetWords(), 1, "Four advisories fit one word");
+        assertEqual(*join.deviceBitset(0), 0x3, "1.2.4 bitset has advisories 10 and 20");
+        assert(join.deviceBitset(4) == NULL, "Invalid device has no bitset");
+
+        // Random fleet against random advisories, several thread counts
+        std::vector<SemVer> big;
+        uint32_t seed = 4242;
+        for (int i = 0; i < 20000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char text[40];
+            snprintf(text, sizeof(text), "%u.%u.%u%s", (seed >> 8) % 5, (seed >> 12) % 8, (seed >> 16) % 4, (seed >> 20) % 5 ? "" : "-rc.1");
+            big.push_back(SemVer(text));
+        }
+        std::vector<std::vector<VersionRange> > ranges;
+        FleetJoin joins[3];
+        for (uint32_t a = 0; a < 70; a++) {
+            seed = seed * 1103515245u + 12345u;
+            char expr[96];
+            const char* ops[] = { "^", "~", ">=", ">", "<", "<=", "" };
+            snprintf(expr, sizeof(expr), "%s%u.%u.%u || >=%u.%u.0 <%u.0.0", ops[(seed >> 4) % 7], (seed >> 8) % 5,
+                     (seed >> 12) % 8, (seed >> 16) % 4, (seed >> 20) % 5, (seed >> 24) % 8, 1 + (seed >> 27) % 5);
+            std::vector<VersionRange> parsed;
+            VersionRange::parse(expr, parsed);
+            ranges.push_back(parsed);
+            for (FleetJoin& j : joins) j.addAdvisory(a, expr);
+        }
+        joins[0].run(big, 1, true);
+        joins[1].run(big, 3, true);
+        joins[2].run(big, 8, false);
+
+        int countMismatches = 0, bitMismatches = 0;
+        for (uint32_t a = 0; a < ranges.size(); a++) {
+            uint64_t expected = 0;
+            for (size_t d = 0; d < big.size(); d++) {
+                bool hit = false;
+                for (size_t i = 0; i < ranges[a].size(); i++) hit = hit || ranges[a][i].contains(big[d]);
+                expected += hit;
+                for (int j = 0; j < 2; j++) {
+                    bool bit = (joins[j].deviceBitset(d)[a / 64] >> (a % 64)) & 1;
+                    if (bit != hit) bitMismatches++;
+                }
+            }
+            for (FleetJoin& j : joins) {
+                if (j.counts()[a].devices != expected) countMismatches++;
+            }
+        }
+        assertEqual(countMismatches, 0, "Join counts match brute force for 1, 3 and 8 threads");
+        assertEqual(bitMismatches, 0, "Device bitsets match brute force");
+    }
+
+    // --- Version Histogram Tests ---
+    std::cout << "\n--- Version Histogram Tests ---" << std::endl;
+    {
+        VersionHistogram h;
+        h.add("1.2.3", 5);
+        h.add("1.2.3+build.7");
+        h.add("2.0.0-rc.1", 2);
+        h.add("bogus");
+        assertEqual(h.total(), 8, "Histogram total counts valid versions");
+        assertEqual(h.invalid(), 1, "Histogram counts invalid separately");
+        assertEqual(h.estimate(SemVer("1.2.3")), 6, "Build metadata is ignored like operator==");
+        assertEqual(h.estimate(SemVer("9.9.9")), 0, "Unseen stable version is zero");
+
+        std::vector<VersionHistogram::Bucket> top = h.top(5);
+        assertEqual(top.size(), 2, "top() returns tracked versions only");
+        assertString(top[0].version.toString(), "1.2.3", "top() orders by count");
+
+        // Long tail of nightly builds spills into the sketch
+        VersionHistogram tail(16, 256, 4);
+        for (int i = 0; i < 500; i++) {
+            char text[40];
+            snprintf(text, sizeof(text), "3.0.0-nightly.%d", i);
+            tail.add(text, 1 + i % 3);
+        }
+        tail.add("3.0.0", 1000);
+        assert(tail.exactSize() <= 17, "Exact pre-releases bounded");
+        assert(tail.sketched() > 0, "Tail pre-releases are sketched");
+        assertEqual(tail.estimate(SemVer("3.0.0")), 1000, "Stable stays exact");
+        bool bounded = true;
+        for (int i = 0; i < 500; i++) {
+            char text[40];
+            snprintf(text, sizeof(text), "3.0.0-nightly.%d", i);
+            if (tail.estimate(SemVer(text)) < (uint64_t)(1 + i % 3)) bounded = false;
+        }
+        assert(bounded, "Sketch estimates never undercount");
+
+        // Node snapshots merge to the same bytes in any grouping
+        VersionHistogram nodes[3], single;
+        size_t rawBytes = 0;
+        uint32_t seed = 99;
+        for (int i = 0; i < 6000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char text[40];
+            if ((seed >> 10) % 4) snprintf(text, sizeof(text), "2.%u.%u", (seed >> 12) % 6, (seed >> 16) % 5);
+            else snprintf(text, sizeof(text), "2.%u.0-beta.%u", (seed >> 12) % 6, (seed >> 16) % 400);
+            nodes[i % 3].add(text);
+            single.add(text);
+            rawBytes += strlen(text) + 1;
+        }
+        VersionHistogram left = nodes[0], right = nodes[1];
+        left.merge(nodes[1]);
+        left.merge(nodes[2]);
+        right.merge(nodes[2]);
+        VersionHistogram rightAll = nodes[0];
+        rightAll.merge(right);
+        VersionHistogram reversed = nodes[2];
+        reversed.merge(nodes[0]);
+        reversed.merge(nodes[1]);
+        assert(left.serialize() == rightAll.serialize(), "merge() is associative");
+        assert(left.serialize() == reversed.serialize(), "merge() is commutative");
+        assert(left.serialize() == single.serialize(), "Merged snapshots equal a single histogram");
+        assertEqual(left.total(), 6000, "Merged total");
+
+        std::vector<uint8_t> bytes = left.serialize();
+        VersionHistogram restored;
+        assert(restored.deserialize(bytes.data(), bytes.size()), "deserialize() accepts serialize() output");
+        assert(restored.serialize() == bytes, "Serialization round-trips");
+        assertEqual(restored.total(), 6000, "Round-trip keeps total");
+        assert(!restored.deserialize(bytes.data(), bytes.size() - 1), "Truncated data rejected");
+        assertEqual(restored.total(), 6000, "Failed deserialize leaves histogram unchanged");
+        assert(bytes.size() * 4 < rawBytes, "Serialized form is much smaller than the raw strings");
+
+        VersionHistogram narrow(256, 64, 4);
+        assert(!narrow.merge(left), "Merging different sketch sizes fails");
+
+        VersionHistogram twice = nodes[0];
+        twice.merge(nodes[0]);
+        VersionHistogram doubled = nodes[0];
+        assert(doubled.merge(doubled), "merge() with itself succeeds");
+        assert(doubled.serialize() == twice.serialize(), "merge() with itself equals merging a copy");
+        assertEqual(doubled.total(), 2 * nodes[0].total(), "merge() with itself doubles the total");
+    }
+
+    // --- Version Registry Tests ---
+    std::cout << "\n--- Version Registry Tests ---" << std::endl;
+    {
+        VersionRegistry registry(100, 16);
+        assert(registry.record(1, "1.2.3+build.1"), "Record device 1");
+        assert(registry.record(2, "1.2.3+build.2"), "Record device 2");
+        assert(registry.record(3, "2.0.0-rc.1"), "Record device 3");
+        assert(!registry.record(4, "bogus"), "Invalid version rejected");
+        assert(!registry.record(UINT64_MAX, "1.0.0"), "Reserved device ID rejected");
+        assertEqual(registry.versionCount(), 2, "Build metadata shares a handle");
+        assertEqual(registry.handleOf(1), registry.handleOf(2), "Equal versions share a handle");
+        assertEqual(registry.find(SemVer("1.2.3")), registry.handleOf(1), "find() ignores build metadata");
+        assertEqual(registry.find(SemVer("9.0.0")), VersionRegistry::NO_VERSION, "Unknown version has no handle");
+        assertEqual(registry.count(registry.handleOf(1)), 2, "Live count per version");
+
+        registry.record(2, "2.0.0-rc.1");
+        assert(registry.remove(1), "Remove registered device");
+        assert(!registry.remove(1), "Removing twice fails");
+        assert(!registry.remove(77), "Removing unknown device fails");
+        assertEqual(registry.handleOf(1), VersionRegistry::NO_VERSION, "Removed device has no version");
+
+        std::vector<VersionRegistry::Entry> snap = registry.snapshot();
+        assertEqual(snap.size(), 1, "Snapshot omits versions without devices");
+        assertString(snap[0].version.toString(), "2.0.0-rc.1", "Snapshot version");
+        assertEqual(snap[0].devices, 2, "Snapshot count");
+
+        VersionRegistry tiny(2, 1);
+        assert(tiny.record(1, "1.0.0") && tiny.record(2, "1.0.0"), "Fill small registry");
+        assert(!tiny.record(3, "1.0.0"), "Device table full");
+        assert(!tiny.record(1, "2.0.0"), "Version table full");
+
+        VersionRegistry* heap = new VersionRegistry(16, 16);
+        assert((uintptr_t)heap % 64 == 0 && heap->record(1, "1.0.0"), "Heap registry is cache-line aligned");
+        delete heap;
+    }
+    {
+        // Writers move devices between versions while snapshots are taken
+        const uint64_t devices = 2000;
+        VersionRegistry registry(devices, 64);
+        for (uint64_t d = 0; d < devices; d++) registry.record(d, "1.0.0");
+
+        std::atomic<bool> done(false);
+        std::atomic<int> inconsistent(0);
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 4; t++) {
+            writers.push_back(std::thread([&registry, t]() {
+                uint32_t seed = 1 + t;
+                for (int i = 0; i < 40000; i++) {
+                    seed = seed * 1103515245u + 12345u;
+                    char text[32];
+                    snprintf(text, sizeof(text), "1.%u.0%s", (seed >> 8) % 20, (seed >> 20) % 3 ? "" : "-beta");
+                    registry.record((seed >> 4) % devices, text);
+                }
+            }));
+        }
+        std::thread snapshotter([&]() {
+            while (!done.load()) {
+                std::vector<VersionRegistry::Entry> snap = registry.snapshot();
+                uint64_t sum = 0;
+                for (size_t i = 0; i < snap.size(); i++) sum += snap[i].devices;
+                if (sum != devices) inconsistent++;
+            }
+        });
+        for (size_t i = 0; i < writers.size(); i++) writers[i].join();
+        done.store(true);
+        snapshotter.join();
+
+        assertEqual(inconsistent.load(), 0, "Concurrent snapshots always count every device once");
+        std::vector<uint64_t> expected(registry.versionCount(), 0);
+        for (uint64_t d = 0; d < devices; d++) expected[registry.handleOf(d)]++;
+        std::vector<VersionRegistry::Entry> snap = registry.snapshot();
+        bool match = true;
+        uint64_t listed = 0;
+        for (size_t i = 0; i < snap.size(); i++) {
+            if (snap[i].devices != expected[snap[i].handle]) match = false;
+            listed += snap[i].devices;
+        }
+        assert(match && listed == devices, "Final snapshot matches device table");
+    }
+
+    // --- External Sort Tests ---
+    std::cout << "\n--- External Sort Tests ---" << std::endl;
+    {
+        ExternalSorter small;
+        assert(small.add("1.10.0") && small.add("1.2.0+b") && small.add("1.2.0-rc.1") && small.add(SemVer("1.2.0+a")),
+               "Add versions");
+        assert(!small.add("1.2"), "Invalid version rejected");
+        assertEqual(small.invalid(), 1, "Invalid versions counted");
+        assert(small.next() == NULL, "No output before finish()");
+        assert(small.finish(), "In-memory finish");
+        assertEqual(small.runs(), 0, "Small input writes no runs");
+        assertString(small.next(), "1.2.0-rc.1", "Pre-release first");
+        assertString(small.next(), "1.2.0+b", "Equal precedence keeps input order");
+        SemVer v;
+        assert(small.next(v) && v.toString() == "1.2.0+a", "next(SemVer&)");
+        assertString(small.next(), "1.10.0", "Numeric order");
+        assert(small.next() == NULL, "End of stream");
+        assert(!small.add("2.0.0"), "add() after finish() fails");
+
+        // Tiny budget: many runs and several merge passes
+        static const char* const pre[] = { "", "-alpha", "-alpha.1", "-alpha.beta", "-beta.2", "-beta.11", "-rc.1", "-1", "-x-y" };
+        std::vector<std::string> input;
+        uint32_t seed = 7;
+        for (int i = 0; i < 20000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char text[64];
+            snprintf(text, sizeof(text), "%u.%u.%u%s%s", (seed >> 8) % 3, (seed >> 12) % 12, (seed >> 16) % 4,
+                     pre[(seed >> 20) % 9], (seed >> 28) % 4 ? "" : ((seed >> 27) % 2 ? "+b1" : "+b2"));
+            input.push_back(text);
+        }
+        std::vector<std::pair<SemVer, std::string> > reference;
+        for (size_t i = 0; i < input.size(); i++) reference.push_back(std::make_pair(SemVer(input[i].c_str()), input[i]));
+        std::stable_sort(reference.begin(), reference.end(),
+            [](const std::pair<SemVer, std::string>& a, const std::pair<SemVer, std::string>& b) { return a.first < b.first; });
+
+        for (int unique = 0; unique < 2; unique++) {
+            std::vector<std::string> expected;
+            for (size_t i = 0; i < reference.size(); i++) {
+                if (!unique || expected.empty() || !(SemVer(expected.back().c_str()) == reference[i].first)) {
+                    expected.push_back(reference[i].second);
+                }
+            }
+            size_t budgets[] = { 2048, 64u << 20 };
+            for (size_t b = 0; b < 2; b++) {
+                ExternalSorter sorter(budgets[b], unique != 0);
+                for (size_t i = 0; i < input.size(); i++) sorter.add(input[i].c_str());
+                assert(sorter.finish(), "finish() succeeds");
+                std::vector<std::string> output;
+                while (const char* text = sorter.next()) output.push_back(text);
+                assert(!sorter.failed(), "No temporary file errors");
+                assert(output == expected, unique ? "Unique output equals deduplicated stable sort"
+                                                  : "Output equals stable sort with operator<");
+                if (b == 0) assert(sorter.runs() > 100, "Tiny budget spills and merges runs");
+            }
+        }
+
+        ExternalSorter badDir(1024, false, "/nonexistent-semver-dir");
+        bool accepted = true;
+        for (int i = 0; i < 200 && accepted; i++) accepted = badDir.add("1.0.0");
+        assert(!accepted && badDir.failed(), "Unwritable temporary directory reported");
+    }
+
+    // --- Ingest Pipeline Tests ---
+    std::cout << "\n--- Ingest Pipeline Tests ---" << std::endl;
+    {
+        SpscQueue<int> queue(5);
+        assertEqual(queue.capacity(), 8, "Capacity rounds up to a power of two");
+        bool filled = true;
+        for (int i = 0; i < 8; i++) filled = filled && queue.tryPush(i);
+        assert(filled && !queue.tryPush(8), "Full queue refuses push");
+        int value = -1;
+        assert(queue.tryPop(value) && value == 0, "FIFO order");
+        assert(queue.tryPush(8), "Push after pop");
+        SpscQueue<int>* heap = new SpscQueue<int>(4);
+        assert((uintptr_t)heap % 64 == 0 && sizeof(SpscQueue<int>) >= 128, "Heap queue sides on separate cache lines");
+        delete heap;
+
+        SpscQueue<int> handoff(4);
+        bool ordered = true;
+        std::thread consumer([&]() {
+            for (int i = 0; i < 100000; i++) {
+                if (handoff.pop() != i) ordered = false;
+            }
+        });
+        for (int i = 0; i < 100000; i++) handoff.push(i);
+        consumer.join();
+        assert(ordered, "Values cross threads in order");
+
+        SemVer latest("2.4.1");
+        assertEqual(IngestPipeline::classify(SemVer("2.4.1+b7"), latest), IngestPipeline::CURRENT, "Classify current");
+        assertEqual(IngestPipeline::classify(SemVer("1.9.0"), latest), IngestPipeline::BEHIND_MAJOR, "Classify major");
+        assertEqual(IngestPipeline::classify(SemVer("2.4.1-rc.2"), latest), IngestPipeline::BEHIND_PRERELEASE,
+                    "Classify pre-release");
+        assertEqual(IngestPipeline::classify(SemVer("2.5.0-beta"), latest), IngestPipeline::AHEAD, "Classify ahead");
+        assertEqual(IngestPipeline::classify(SemVer("2.4"), latest), IngestPipeline::INVALID, "Classify invalid");
+        assertString(IngestPipeline::parseRecord("device-42 1.2.3", 15).toString(), "1.2.3", "Version is the last field");
+
+        std::string data;
+        uint64_t expected[IngestPipeline::OUTCOME_COUNT] = { 0 };
+        uint64_t records = 0;
+        uint32_t seed = 11;
+        for (int i = 0; i < 30000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char line[64];
+            if ((seed >> 8) % 50 == 0) snprintf(line, sizeof(line), "dev-%d 2.x", i);
+            else snprintf(line, sizeof(line), "dev-%d %u.%u.%u%s", i, 1 + (seed >> 10) % 2, (seed >> 12) % 6,
+                          (seed >> 16) % 3, (seed >> 20) % 5 ? "" : "-rc.1");
+            data += line;
+            data += (i % 7) ? "\n" : "\r\n\n";
+            expected[IngestPipeline::classify(IngestPipeline::parseRecord(line, strlen(line)), latest)]++;
+            records++;
+        }
+
+        unsigned threads[] = { 1, 3 };
+        for (int t = 0; t < 2; t++) {
+            IngestPipeline pipeline(latest, threads[t], 50, 2);
+            IngestPipeline::Report report = pipeline.run(data.data(), data.size());
+            bool same = report.records == records;
+            for (int o = 0; o < IngestPipeline::OUTCOME_COUNT; o++) same = same && report.outcomes[o] == expected[o];
+            assert(same, "Pipeline counts equal the serial loop");
+            assertEqual(report.batches, (records + 49) / 50, "Memory input cut into full batches");
+
+            FILE* file = tmpfile();
+            fwrite(data.data(), 1, data.size(), file);
+            rewind(file);
+            IngestPipeline::Report streamed = pipeline.run(file);
+            fclose(file);
+            same = streamed.records == records;
+            for (int o = 0; o < IngestPipeline::OUTCOME_COUNT; o++) same = same && streamed.outcomes[o] == expected[o];
+            assert(same, "Stream input gives the same counts");
+        }
+
+        IngestPipeline empty(latest, 2);
+        assertEqual(empty.run("", 0).records, 0, "Empty input");
+        assertEqual(empty.run("\n\n", 2).batches, 0, "Blank lines are skipped");
+
+        // Stream reads are batchSize * 32 bytes: lines may span reads, and reads may hold only blank lines
+        auto streamRun = [&latest](const std::string& text, size_t batchSize) {
+            FILE* file = tmpfile();
+            fwrite(text.data(), 1, text.size(), file);
+            rewind(file);
+            IngestPipeline pipeline(latest, 2, batchSize, 2);
+            IngestPipeline::Report report = pipeline.run(file);
+            fclose(file);
+            return report;
+        };
+        IngestPipeline::Report r = streamRun(std::string(64, '\n') + "1.0.0\n", 1);
+        assert(r.records == 1 && r.outcomes[IngestPipeline::BEHIND_MAJOR] == 1, "Record after a read of blank lines");
+        r = streamRun(std::string(32768, '\n') + "2.4.1\n", 1024);
+        assert(r.records == 1 && r.outcomes[IngestPipeline::CURRENT] == 1, "Record after 32 KiB of blank lines");
+        std::string longLine = "device-with-a-long-identifier-0001 2.4.1\n"; // Longer than one 32-byte read
+        r = streamRun(longLine + longLine + "\n\n" + longLine, 1);
+        assert(r.records == 3 && r.outcomes[IngestPipeline::CURRENT] == 3 && r.outcomes[IngestPipeline::INVALID] == 0,
+               "Lines longer than a read are not cut");
+        r = streamRun(std::string(200, 'x') + " 1.0.0", 1);
+        assert(r.records == 1 && r.outcomes[IngestPipeline::BEHIND_MAJOR] == 1, "Long last line without a newline");
+        r = streamRun(data, 3);
+        bool small = r.records == records;
+        for (int o = 0; o < IngestPipeline::OUTCOME_COUNT; o++) small = small && r.outcomes[o] == expected[o];
+        assert(small, "Small stream batches give the same counts");
+    }
+
+    // --- Dependency Resolver Tests ---
+    std::cout << "\n--- Dependency Resolver Tests ---" << std::endl;
+    {
+        DependencyResolver resolver;
+        uint32_t app = resolver.addPackage("app");
+        uint32_t net = resolver.addPackage("net");
+        uint32_t tls = resolver.addPackage("tls");
+        assertEqual(resolver.addPackage("net"), net, "addPackage() returns the existing id");
+        assertEqual(resolver.find("tls"), tls, "find() by name");
+        assertEqual(resolver.find("gps"), DependencyResolver::NO_PACKAGE, "Unknown package");
+
+        const char* netReleases[] = { "1.0.0", "1.4.0", "2.0.0", "2.1.0" };
+        const char* tlsReleases[] = { "3.0.0", "3.2.0", "4.0.0" };
+        resolver.addRelease(app, SemVer("1.0.0"));
+        for (int i = 0; i < 4; i++) resolver.addRelease(net, SemVer(netReleases[i]));
+        for (int i = 0; i < 3; i++) resolver.addRelease(tls, SemVer(tlsReleases[i]));
+        assert(!resolver.addRelease(net, SemVer("1.4.0+rebuild")), "Duplicate release rejected");
+        assert(!resolver.addRelease(net, SemVer("1.4")), "Invalid release rejected");
+
+        resolver.addDependency(app, SemVer("1.0.0"), net, SemVer("1.0.0"));
+        resolver.addDependency(app, SemVer("1.0.0"), tls, SemVer("3.0.0"));
+        resolver.addDependency(net, SemVer("2.0.0"), tls, SemVer("4.0.0"));
+        resolver.addDependency(net, SemVer("2.1.0"), tls, SemVer("4.0.0"));
+        resolver.addDependency(net, SemVer("1.4.0"), tls, SemVer("3.1.0"));
+        assert(!resolver.addDependency(net, SemVer("9.9.9"), tls, SemVer("3.0.0")), "Unknown release rejected");
+
+        std::vector<DependencyResolver::Requirement> roots(1);
+        roots[0].package = app;
+        roots[0].version = SemVer("1.0.0");
+        assertEqual(resolver.resolve(roots), DependencyResolver::RESOLVED, "Resolves");
+        assertString(resolver.selected(net).toString(), "1.4.0", "Newest net compatible with tls ^3");
+        assertString(resolver.selected(tls).toString(), "3.2.0", "Newest tls ^3");
+
+        // Requiring net ^2 as well contradicts app's net ^1
+        DependencyResolver::Requirement needNet2 = { net, SemVer("2.0.0") };
+        roots.push_back(needNet2);
+        assertEqual(resolver.resolve(roots), DependencyResolver::UNSATISFIABLE, "Conflicting requirements");
+        const DependencyResolver::Conflict& c = resolver.conflict();
+        assertEqual(c.package, net, "Conflict is on net");
+        assertEqual(c.constraints.size(), 2, "Two constraints conflict");
+        assert(c.constraints[0].from == DependencyResolver::ROOT && c.constraints[1].from == app,
+               "Conflict names the requiring packages");
+        assertString(c.constraints[1].fromVersion.toString(), "1.0.0", "Conflict names the requiring release");
+        assert(!c.chosen.isValid(), "No release of net was chosen");
+
+        // Pinning tls ^3 leaves net 2.x with no tls: the conflict is found below net
+        roots[0] = needNet2;
+        roots[1].package = tls;
+        roots[1].version = SemVer("3.0.0");
+        assertEqual(resolver.resolve(roots), DependencyResolver::UNSATISFIABLE, "Transitive conflict");
+        assertEqual(resolver.conflict().package, tls, "Transitive conflict is on tls");
+        assertString(resolver.conflict().constraints[1].fromVersion.toString(), "2.1.0",
+                     "Newest net release tried first");
+        assert(!resolver.selected(net).isValid(), "No selection after failure");
+
+        DependencyResolver::Requirement bogus = { 99, SemVer("1.0.0") };
+        std::vector<DependencyResolver::Requirement> unknown(1, bogus);
+        assertEqual(resolver.resolve(unknown), DependencyResolver::UNSATISFIABLE, "Unknown package unsatisfiable");
+    }
+    {
+        // Random small graphs against brute force over every assignment
+        uint32_t seed = 3;
+        int agree = 0, solved = 0;
+        const int P = 4, R = 4;
+        for (int round = 0; round < 300; round++) {
+            DependencyResolver resolver;
+            std::vector<std::vector<SemVer> > releases(P);
+            // deps[p][r] = list of (package, requirement)
+            std::vector<std::vector<std::vector<std::pair<int, SemVer> > > > deps(P, std::vector<std::vector<std::pair<int, SemVer> > >(R));
+            for (int p = 0; p < P; p++) {
+                char name[8];
+                snprintf(name, sizeof(name), "p%d", p);
+                resolver.addPackage(name);
+                for (int r = 0; r < R; r++) {
+                    char text[16];
+                    snprintf(text, sizeof(text), "%d.%d.0", 1 + r / 2, r % 2);
+                    releases[p].push_back(SemVer(text));
+                    resolver.addRelease(p, releases[p].back());
+                }
+            }
+            for (int p = 0; p < P; p++) {
+                for (int r = 0; r < R; r++) {
+                    for (int q = 0; q < P; q++) {
+                        seed = seed * 1103515245u + 12345u;
+                        if (q == p || (seed >> 16) % 2) continue;
+                        char text[16];
+                        snprintf(text, sizeof(text), "%u.%u.0", 1 + (seed >> 20) % 2, (seed >> 24) % 2);
+                        deps[p][r].push_back(std::make_pair(q, SemVer(text)));
+                        resolver.addDependency(p, releases[p][r], q, SemVer(text));
+                    }
+                }
+            }
+            seed = seed * 1103515245u + 12345u;
+            std::vector<DependencyResolver::Requirement> roots(1);
+            roots[0].package = 0;
+            roots[0].version = SemVer((seed >> 16) % 2 ? "1.0.0" : "2.0.0");
+            DependencyResolver::Status status = resolver.resolve(roots);
+
+            // Brute force: each package absent (R) or at a release
+            bool exists = false;
+            for (int combo = 0; combo < 625 && !exists; combo++) {
+                int pick[P];
+                for (int p = 0, c = combo; p < P; p++, c /= R + 1) pick[p] = c % (R + 1);
+                bool valid = pick[0] < R && releases[0][pick[0]].satisfies(roots[0].version);
+                for (int p = 0; p < P && valid; p++) {
+                    if (pick[p] == R) continue;
+                    for (size_t d = 0; d < deps[p][pick[p]].size() && valid; d++) {
+                        int q = deps[p][pick[p]][d].first;
+                        valid = pick[q] < R && releases[q][pick[q]].satisfies(deps[p][pick[p]][d].second);
+                    }
+                }
+                exists = valid;
+            }
+
+            bool consistent = true;
+            if (status == DependencyResolver::RESOLVED) {
+                solved++;
+                consistent = resolver.selected(0).satisfies(roots[0].version);
+                for (int p = 0; p < P; p++) {
+                    if (!resolver.selected(p).isValid()) continue;
+                    int r = 0;
+                    while (!(releases[p][r] == resolver.selected(p))) r++;
+                    for (size_t d = 0; d < deps[p][r].size(); d++) {
+                        if (!resolver.selected(deps[p][r][d].first).satisfies(deps[p][r][d].second)) consistent = false;
+                    }
+                }
+            }
+            if (consistent && exists == (status == DependencyResolver::RESOLVED)) agree++;
+        }
+        assertEqual(agree, 300, "Resolver agrees with brute force");
+        assert(solved > 30 && solved < 270, "Brute-force rounds cover both outcomes");
+    }
+
+    // --- Prerelease Index Tests ---
+    std::cout << "\n--- Prerelease Index Tests ---" << std::endl;
+    {
+        PrereleaseIndex index;
+        const char* versions[] = { "2.1.0-rc.1", "2.0.0-rc.2", "2.0.0-rc.1", "3.0.0-rc.1", "2.0.0-beta.1", "2.0.0-rc1",
+                                   "3.1.0-beta.2", "3.1.0-beta.10", "3.1.0-beta.1", "3.1.0-beta", "3.1.0-nightly.20260815",
+                                   "3.1.0-nightly.20260902", "3.2.0-nightly.20260910", "3.1.0-2", "2.0.0-rc.1+build.7" };
+        for (const char* v : versions) index.add(v);
+        assert(!index.add("2.0.0") && !index.add("x"), "Stable and invalid versions are not indexed");
+        index.build();
+        assertEqual(index.size(), 15, "Every pre-release indexed");
+
+        std::vector<uint32_t> hits;
+        VersionRange v2 = VersionRange::caret(SemVer("2.0.0"));
+        assertEqual(index.find("rc", v2, hits), 4, "rc builds of 2.x");
+        assert(index.at(hits[0]) == SemVer("2.0.0-rc.1") && index.at(hits[2]) == SemVer("2.0.0-rc.2") &&
+               index.at(hits[3]) == SemVer("2.1.0-rc.1"), "rc builds in precedence order, 2.0.0-rc.1 included");
+        assert(strcmp(index.at(hits[1]).getBuild(), "build.7") == 0, "Equal precedence keeps insertion order");
+
+        hits.clear();
+        VersionRange exact;
+        exact.low = exact.high = SemVer("3.1.0");
+        assertEqual(index.find("beta", exact, hits), 4, "Every beta of 3.1.0");
+        assert(strcmp(index.at(hits[0]).getPrerelease(), "beta") == 0 && strcmp(index.at(hits[3]).getPrerelease(), "beta.10") == 0,
+               "Numeric identifiers by value");
+        hits.clear();
+        assertEqual(index.find("beta.1", exact, hits), 1, "Prefix of whole identifiers: beta.1 not beta.10");
+        hits.clear();
+        assertEqual(index.find("rc", hits), 5, "No core filter");
+        hits.clear();
+        assertEqual(index.find("", hits), 15, "Empty prefix matches everything");
+        hits.clear();
+        assertEqual(index.find("rc.", hits) + index.find("gamma", hits) + index.find("rc..1", hits), 0, "Malformed or unknown prefixes");
+
+        hits.clear();
+        assertEqual(index.findFrom("nightly", "20260901", VersionRange(), hits), 2, "Nightlies since 2026-09-01");
+        assert(index.at(hits[0]) == SemVer("3.1.0-nightly.20260902") && index.at(hits[1]) == SemVer("3.2.0-nightly.20260910"),
+               "findFrom() in precedence order");
+
+        std::vector<std::string> channels;
+        index.nextIdentifiers("", channels);
+        assert(channels.size() == 5 && channels[0] == "2" && channels[1] == "beta" && channels[4] == "rc1",
+               "Channels in precedence order, numeric first");
+
+        // Random catalogs against a scan with getPrerelease()
+        const char* tags[] = { "alpha", "beta", "rc", "nightly" };
+        uint32_t seed = 46;
+        PrereleaseIndex big;
+        std::vector<SemVer> all;
+        for (int i = 0; i < 3000; i++) {
+            char text[64];
+            seed = seed * 1103515245u + 12345u;
+            unsigned tag = (seed >> 8) % 4;
+            snprintf(text, sizeof(text), "%u.%u.%u-%s.%u", (seed >> 12) % 4, (seed >> 16) % 5, (seed >> 20) % 3, tags[tag],
+                     tag == 3 ? 20260800 + (seed >> 24) % 60 : (seed >> 24) % 12);
+            big.add(text);
+            all.push_back(SemVer(text));
+        }
+        big.build();
+        std::stable_sort(all.begin(), all.end());
+        int mismatches = 0;
+        for (unsigned major = 0; major < 4; major++) {
+            for (unsigned t = 0; t < 4; t++) {
+                char core[16];
+                VersionRange r;
+                snprintf(core, sizeof(core), "%u.0.0", major);
+                r.low = SemVer(core);
+                snprintf(core, sizeof(core), "%u.0.0", major + 1);
+                r.high = SemVer(core);
+                r.highInclusive = false;
+                std::vector<uint32_t> got;
+                big.find(tags[t], r, got);
+                std::vector<uint32_t> expected;
+                size_t len = strlen(tags[t]);
+                for (uint32_t i = 0; i < all.size(); i++) {
+                    const char* pre = all[i].getPrerelease();
+                    if (all[i].major == major && strncmp(pre, tags[t], len) == 0 && pre[len] == '.') expected.push_back(i);
+                }
+                if (got.size() != expected.size()) mismatches++;
+                for (size_t i = 0; i < got.size() && i < expected.size(); i++) {
+                    if (strcmp(big.at(got[i]).getPrerelease(), all[expected[i]].getPrerelease()) != 0 ||
+                        !(big.at(got[i]) == all[expected[i]])) mismatches++;
+                }
+            }
+        }
+        assertEqual(mismatches, 0, "Queries match a filtered scan, in the same order");
+    }
+
+    // --- Build Metadata Tests ---
+    std::cout << "\n--- Build Metadata Tests ---" << std::endl;
+    {
+        SemVer v("1.4.0+20261014.g1a2b3c4.ci789");
+        BuildMetadata build(v);
+        assertEqual(build.count(), 3, "Three identifiers");
+        size_t len;
+        const char* id = build.identifier(1, len);
+        assert(id && len == 8 && strncmp(id, "g1a2b3c4", len) == 0, "Second identifier");
+        assert(build.identifier(3, len) == NULL && len == 0, "Out of range identifier");
+        uint64_t value = 0;
+        assert(build.number(0, value) && value == 20261014u, "Build date as a number");
+        assert(!build.number(1, value), "Commit is not a number");
+        assert(build.hex(1, value, "g") && value == 0x1a2b3c4u, "Commit as hex after 'g'");
+        assert(build.hexAfter("g", value) && value == 0x1a2b3c4u, "hexAfter finds the commit");
+        assert(build.numberAfter("ci", value) && value == 789, "numberAfter finds the CI job");
+        assert(!build.numberAfter("job", value), "Missing prefix");
+        assertEqual(build.find("ci789"), 2, "find() by whole identifier");
+        assertEqual(build.find("ci"), -1, "find() does not match prefixes");
+
+        assertEqual(BuildMetadata(SemVer("1.0.0")).count(), 0, "No build metadata");
+        assertEqual(BuildMetadata(SemVer("x")).count(), 0, "Invalid version has none");
+        BuildMetadata odd("0042.DEADbeef.99999999999999999999");
+        assert(odd.number(0, value) && value == 42, "Leading zeros allowed in build numbers");
+        assert(odd.hex(1, value) && value == 0xDEADBEEFu, "Mixed-case hex");
+        assert(!odd.number(2, value), "Number overflow rejected");
+        assert(!BuildMetadata("g0123456789abcdef0").hex(0, value, "g"), "More than 16 hex digits rejected");
+
+        BuildIndex index;
+        index.add(v);
+        index.add(SemVer("1.4.1+20261015.g9f8e7d6.ci790"));
+        index.add(SemVer("1.4.1-rc.1+20261014.g5555555.ci780"));
+        index.add(SemVer("1.3.0"));
+        assertEqual(index.add(SemVer("1.x")), BuildIndex::NO_POSITION, "Invalid version not indexed");
+        assertEqual(index.size(), 4, "Versions added");
+        assertEqual(index.keys(), 8, "Distinct identifiers");
+        std::vector<uint32_t> hits;
+        assertEqual(index.find("20261014", hits), 2, "Two builds on 2026-10-14");
+        assert(index.at(hits[0]) == SemVer("1.4.0") && index.at(hits[1]) == SemVer("1.4.1-rc.1"), "In insertion order");
+        hits.clear();
+        assert(index.find("g9f8e7d6", hits) == 1 && index.at(hits[0]) == SemVer("1.4.1"), "Lookup by commit");
+        assertEqual(index.find("g1a2b", hits), 0, "Abbreviated identifiers do not match");
+        BuildIndex repeated;
+        repeated.add(SemVer("1.0.0+a.a"));
+        hits.clear();
+        assertEqual(repeated.find("a", hits), 1, "Repeated identifier lists the version once");
+    }
+
+    // --- Compressed Catalog Tests ---
+    std::cout << "\n--- Compressed Catalog Tests ---" << std::endl;
+    {
+        const char* listed[] = { "2.0.0", "1.0.0-rc.1", "1.0.0", "1.0.0-alpha", "1.0.0+b.7", "1.0.0-rc.1",
+                                 "1.10.0", "1.2.3-alpha.beta", "1.2.3", "0.9.1", "2.0.0-rc.1+ci.5", "1.0.0-alpha.1" };
+        CompressedCatalogBuilder builder(4);
+        for (size_t i = 0; i < sizeof(listed) / sizeof(listed[0]); i++) builder.add(listed[i]);
+        assert(!builder.add("1.0"), "Invalid version rejected");
+        assertEqual(builder.count(), 12, "Versions added");
+        std::vector<uint8_t> bytes;
+        builder.build(bytes);
+
+        CompressedCatalog catalog;
+        assert(catalog.open(bytes.data(), bytes.size()), "Catalog opens");
+        assertEqual(catalog.size(), 11, "Exact duplicate dropped");
+        const char* sorted[] = { "0.9.1", "1.0.0-alpha", "1.0.0-alpha.1", "1.0.0-rc.1", "1.0.0", "1.0.0+b.7",
+                                 "1.2.3-alpha.beta", "1.2.3", "1.10.0", "2.0.0-rc.1+ci.5", "2.0.0" };
+        CompressedCatalog::Cursor cursor = catalog.cursor();
+        SemVer v;
+        char text[SemVer::MAX_VERSION_LEN + 1];
+        int wrong = 0;
+        for (size_t i = 0; i < 11; i++) {
+            if (!cursor.next(v)) { wrong++; break; }
+            v.toString(text, sizeof(text));
+            if (strcmp(text, sorted[i]) != 0) wrong++;
+        }
+        assertEqual(wrong, 0, "Cursor yields the total order, build metadata kept");
+        assert(!cursor.next(v), "Cursor stops at the end");
+
+        CompressedCatalog::Entry e;
+        assert(catalog.get(6, e) && e.major == 1 && e.minor == 2 && e.patch == 3 && strcmp(e.prerelease, "alpha.beta") == 0,
+               "get() decodes an entry mid-block");
+        assert(catalog.get(10, v) && v == SemVer("2.0.0"), "get() of the last entry");
+        assert(!catalog.get(11, e), "get() past the end");
+        assertEqual(catalog.find(SemVer("1.0.0-rc.1")), 3, "find() a pre-release");
+        assertEqual(catalog.find(SemVer("1.0.0+other")), 4, "find() ignores build metadata like operator==");
+        assertEqual(catalog.find(SemVer("1.0.0-beta")), CompressedCatalog::NOT_FOUND, "Pre-release not in the dictionary");
+        assertEqual(catalog.lowerBound(SemVer("1.0.0-beta")), 3, "lowerBound() between dictionary entries");
+        assertEqual(catalog.lowerBound(SemVer("0.0.1")), 0, "lowerBound() before everything");
+        assertEqual(catalog.lowerBound(SemVer("3.0.0")), 11, "lowerBound() after everything");
+        assertEqual(catalog.lowerBound(SemVer("1.3.0")), 8, "lowerBound() at a block start");
+        CompressedCatalog::Cursor tail = catalog.cursor(9);
+        assert(tail.next(v) && strcmp(v.getPrerelease(), "rc.1") == 0 && tail.position() == 10, "Cursor from a position");
+
+        CompressedCatalog empty;
+        std::vector<uint8_t> none;
+        CompressedCatalogBuilder().build(none);
+        assert(empty.open(none.data(), none.size()) && empty.size() == 0, "Empty catalog");
+        assertEqual(empty.lowerBound(SemVer("1.0.0")), 0, "Empty lowerBound()");
+        assertEqual(empty.find(SemVer("1.0.0")), CompressedCatalog::NOT_FOUND, "Empty find()");
+
+        CompressedCatalog bad;
+        assert(!bad.open(bytes.data(), bytes.size() - 1), "Truncated catalog rejected");
+        std::vector<uint8_t> magic(bytes);
+        magic[0] = 'X';
+        assert(!bad.open(magic.data(), magic.size()), "Bad magic rejected");
+        assertEqual(bad.size(), 0, "Failed open leaves an empty catalog");
+        assertEqual(bad.lowerBound(SemVer("1.0.0")), 0, "Unopened lowerBound()");
+
+        // Corrupt bytes must fail cleanly, never read outside the data
+        uint32_t seed = 99;
+        for (int round = 0; round < 500; round++) {
+            std::vector<uint8_t> flipped(bytes);
+            seed = seed * 1103515245u + 12345u;
+            flipped[(seed >> 8) % flipped.size()] ^= (uint8_t)(1u << ((seed >> 20) % 8));
+            CompressedCatalog c;
+            if (!c.open(flipped.data(), flipped.size())) continue;
+            CompressedCatalog::Cursor all = c.cursor();
+            while (all.next(e)) {
+            }
+            c.lowerBound(SemVer("1.0.0-rc.1"));
+        }
+        assert(true, "Corrupt catalogs decode without faults");
+
+        // Random catalog against a sorted vector
+        const char* pre[] = { "", "", "", "alpha", "beta.2", "rc.1", "rc.10" };
+        CompressedCatalogBuilder big(16);
+        std::vector<SemVer> all;
+        size_t textBytes = 0;
+        seed = 2024;
+        for (int i = 0; i < 3000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char version[48];
+            snprintf(version, sizeof(version), "%u.%u.%u%s%s", (seed >> 8) % 5, (seed >> 12) % 20, (seed >> 18) % 40,
+                     pre[(seed >> 24) % 7][0] ? "-" : "", pre[(seed >> 24) % 7]);
+            big.add(version);
+            all.push_back(SemVer(version));
+            textBytes += strlen(version) + 1;
+        }
+        std::sort(all.begin(), all.end(), [](const SemVer& a, const SemVer& b) { return a.compareTotal(b) < 0; });
+        all.erase(std::unique(all.begin(), all.end(), [](const SemVer& a, const SemVer& b) { return a.compareTotal(b) == 0; }),
+                  all.end());
+        std::vector<uint8_t> packed;
+        big.build(packed);
+        CompressedCatalog large;
+        assert(large.open(packed.data(), packed.size()) && large.size() == all.size(), "Random catalog opens");
+        assert(packed.size() * 3 < textBytes, "Several times smaller than the text form");
+
+        int mismatches = 0;
+        CompressedCatalog::Cursor walk = large.cursor();
+        for (size_t i = 0; i < all.size(); i++) {
+            if (!walk.next(v) || v.compareTotal(all[i]) != 0) mismatches++;
+        }
+        for (int i = 0; i < 2000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char version[48];
+            const char* probePre[] = { "", "alpha", "beta", "beta.2", "rc.1", "rc.2", "rc.10", "zeta" };
+            const char* p = probePre[(seed >> 24) % 8];
+            snprintf(version, sizeof(version), "%u.%u.%u%s%s", (seed >> 8) % 6, (seed >> 12) % 21, (seed >> 18) % 41,
+                     p[0] ? "-" : "", p);
+            SemVer probe(version);
+            uint32_t expected = (uint32_t)(std::lower_bound(all.begin(), all.end(), probe) - all.begin());
+            if (large.lowerBound(probe) != expected) mismatches++;
+            uint32_t found = expected < all.size() && all[expected] == probe ? expected : CompressedCatalog::NOT_FOUND;
+            if (large.find(probe) != found) mismatches++;
+        }
+        assertEqual(mismatches, 0, "Iteration, lowerBound() and find() match a sorted vector");
+    }
+
+    // --- Version Index Tests ---
+    std::cout << "\n--- Version Index Tests ---" << std::endl;
+    {
+        const char* listed[] = { "2.0.0", "1.0.0-rc.1", "1.0.0", "1.0.0-beta.2", "1.0.0+b.7", "1.0.0-rc.1",
+                                 "1.1.0-beta.1", "1.0.0-alpha.verylongidentifier.1", "0.9.1", "2.1.0-rc.1+ci.5" };
+        VersionIndexBuilder builder(16); // Short enough that some keys continue in the string area
+        for (size_t i = 0; i < sizeof(listed) / sizeof(listed[0]); i++) builder.add(listed[i]);
+        assert(!builder.add("2.0"), "Invalid version rejected");
+        std::vector<uint8_t> bytes;
+        builder.build(bytes);
+
+        VersionIndex index;
+        assert(index.open(bytes.data(), bytes.size()), "Index opens");
+        assertEqual(index.size(), 9, "Exact duplicate dropped");
+        const char* sorted[] = { "0.9.1", "1.0.0-alpha.verylongidentifier.1", "1.0.0-beta.2", "1.0.0-rc.1", "1.0.0",
+                                 "1.0.0+b.7", "1.1.0-beta.1", "2.0.0", "2.1.0-rc.1+ci.5" };
+        int wrong = 0;
+        for (uint32_t i = 0; i < 9; i++) {
+            if (!index.text(i) || strcmp(index.text(i), sorted[i]) != 0) wrong++;
+        }
+        assertEqual(wrong, 0, "Versions in total order, text read in place");
+        assert(index.text(9) == NULL, "text() past the end");
+        SemVer v;
+        assert(index.get(6, v) && v == SemVer("1.1.0-beta.1"), "get() parses a position");
+        assertEqual(index.find(SemVer("1.0.0+b.7")), 5, "find() includes build metadata");
+        assertEqual(index.find(SemVer("1.0.0")), 4, "find() without build metadata");
+        assertEqual(index.find(SemVer("1.0.0+b")), VersionIndex::NOT_FOUND, "A build prefix is not a match");
+        assertEqual(index.find(SemVer("1.0.0-alpha.verylongidentifier.1")), 1, "find() a key longer than the width");
+        assertEqual(index.find(SemVer("1.0.0-alpha.verylongidentifier.2")), VersionIndex::NOT_FOUND,
+                    "Long keys that tie on the packed prefix");
+        assertEqual(index.lowerBound(SemVer("1.0.0+zzz")), 4, "lowerBound() ignores build metadata");
+        assertEqual(index.upperBound(SemVer("1.0.0")), 6, "upperBound() skips every build of a version");
+        assertEqual(index.lowerBound(SemVer("3.0.0")), 9, "lowerBound() past the end");
+
+        assertEqual(index.channels(), 4, "Stable, alpha, beta, rc");
+        assert(strcmp(index.channelName(0), "") == 0 && strcmp(index.channelName(3), "rc") == 0, "Channels by name");
+        assertEqual(index.findChannel("beta"), 2, "findChannel()");
+        assertEqual(index.findChannel("dev"), -1, "Unknown channel");
+        assertEqual(index.channelSize(2), 2, "Two beta versions");
+        assertEqual(index.channelPosition(2, 1), 6, "Channel positions ascend");
+        assertEqual(index.latest(""), 7, "Latest stable");
+        assertEqual(index.latest("", 1), 5, "Latest stable 1.x");
+        assertEqual(index.latest("", 3), VersionIndex::NOT_FOUND, "No 3.x");
+        assertEqual(index.latest("rc"), 8, "Latest rc");
+        assertEqual(index.latest("rc", 1), 3, "Latest rc in 1.x");
+        assertEqual(index.latest("dev"), VersionIndex::NOT_FOUND, "Latest of an unknown channel");
+        assertEqual(index.latest("", 0xFFFFFFFFu), VersionIndex::NOT_FOUND, "No release with major 4294967295");
+
+        std::vector<uint8_t> tampered(bytes);
+        tampered[bytes.size() - 3] ^= 1;
+        assert(!index.open(tampered.data(), tampered.size()), "Checksum mismatch rejected");
+        assertEqual(index.size(), 0, "Failed open leaves an empty index");
+        assert(!index.open(bytes.data(), bytes.size() - 1), "Truncated index rejected");
+        std::vector<uint8_t> format(bytes);
+        format[4] = 2;
+        assert(!index.open(format.data(), format.size(), false), "Unknown format version rejected");
+
+        // Corrupt files that skip the checksum must still be rejected or read within bounds
+        uint32_t seed = 50;
+        for (int round = 0; round < 500; round++) {
+            std::vector<uint8_t> flipped(bytes);
+            seed = seed * 1103515245u + 12345u;
+            flipped[(seed >> 8) % flipped.size()] ^= (uint8_t)(1u << ((seed >> 20) % 8));
+            VersionIndex c;
+            if (!c.open(flipped.data(), flipped.size(), false)) continue;
+            c.find(SemVer("1.0.0-rc.1"));
+            c.latest("rc", 1);
+            for (uint32_t i = 0; i < c.size(); i++) c.text(i);
+        }
+        assert(true, "Corrupt indexes read without faults");
+
+        std::string path = "/tmp/semver-index-test-" + std::to_string(getpid()) + ".svix";
+        assert(builder.write(path.c_str()), "Index written");
+        VersionIndex mapped;
+        assert(mapped.map(path.c_str()) && mapped.size() == 9, "Index mapped");
+        VersionIndexBuilder next;
+        next.add("3.0.0");
+        assert(next.write(path.c_str()), "Index replaced while mapped");
+        assert(strcmp(mapped.text(7), "2.0.0") == 0, "Existing mapping keeps the old index");
+        VersionIndex fresh;
+        assert(fresh.map(path.c_str()) && fresh.size() == 1 && strcmp(fresh.text(0), "3.0.0") == 0, "New mapping sees the new index");
+        unlink(path.c_str());
+        assert(!fresh.map(path.c_str()) && fresh.size() == 0, "Missing file");
+
+        // The temporary file lives next to the target and never outlives write()
+        char dirTemplate[] = "/tmp/semver-index-dir-XXXXXX";
+        std::string dir = mkdtemp(dirTemplate);
+        std::string inDir = dir + "/versions.svix";
+        assert(builder.write(inDir.c_str()) && next.write(inDir.c_str()), "Index written twice in a directory");
+        assert(!next.write((dir + "/missing/versions.svix").c_str()), "Missing directory fails");
+        int entries = 0;
+        DIR* listing = opendir(dir.c_str());
+        while (dirent* e = readdir(listing)) entries += e->d_name[0] != '.';
+        closedir(listing);
+        assertEqual(entries, 1, "Only the index is left in the directory");
+        struct stat info;
+        assert(stat(inDir.c_str(), &info) == 0 && (info.st_mode & 0777) == 0644, "Index is readable by other processes");
+        unlink(inDir.c_str());
+        rmdir(dir.c_str());
+
+        // Random index against a sorted vector
+        const char* pre[] = { "", "", "", "alpha", "beta.2", "rc.1", "rc.10" };
+        const char* build[] = { "", "", "", "+b.1", "+b.2" };
+        VersionIndexBuilder big(16);
+        std::vector<SemVer> all;
+        seed = 2025;
+        for (int i = 0; i < 3000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char version[48];
+            const char* p = pre[(seed >> 24) % 7];
+            snprintf(version, sizeof(version), "%u.%u.%u%s%s%s", (seed >> 8) % 5, (seed >> 12) % 20, (seed >> 18) % 40,
+                     p[0] ? "-" : "", p, build[(seed >> 28) % 5]);
+            big.add(version);
+            all.push_back(SemVer(version));
+        }
+        std::sort(all.begin(), all.end(), [](const SemVer& a, const SemVer& b) { return a.compareTotal(b) < 0; });
+        all.erase(std::unique(all.begin(), all.end(), [](const SemVer& a, const SemVer& b) { return a.compareTotal(b) == 0; }),
+                  all.end());
+        std::vector<uint8_t> packed;
+        big.build(packed);
+        VersionIndex large;
+        assert(large.open(packed.data(), packed.size()) && large.size() == all.size(), "Random index opens");
+        int mismatches = 0;
+        for (uint32_t i = 0; i < large.size(); i++) {
+            if (!large.get(i, v) || v.compareTotal(all[i]) != 0) mismatches++;
+        }
+        for (int i = 0; i < 2000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            char version[48];
+            const char* probePre[] = { "", "alpha", "beta", "beta.2", "rc.1", "rc.2", "rc.10", "zeta" };
+            const char* p = probePre[(seed >> 24) % 8];
+            snprintf(version, sizeof(version), "%u.%u.%u%s%s%s", (seed >> 8) % 6, (seed >> 12) % 21, (seed >> 18) % 41,
+                     p[0] ? "-" : "", p, build[(seed >> 28) % 5]);
+            SemVer probe(version);
+            if (large.lowerBound(probe) != (uint32_t)(std::lower_bound(all.begin(), all.end(), probe) - all.begin())) mismatches++;
+            if (large.upperBound(probe) != (uint32_t)(std::upper_bound(all.begin(), all.end(), probe) - all.begin())) mismatches++;
+            uint32_t expected = VersionIndex::NOT_FOUND;
+            for (size_t k = 0; k < all.size() && expected == VersionIndex::NOT_FOUND; k++) {
+                if (all[k].compareTotal(probe) == 0) expected = (uint32_t)k;
+            }
+            if (large.find(probe) != expected) mismatches++;
+        }
+        for (uint32_t major = 0; major < 6; major++) {
+            const char* channel[] = { "", "alpha", "beta", "rc" };
+            for (int c = 0; c < 4; c++) {
+                uint32_t expected = VersionIndex::NOT_FOUND;
+                for (size_t k = 0; k < all.size(); k++) {
+                    const char* pr = all[k].getPrerelease();
+                    if (all[k].major == major && strncmp(pr, channel[c], strlen(channel[c])) == 0 &&
+                        (pr[strlen(channel[c])] == '\0' || pr[strlen(channel[c])] == '.')) {
+                        expected = (uint32_t)k;
+                    }
+                }
+                if (large.latest(channel[c], major) != expected) mismatches++;
+            }
+        }
+        assertEqual(mismatches, 0, "Positions, bounds, find() and latest() match a sorted vector");
+    }
+
     // --- Summary ---
     std::cout << "\n==================================" << std::endl;
     std::cout << "Tests Passed: " << testsPassed << std::endl;
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+// Same setup as run_tests.cpp, but the library is built in SEMVER_TINY mode.
+// Only behaviour that differs from the full build (or must survive the compact
+// storage) is checked here; everything else is covered by run_tests.cpp.
+#ifndef SEMVER_TINY
+#define SEMVER_TINY
+#endif
+
+#include "Arduino.h"
+#include "../src/SemVerChecker.cpp"
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+void assert(bool condition, const char* testName) {
+    if (condition) {
+        std::cout << "[PASS] " << testName << std::endl;
+        testsPassed++;
+    } else {
+        std::cout << "[FAIL] " << testName << std::endl;
+        testsFailed++;
+    }
+}
+
+void assertString(String actual, const char* expected, const char* testName) {
+    if (actual == expected) {
+        std::cout << "[PASS] " << testName << std::endl;
+        testsPassed++;
+    } else {
+        std::cout << "[FAIL] " << testName << " (Expected: \"" << expected << "\", Got: \"" << actual << "\")" << std::endl;
+        testsFailed++;
+    }
+}
+
+int main() {
+    std::cout << "\nStarting SemVerChecker SEMVER_TINY Tests (Local Native, tag "
+              << SEMVER_TINY_TAG_LEN << " bytes, sizeof(SemVer) " << sizeof(SemVer) << ")...\n" << std::endl;
+
+    // --- Parsing Tests ---
+    std::cout << "--- Parsing Tests ---" << std::endl;
+    {
+        SemVer v("10.20.30-rc.1+build.123");
+        assert(v.isValid(), "Tiny parse valid");
+        assert(v.major == 10 && v.minor == 20 && v.patch == 30, "Tiny parse core");
+        assertString(v.getPrerelease(), "rc.1", "Tiny prerelease decoded from tag");
+        assertString(v.getBuild(), "", "Tiny build metadata discarded");
+        assertString(v.toString(), "10.20.30-rc.1", "Tiny toString omits build");
+    }
+    {
+        assert(!SemVer("1.0.0+build..1").isValid(), "Tiny still validates build metadata");
+        assert(!SemVer("1.0.0-01").isValid(), "Tiny still validates prerelease");
+        assert(SemVer("4294967295.0.0").isValid(), "Tiny keeps uint32 core");
+    }
+    {
+        SemVer v("1.0.0-12345.0");
+        assertString(v.getPrerelease(), "12345.0", "Tiny decodes odd-length numerics");
+        SemVer w("1.0.0-a.b");
+        assertString(w.getPrerelease(), "a.b", "Tiny decodes alphanumeric separators");
+    }
+
+    // --- Precedence Tests ---
+    std::cout << "\n--- Precedence Tests ---" << std::endl;
+    {
+        // Strictly ascending by SemVer 2.0.0 precedence; all fit in the default tag
+        const char* ordered[] = {
+            "0.9.9", "1.0.0-0", "1.0.0-1", "1.0.0-2", "1.0.0-11", "1.0.0-a", "1.0.0-a.1",
+            "1.0.0-a.b", "1.0.0-a-", "1.0.0-ab", "1.0.0-alpha", "1.0.0-b.2", "1.0.0-b.11",
+            "1.0.0-beta", "1.0.0-rc.1", "1.0.0-rc.1.1", "1.0.0-rc.2", "1.0.0-rc.10", "1.0.0",
+            "1.0.1-rc.1", "1.0.1", "1.2.0", "2.0.0-0a", "2.0.0"
+        };
+        const int count = sizeof(ordered) / sizeof(ordered[0]);
+        bool ok = true;
+        for (int i = 0; i < count; i++) {
+            for (int j = 0; j < count; j++) {
+                SemVer a(ordered[i]);
+                SemVer b(ordered[j]);
+                if ((a < b) != (i < j) || (a == b) != (i == j)) {
+                    std::cout << "  mismatch: " << ordered[i] << " vs " << ordered[j] << std::endl;
+                    ok = false;
+                }
+            }
+        }
+        assert(ok, "Tiny operator< and operator== match precedence for all pairs");
+    }
+    {
+        SemVer a("1.0.0-rc.1+build.1");
+        SemVer b("1.0.0-rc.1+build.2");
+        assert(a == b, "Tiny equality ignores build");
+        assert(a.diff(b) == SemVer::NONE, "Tiny diff NONE for build-only change");
+        assert(SemVer("1.0.0-rc.1").diff(SemVer("1.0.0-rc.2")) == SemVer::PRERELEASE, "Tiny diff PRERELEASE");
+        assert(SemVer("1.0.0").diff(SemVer("1.1.0")) == SemVer::MINOR, "Tiny diff MINOR");
+    }
+    {
+        // Longer than the tag: ordering is exact up to the stored prefix
+        SemVer a("1.0.0-alphabet.1");
+        SemVer b("1.0.0-alphabet.2");
+        SemVer c("1.0.0-alpha");
+        assert(c < a, "Tiny truncated tag sorts after its exact prefix");
+        assert(!(a < b) && !(b < a), "Tiny truncated tags sharing the prefix compare equal");
+    }
+
+    // --- Total Order Tests ---
+    std::cout << "\n--- Total Order Tests ---" << std::endl;
+    {
+        // Build metadata is discarded, so the total order is precedence; keys must
+        // still order 0x00/0x01 tag bytes and truncated tags like compareTag()
+        const char* ordered[] = {
+            "1.0.0-0", "1.0.0-0.0", "1.0.0-1", "1.0.0-11", "1.0.0-a", "1.0.0-alpha", "1.0.0-alphabet.1", "1.0.0-b",
+            "1.0.0", "1.0.1"
+        };
+        const int count = sizeof(ordered) / sizeof(ordered[0]);
+        bool ok = true;
+        for (int i = 0; i < count; i++) {
+            for (int j = 0; j < count; j++) {
+                SemVer a(ordered[i]);
+                SemVer b(ordered[j]);
+                uint8_t ka[SemVer::MAX_SORT_KEY_LEN], kb[SemVer::MAX_SORT_KEY_LEN];
+                size_t la = a.sortKey(ka, sizeof(ka)), lb = b.sortKey(kb, sizeof(kb));
+                int c = memcmp(ka, kb, la < lb ? la : lb);
+                int byKey = c != 0 ? (c < 0 ? -1 : 1) : (la == lb ? 0 : (la < lb ? -1 : 1));
+                int expected = i < j ? -1 : (i > j ? 1 : 0);
+                if (a.compareTotal(b) != expected || byKey != expected || (a.hashTotal() == b.hashTotal()) != (i == j)) {
+                    std::cout << "  mismatch: " << ordered[i] << " vs " << ordered[j] << std::endl;
+                    ok = false;
+                }
+            }
+        }
+        assert(ok, "Tiny compareTotal(), sortKey() and hashTotal() agree for all pairs");
+        assert(SemVer("1.0.0+a").compareTotal(SemVer("1.0.0+b")) == 0, "Tiny total order has no build metadata");
+    }
+
+    // --- satisfies() Tests ---
+    std::cout << "\n--- satisfies() Tests ---" << std::endl;
+    {
+        assert(SemVer("1.5.0").satisfies(SemVer("1.2.0")), "Tiny ^1.2.0 accepts 1.5.0");
+        assert(!SemVer("2.0.0").satisfies(SemVer("1.2.0")), "Tiny ^1.2.0 rejects 2.0.0");
+        assert(!SemVer("0.3.0").satisfies(SemVer("0.2.0")), "Tiny 0.x minor is breaking");
+        assert(!SemVer("1.3.0-beta").satisfies(SemVer("1.2.0")), "Tiny stable requirement rejects prerelease");
+        assert(SemVer("1.3.0-beta").satisfies(SemVer("1.2.0"), true), "Tiny opt-in accepts prerelease");
+        assert(SemVer("1.2.3-beta.2").satisfies(SemVer("1.2.3-beta.1")), "Tiny same-tuple prerelease accepted");
+        assert(!SemVer("1.2.3-alpha").satisfies(SemVer("1.2.3-beta")), "Tiny older prerelease rejected");
+    }
+    {
+        SemVer v("1.2.3-rc.1");
+        v.incPatch();
+        assertString(v.toString(), "1.2.4", "Tiny incPatch clears prerelease");
+    }
+
+    // --- Summary ---
+    std::cout << "\n==================================" << std::endl;
+    std::cout << "Tests Passed: " << testsPassed << std::endl;
+    std::cout << "Tests Failed: " << testsFailed << std::endl;
+    std::cout << "==================================" << std::endl;
+
+    return (testsFailed == 0) ? 0 : 1;
+}
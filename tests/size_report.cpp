@@ -0,0 +1,19 @@
+#include <cstdio>
+
+// Prints sizeof(SemVer) for the configuration selected by the build flags.
+// Built once per configuration by 'make size-report'.
+#include "../src/SemVerChecker.h"
+
+#ifndef SIZE_REPORT_NAME
+#define SIZE_REPORT_NAME "default"
+#endif
+
+int main() {
+#ifdef ARDUINO
+    const char* base = "with Printable";
+#else
+    const char* base = "plain";
+#endif
+    printf("  %-40s %-15s %3u bytes\n", SIZE_REPORT_NAME, base, (unsigned)sizeof(SemVer));
+    return 0;
+}